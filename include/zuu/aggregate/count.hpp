@@ -0,0 +1,373 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/count.hpp
+ * @brief Parallel group-by counting keyed by basic_fstring
+ * @version 3.0.0
+ *
+ * Usage:
+ *   // One key per record
+ *   auto by_host = zuu::aggregate::count_by(lines, [](const auto& l) { return host_of(l); });
+ *
+ *   // A range of keys per record (split_result, vector of views, ...)
+ *   auto words = zuu::aggregate::count_by(lines, zuu::str::split_whitespace);
+ *
+ *   // Emitter form: no intermediate containers
+ *   auto words = zuu::aggregate::count_by(views, [](std::string_view l, auto& emit) {
+ *       ... emit(token); ...
+ *   });
+ *
+ *   for (auto& [word, n] : words.top(10)) std::cout << word << ' ' << n << '\n';
+ *
+ * Each worker counts into its own flat open-addressing table. Tables
+ * are then scattered by hash into one partition per worker and the
+ * partitions are merged in parallel, so no lock or atomic is touched
+ * per key. Keys are stored as basic_fstring<CharT, KeyCap>; longer
+ * keys are truncated like every other fstring operation.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include "../core/parallel.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+namespace zuu::aggregate {
+
+// ==================== Options & Entries ====================
+
+struct count_options {
+    std::size_t threads = 0;        // 0 = all hardware threads
+    std::size_t min_chunk = 1024;   // records per task, lower bound
+    std::size_t expected_keys = 0;  // initial table sizing hint
+};
+
+template <typename Key>
+struct entry {
+    Key key;
+    std::size_t count = 0;
+};
+
+// ==================== Flat Count Table ====================
+
+/**
+ * @brief Open-addressing (linear probing) map from key to count
+ *
+ * Slots keep the full hash so probes compare 8 bytes before touching
+ * the key, and growth never rehashes a string.
+ */
+template <meta::character CharT, std::size_t KeyCap>
+class count_table {
+public:
+    using key_type = basic_fstring<CharT, KeyCap>;
+    using view_type = std::basic_string_view<CharT>;
+
+    struct slot {
+        key_type key;
+        std::uint64_t hash = 0;
+        std::size_t count = 0;  // 0 marks an empty slot
+    };
+
+private:
+    std::vector<slot> slots_;
+    std::size_t size_ = 0;
+
+public:
+    explicit count_table(std::size_t expected = 0) {
+        std::size_t cap = 64;
+        while (cap < expected * 2) cap <<= 1;
+        slots_.resize(cap);
+    }
+
+    [[nodiscard]] static view_type clamp(view_type key) noexcept {
+        return key.substr(0, std::min(key.size(), KeyCap));
+    }
+
+    // `key` must already be clamped and `h` must be its hash
+    void add_hashed(view_type key, std::uint64_t h, std::size_t n = 1) {
+        if ((size_ + 1) * 2 > slots_.size()) grow();
+
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+            slot& s = slots_[i];
+            if (s.count == 0) {
+                s.key = key_type{key};
+                s.hash = h;
+                s.count = n;
+                ++size_;
+                return;
+            }
+            if (s.hash == h && view_type{s.key} == key) {
+                s.count += n;
+                return;
+            }
+        }
+    }
+
+    void add(view_type key, std::size_t n = 1) {
+        key = clamp(key);
+        add_hashed(key, zuu::hash(key), n);
+    }
+
+    [[nodiscard]] std::size_t count(view_type key) const noexcept {
+        key = clamp(key);
+        const std::uint64_t h = zuu::hash(key);
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+            const slot& s = slots_[i];
+            if (s.count == 0) return 0;
+            if (s.hash == h && view_type{s.key} == key) return s.count;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+    // fn(const slot&) for every occupied slot
+    template <typename Fn>
+    void for_each_slot(Fn&& fn) const {
+        for (const slot& s : slots_) {
+            if (s.count != 0) fn(s);
+        }
+    }
+
+private:
+    void grow() {
+        std::vector<slot> old(slots_.size() * 2);
+        old.swap(slots_);
+        const std::size_t mask = slots_.size() - 1;
+        for (slot& s : old) {
+            if (s.count == 0) continue;
+            std::size_t i = s.hash & mask;
+            while (slots_[i].count != 0) i = (i + 1) & mask;
+            slots_[i] = s;
+        }
+    }
+};
+
+namespace detail {
+
+// Partition by the high hash bits; table slots use the low bits
+[[nodiscard]] constexpr std::size_t partition_of(std::uint64_t h, std::size_t parts) noexcept {
+    return static_cast<std::size_t>(((h >> 32) * parts) >> 32);
+}
+
+template <typename Slot>
+[[nodiscard]] bool ranks_before(const Slot* a, const Slot* b) noexcept {
+    if (a->count != b->count) return a->count > b->count;
+    return a->key < b->key;
+}
+
+} // namespace detail
+
+// ==================== Count Result ====================
+
+template <meta::character CharT, std::size_t KeyCap>
+class count_result {
+public:
+    using table_type = count_table<CharT, KeyCap>;
+    using key_type = typename table_type::key_type;
+    using view_type = typename table_type::view_type;
+    using entry_type = entry<key_type>;
+
+private:
+    std::vector<table_type> parts_;
+
+public:
+    explicit count_result(std::vector<table_type> parts) : parts_{std::move(parts)} {}
+
+    [[nodiscard]] std::size_t size() const noexcept {
+        std::size_t n = 0;
+        for (const auto& p : parts_) n += p.size();
+        return n;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    [[nodiscard]] std::size_t count(view_type key) const noexcept {
+        key = table_type::clamp(key);
+        return parts_[detail::partition_of(zuu::hash(key), parts_.size())].count(key);
+    }
+
+    // Sum of all counts
+    [[nodiscard]] std::size_t total() const noexcept {
+        std::size_t n = 0;
+        for_each([&](const key_type&, std::size_t c) { n += c; });
+        return n;
+    }
+
+    // fn(const key_type&, std::size_t count), unordered
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (const auto& p : parts_) {
+            p.for_each_slot([&](const auto& s) { fn(s.key, s.count); });
+        }
+    }
+
+    /**
+     * @brief The k most frequent keys, by count descending then key
+     *
+     * Each partition selects its own top k in parallel; only the
+     * k * partitions survivors are merged.
+     */
+    [[nodiscard]] std::vector<entry_type> top(std::size_t k, std::size_t threads = 0) const {
+        using slot_ptr = const typename table_type::slot*;
+        std::vector<std::vector<slot_ptr>> best(parts_.size());
+
+        par::for_each_task(parts_.size(), threads, [&](std::size_t p, std::size_t) {
+            auto& v = best[p];
+            v.reserve(parts_[p].size());
+            parts_[p].for_each_slot([&](const auto& s) { v.push_back(&s); });
+            if (v.size() > k) {
+                std::nth_element(v.begin(), v.begin() + k, v.end(), detail::ranks_before<typename table_type::slot>);
+                v.resize(k);
+            }
+        });
+
+        std::vector<slot_ptr> all;
+        for (const auto& v : best) all.insert(all.end(), v.begin(), v.end());
+        const std::size_t n = std::min(k, all.size());
+        std::partial_sort(all.begin(), all.begin() + n, all.end(), detail::ranks_before<typename table_type::slot>);
+
+        std::vector<entry_type> out;
+        out.reserve(n);
+        for (std::size_t i = 0; i < n; ++i) out.push_back({all[i]->key, all[i]->count});
+        return out;
+    }
+};
+
+// ==================== Key Extraction ====================
+
+namespace detail {
+
+template <meta::character CharT, typename S>
+[[nodiscard]] constexpr std::basic_string_view<CharT> as_view(const S& s) noexcept {
+    if constexpr (requires { s.data(); s.size(); }) {
+        return {s.data(), s.size()};
+    } else {
+        return std::basic_string_view<CharT>{s};
+    }
+}
+
+template <meta::character CharT, std::size_t KeyCap>
+struct emitter {
+    count_table<CharT, KeyCap>* table;
+
+    template <typename S>
+    void operator()(const S& key) const {
+        table->add(as_view<CharT>(key));
+    }
+};
+
+template <typename Rec>
+using record_char_t = std::conditional_t<
+    meta::character<meta::char_type_of_t<Rec>>, meta::char_type_of_t<Rec>, char>;
+
+template <typename Rec, typename KeyFn, std::size_t KeyCap>
+constexpr bool emits_v = std::invocable<KeyFn&, const Rec&, emitter<record_char_t<Rec>, KeyCap>&>;
+
+// Resolves (CharT, capacity) of the keys a key function produces
+template <typename Rec, typename KeyFn, std::size_t KeyCap>
+struct key_traits {
+    using char_type = record_char_t<Rec>;
+    static constexpr std::size_t capacity = KeyCap;
+};
+
+template <typename Rec, typename KeyFn, std::size_t KeyCap>
+requires (!emits_v<Rec, KeyFn, KeyCap>)
+struct key_traits<Rec, KeyFn, KeyCap> {
+    using result_type = std::remove_cvref_t<std::invoke_result_t<KeyFn&, const Rec&>>;
+    using key_like = std::conditional_t<
+        meta::string_like<result_type>,
+        result_type,
+        std::remove_cvref_t<std::ranges::range_value_t<result_type>>>;
+
+    using char_type = meta::char_type_of_t<key_like>;
+    static constexpr std::size_t capacity =
+        meta::capacity_of_v<key_like> == std::dynamic_extent ? KeyCap : meta::capacity_of_v<key_like>;
+};
+
+} // namespace detail
+
+// ==================== count_by ====================
+
+/**
+ * @brief Counts keys extracted from every record, in parallel
+ *
+ * @tparam KeyCap  Capacity of stored keys when the key function yields
+ *                 views rather than basic_fstring
+ * @param records  Random-access sized range of records
+ * @param key_fn   key_fn(record) -> key or range of keys, or
+ *                 key_fn(record, emit) calling emit(key) per key
+ */
+template <std::size_t KeyCap = 64, std::ranges::random_access_range R, typename KeyFn>
+requires std::ranges::sized_range<R>
+[[nodiscard]] auto count_by(const R& records, KeyFn&& key_fn, count_options opt = {}) {
+    using record_type = std::ranges::range_value_t<R>;
+    using traits = detail::key_traits<record_type, std::remove_cvref_t<KeyFn>, KeyCap>;
+    using char_type = typename traits::char_type;
+    constexpr std::size_t cap = traits::capacity;
+    using table_type = count_table<char_type, cap>;
+
+    const std::size_t n = std::ranges::size(records);
+    const std::size_t threads = par::thread_count(opt.threads);
+    const std::size_t chunk = std::max(opt.min_chunk, n / (threads * 8) + 1);
+    const std::size_t tasks = (n + chunk - 1) / chunk;
+    const std::size_t workers = par::workers_for(tasks, threads);
+
+    // Phase 1: per-worker counting
+    std::vector<table_type> locals;
+    locals.reserve(workers);
+    for (std::size_t w = 0; w < workers; ++w) locals.emplace_back(opt.expected_keys / workers);
+
+    auto first = std::ranges::begin(records);
+    par::for_each_task(tasks, workers, [&](std::size_t t, std::size_t w) {
+        table_type& table = locals[w];
+        const std::size_t end = std::min(n, (t + 1) * chunk);
+        for (std::size_t i = t * chunk; i < end; ++i) {
+            const auto& rec = first[static_cast<std::ptrdiff_t>(i)];
+            if constexpr (detail::emits_v<record_type, std::remove_cvref_t<KeyFn>, KeyCap>) {
+                detail::emitter<char_type, cap> emit{&table};
+                key_fn(rec, emit);
+            } else {
+                using result_type = typename traits::result_type;
+                if constexpr (meta::string_like<result_type>) {
+                    table.add(detail::as_view<char_type>(key_fn(rec)));
+                } else {
+                    for (const auto& key : key_fn(rec)) table.add(detail::as_view<char_type>(key));
+                }
+            }
+        }
+    });
+
+    if (workers == 1) return count_result<char_type, cap>{std::move(locals)};
+
+    // Phase 2: scatter every local table into hash partitions
+    using slot_ptr = const typename table_type::slot*;
+    std::vector<std::vector<std::vector<slot_ptr>>> buckets(workers, std::vector<std::vector<slot_ptr>>(workers));
+    par::for_each_task(workers, workers, [&](std::size_t w, std::size_t) {
+        locals[w].for_each_slot([&](const auto& s) {
+            buckets[w][detail::partition_of(s.hash, workers)].push_back(&s);
+        });
+    });
+
+    // Phase 3: merge each partition independently
+    std::vector<table_type> parts;
+    parts.reserve(workers);
+    for (std::size_t p = 0; p < workers; ++p) parts.emplace_back(opt.expected_keys / workers);
+
+    par::for_each_task(workers, workers, [&](std::size_t p, std::size_t) {
+        for (std::size_t w = 0; w < workers; ++w) {
+            for (slot_ptr s : buckets[w][p]) {
+                parts[p].add_hashed(std::basic_string_view<char_type>{s->key}, s->hash, s->count);
+            }
+        }
+    });
+
+    return count_result<char_type, cap>{std::move(parts)};
+}
+
+} // namespace zuu::aggregate
@@ -0,0 +1,159 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/features.hpp
+ * @brief Fused whitespace tokenization, case folding and token hashing
+ * @version 3.0.0
+ *
+ * Usage:
+ *   std::array<std::uint32_t, 512> ids;
+ *   std::size_t n = zuu::aggregate::hash_tokens(doc, std::span{ids});
+ *   for (auto h : std::span{ids}.first(n)) ++weights[h & (buckets - 1)];
+ *
+ *   // Unigrams plus bigrams, case-sensitive, custom seed
+ *   n = zuu::aggregate::hash_tokens(doc, std::span{ids}, {.ngrams = 2, .fold_case = false, .seed = 42});
+ *
+ * Replaces `split_whitespace`, `to_lower` and `hash` per token with one
+ * pass: whitespace is classified 64 characters at a time into a bitmap
+ * whose transitions give the token bounds, and each token is hashed in
+ * place while ASCII letters are folded inside the hash's own loads. A
+ * unigram hash equals zuu::hash of the lowercased token (with the same
+ * seed), so feature ids can be precomputed from a vocabulary.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace zuu::aggregate {
+
+struct token_hash_options {
+    std::size_t ngrams = 1;     // also emit hashes of 2..ngrams consecutive tokens (max 8)
+    bool fold_case = true;      // hash ASCII letters as lowercase
+    std::uint64_t seed = 0;
+};
+
+namespace detail {
+
+inline constexpr std::size_t max_ngrams = 8;
+
+/**
+ * @brief Calls fn(begin, end) for every whitespace-separated token
+ * Starts and ends are the 0->1 and 1->0 edges of the non-space bitmap;
+ * within a block they alternate, so they are consumed in pairs without
+ * a per-character (or per-edge) branch. Stops early when fn returns false.
+ */
+template <meta::character CharT, typename Fn>
+constexpr void for_each_token(const CharT* p, std::size_t n, Fn&& fn) {
+    std::size_t start = 0;
+    bool open = false;              // a token started in an earlier block
+    std::uint64_t prev_space = 1;   // text start behaves like a space
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::uint64_t space = simd::space_mask(p + base, n - base);
+        const std::uint64_t shifted = (space << 1) | prev_space;
+        prev_space = space >> 63;
+        std::uint64_t starts = ~space & shifted;
+        std::uint64_t ends = space & ~shifted;
+
+        if (open) {
+            if (ends == 0) continue;
+            if (!fn(start, base + static_cast<std::size_t>(std::countr_zero(ends)))) return;
+            ends &= ends - 1;
+            open = false;
+        }
+        while (starts) {
+            start = base + static_cast<std::size_t>(std::countr_zero(starts));
+            starts &= starts - 1;
+            if (ends == 0) { open = true; break; }
+            if (!fn(start, base + static_cast<std::size_t>(std::countr_zero(ends)))) return;
+            ends &= ends - 1;
+        }
+    }
+    // Only a token running to a 64-aligned end has no space mask bit after it
+    if (open) fn(start, n);
+}
+
+[[nodiscard]] constexpr std::uint64_t ngram_mix(std::uint64_t acc, std::uint64_t older) noexcept {
+    return zuu::detail::hash_mix(acc ^ zuu::detail::hash_k2, older ^ zuu::detail::hash_k3);
+}
+
+} // namespace detail
+
+// ==================== Token Hashing ====================
+
+/**
+ * @brief Writes token (and n-gram) hashes to `out`, returns the count
+ * For each token in order: its own hash, then the hashes of the 2..N
+ * token windows ending at it. Stops when `out` is full; at most
+ * tokens * ngrams entries are written. 32-bit outputs fold the 64-bit
+ * hash's halves together.
+ */
+struct hash_tokens_fn {
+    template <meta::character CharT, typename H, std::size_t Extent>
+        requires std::same_as<H, std::uint32_t> || std::same_as<H, std::uint64_t>
+    constexpr std::size_t operator()(
+        std::basic_string_view<CharT> text, std::span<H, Extent> out, const token_hash_options& opt = {}
+    ) const noexcept {
+        const std::size_t ngrams = std::clamp<std::size_t>(opt.ngrams, 1, detail::max_ngrams);
+        const std::uint64_t seed = zuu::detail::hash_seed(opt.seed);
+        return opt.fold_case
+            ? run<true>(text.data(), text.size(), out.data(), out.size(), ngrams, seed)
+            : run<false>(text.data(), text.size(), out.data(), out.size(), ngrams, seed);
+    }
+
+    template <meta::character CharT, std::size_t Cap, typename H, std::size_t Extent>
+        requires std::same_as<H, std::uint32_t> || std::same_as<H, std::uint64_t>
+    constexpr std::size_t operator()(
+        const basic_fstring<CharT, Cap>& text, std::span<H, Extent> out, const token_hash_options& opt = {}
+    ) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text.data(), text.size()}, out, opt);
+    }
+
+private:
+    // Plain locals only: stores through `out` may otherwise alias them
+    template <bool Fold, meta::character CharT, typename H>
+    static constexpr std::size_t run(
+        const CharT* p, std::size_t n, H* out, std::size_t cap, std::size_t ngrams, std::uint64_t seed
+    ) noexcept {
+        std::uint64_t recent[detail::max_ngrams]{};   // recent[k]: k tokens before the current one
+        std::size_t seen = 0;
+        std::size_t written = 0;
+        if (cap == 0) return 0;
+
+        const auto emit = [&](std::uint64_t h) {
+            if constexpr (sizeof(H) == 4) {
+                out[written++] = static_cast<H>(h ^ (h >> 32));
+            } else {
+                out[written++] = h;
+            }
+            return written < cap;
+        };
+
+        detail::for_each_token(p, n, [&](std::size_t b, std::size_t e) {
+            const std::uint64_t h = zuu::detail::hash_bytes(
+                zuu::detail::byte_reader<CharT, Fold>{p + b}, (e - b) * sizeof(CharT), seed);
+            if (!emit(h)) return false;
+
+            std::uint64_t acc = h;
+            const std::size_t window = std::min(ngrams - 1, seen);
+            for (std::size_t k = 0; k < window; ++k) {
+                acc = detail::ngram_mix(acc, recent[k]);
+                if (!emit(acc)) return false;
+            }
+            for (std::size_t k = ngrams - 1; k > 0; --k) recent[k] = recent[k - 1];
+            recent[0] = h;
+            ++seen;
+            return true;
+        });
+        return written;
+    }
+};
+
+inline constexpr hash_tokens_fn hash_tokens;
+
+} // namespace zuu::aggregate
@@ -0,0 +1,344 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/hyperloglog.hpp
+ * @brief HyperLogLog++ distinct counting over string streams
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::aggregate::hyperloglog<14> users;   // 2^14 registers, ~0.8% error
+ *   users.add("alice"_sfs);
+ *   users.add_all(batch);                    // span / vector of fstrings
+ *   auto n = users.estimate();
+ *
+ *   // Ship to an aggregator process and fold in
+ *   zuu::fstring<decltype(users)::max_serialized_size> wire;
+ *   users.save(wire);
+ *   auto peer = decltype(users)::load(wire);   // std::optional
+ *   if (peer) total.merge(*peer);
+ *
+ * Small sets stay in the HyperLogLog++ sparse form: sorted 25-bit
+ * register indices with their ranks, estimated by linear counting, which
+ * is exact-ish for thousands of keys and costs 4 bytes per key. Past
+ * m/4 entries the sketch converts to m one-byte dense registers. Dense
+ * estimates use Ertl's improved estimator, which needs no empirical
+ * bias tables. Dense registers merge with a vectorized byte maximum.
+ */
+
+#include "sketch.hpp"
+#include "../core/simd.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+namespace zuu::aggregate {
+
+namespace detail {
+
+// Ertl, "New cardinality estimation algorithms for HyperLogLog
+// sketches" (2017), eq. (19)-(20); both series converge in a few steps
+inline double hll_sigma(double x) noexcept {
+    if (x == 1.0) return std::numeric_limits<double>::infinity();
+    double y = 1.0, z = x, prev;
+    do {
+        x *= x;
+        prev = z;
+        z += x * y;
+        y += y;
+    } while (z != prev);
+    return z;
+}
+
+inline double hll_tau(double x) noexcept {
+    if (x == 0.0 || x == 1.0) return 0.0;
+    double y = 1.0, z = 1.0 - x, prev;
+    do {
+        x = std::sqrt(x);
+        prev = z;
+        y *= 0.5;
+        z -= (1.0 - x) * (1.0 - x) * y;
+    } while (z != prev);
+    return z / 3.0;
+}
+
+} // namespace detail
+
+// ==================== HyperLogLog ====================
+
+/**
+ * @brief HyperLogLog++ sketch with 2^P registers
+ * Relative standard error is about 1.04 / sqrt(2^P).
+ */
+template <unsigned P = 14>
+class hyperloglog {
+    static_assert(P >= 4 && P <= 18, "hyperloglog precision must be in [4, 18]");
+
+public:
+    static constexpr unsigned precision = P;
+    static constexpr std::size_t registers = std::size_t{1} << P;
+
+    /// Header (version, precision, mode) plus the dense registers
+    static constexpr std::size_t max_serialized_size = 3 + registers;
+
+    template <meta::string_like S>
+    void add(const S& key) {
+        add_hash(zuu::hash(detail::key_view(key)));
+    }
+
+    void add_hash(std::uint64_t h) {
+        if (dense()) {
+            const auto idx = static_cast<std::size_t>(h >> (64 - P));
+            const auto rank = static_cast<std::uint8_t>(std::countl_zero((h << P) | (std::uint64_t{1} << (P - 1))) + 1);
+            if (rank > registers_[idx]) registers_[idx] = rank;
+            return;
+        }
+        buffer_.push_back(encode(h));
+        if (buffer_.size() >= buffer_limit) flush();
+    }
+
+    /// Adds every key of a range (span, vector, split_result, ...)
+    template <meta::string_range R>
+    void add_all(const R& keys) {
+        std::array<std::uint64_t, detail::sketch_block> hashes;
+        std::size_t n = 0;
+        for (const auto& key : keys) {
+            hashes[n++] = zuu::hash(detail::key_view(key));
+            if (n == hashes.size()) {
+                for (const std::uint64_t h : hashes) add_hash(h);
+                n = 0;
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) add_hash(hashes[i]);
+    }
+
+    [[nodiscard]] bool dense() const noexcept { return !registers_.empty(); }
+
+    [[nodiscard]] double estimate() const {
+        if (!dense()) {
+            // Linear counting over the 2^25 sparse registers
+            constexpr double m = double(std::uint64_t{1} << sparse_p);
+            const double empty = m - double(sparse_distinct());
+            return m * std::log(m / empty);
+        }
+
+        constexpr unsigned q = 64 - P;
+        std::array<std::uint32_t, q + 2> hist{};
+        for (const std::uint8_t r : registers_) ++hist[r];
+
+        constexpr double m = double(registers);
+        double z = m * detail::hll_tau(1.0 - hist[q + 1] / m);
+        for (unsigned k = q; k >= 1; --k) z = 0.5 * (z + hist[k]);
+        z += m * detail::hll_sigma(hist[0] / m);
+        return (0.5 / std::log(2.0)) * m * m / z;
+    }
+
+    /// Union: the result estimates the distinct keys of both streams
+    hyperloglog& merge(const hyperloglog& other) {
+        if (&other == this) return *this;  // a union with itself changes nothing
+        if (other.dense()) {
+            if (!dense()) densify();
+            simd::max_bytes(registers_.data(), other.registers_.data(), registers);
+        } else if (dense()) {
+            for (const std::uint32_t e : other.list_) apply(e);
+            for (const std::uint32_t e : other.buffer_) apply(e);
+        } else {
+            buffer_.insert(buffer_.end(), other.list_.begin(), other.list_.end());
+            buffer_.insert(buffer_.end(), other.buffer_.begin(), other.buffer_.end());
+            flush();
+        }
+        return *this;
+    }
+
+    void clear() noexcept {
+        registers_.clear();
+        list_.clear();
+        buffer_.clear();
+    }
+
+    // ==================== Serialization ====================
+
+    /**
+     * @brief Writes the sketch to `out`, which needs serialized_size() bytes
+     * Sparse sketches are stored as delta varints when that is smaller
+     * than the dense registers.
+     */
+    std::size_t serialize(char* out) const {
+        auto* p = reinterpret_cast<std::uint8_t*>(out);
+        p[0] = format_version;
+        p[1] = static_cast<std::uint8_t>(P);
+        if (!dense()) {
+            const std::vector<std::uint32_t> entries = sparse_entries();
+            if (varint_size(entries) + 4 < registers) {
+                p[2] = 0;
+                std::size_t at = 3;
+                const auto count = static_cast<std::uint32_t>(entries.size());
+                for (int b = 0; b < 4; ++b) p[at++] = static_cast<std::uint8_t>(count >> (8 * b));
+                std::uint32_t prev = 0;
+                for (const std::uint32_t e : entries) {
+                    for (std::uint32_t d = e - prev; ; d >>= 7) {
+                        p[at++] = static_cast<std::uint8_t>((d & 0x7f) | (d >= 0x80 ? 0x80 : 0));
+                        if (d < 0x80) break;
+                    }
+                    prev = e;
+                }
+                return at;
+            }
+        }
+        p[2] = 1;
+        if (dense()) {
+            std::copy(registers_.begin(), registers_.end(), p + 3);
+        } else {
+            std::fill(p + 3, p + 3 + registers, std::uint8_t{0});
+            for (const std::uint32_t e : sparse_entries()) {
+                const auto [idx, rank] = to_dense(e);
+                p[3 + idx] = std::max(p[3 + idx], rank);
+            }
+        }
+        return max_serialized_size;
+    }
+
+    [[nodiscard]] std::size_t serialized_size() const {
+        if (dense()) return max_serialized_size;
+        const std::size_t sparse = 3 + 4 + varint_size(sparse_entries());
+        return sparse < max_serialized_size ? sparse : max_serialized_size;
+    }
+
+    template <std::size_t Cap>
+    void save(basic_fstring<char, Cap>& out) const {
+        static_assert(Cap >= max_serialized_size, "fstring too small for a serialized hyperloglog");
+        out.resize(Cap);
+        out.resize(serialize(out.data()));
+    }
+
+    /// Parses serialize() output; nullopt on a malformed or foreign buffer
+    [[nodiscard]] static std::optional<hyperloglog> load(std::string_view bytes) {
+        const auto* p = reinterpret_cast<const std::uint8_t*>(bytes.data());
+        const std::size_t n = bytes.size();
+        if (n < 3 || p[0] != format_version || p[1] != P) return std::nullopt;
+
+        hyperloglog h;
+        if (p[2] == 1) {
+            if (n != max_serialized_size) return std::nullopt;
+            h.registers_.assign(p + 3, p + n);
+            for (const std::uint8_t r : h.registers_) {
+                if (r > 64 - P + 1) return std::nullopt;
+            }
+            return h;
+        }
+        if (p[2] != 0 || n < 7) return std::nullopt;
+
+        std::uint32_t count = 0;
+        for (int b = 0; b < 4; ++b) count |= std::uint32_t(p[3 + b]) << (8 * b);
+        std::size_t at = 7;
+        if (count > n - at) return std::nullopt;   // at least one byte per entry
+        std::uint32_t prev = 0;
+        h.list_.reserve(count);
+        for (std::uint32_t i = 0; i < count; ++i) {
+            std::uint32_t d = 0;
+            for (unsigned shift = 0;; shift += 7) {
+                if (at == n || shift > 28) return std::nullopt;
+                d |= std::uint32_t(p[at] & 0x7f) << shift;
+                if (!(p[at++] & 0x80)) break;
+            }
+            if (d >= (std::uint32_t{1} << (sparse_p + 6)) - prev) return std::nullopt;
+            prev += d;
+            if ((prev & 0x3f) == 0 || (prev & 0x3f) > 64 - sparse_p + 1) return std::nullopt;
+            h.list_.push_back(prev);
+        }
+        if (at != n) return std::nullopt;
+        normalize(h.list_);
+        if (h.list_.size() > sparse_limit) h.densify();
+        return h;
+    }
+
+private:
+    static constexpr std::uint8_t format_version = 1;
+    static constexpr unsigned sparse_p = 25;
+    static constexpr std::size_t sparse_limit = registers / 4;    // 4-byte entries vs 1-byte registers
+    static constexpr std::size_t buffer_limit = registers / 16 + 16;
+
+    // Sparse entry: 25-bit index, then the 6-bit rank of the rest
+    [[nodiscard]] static std::uint32_t encode(std::uint64_t h) noexcept {
+        const auto idx = static_cast<std::uint32_t>(h >> (64 - sparse_p));
+        const auto rank = static_cast<std::uint32_t>(
+            std::countl_zero((h << sparse_p) | (std::uint64_t{1} << (sparse_p - 1))) + 1);
+        return idx << 6 | rank;
+    }
+
+    [[nodiscard]] static std::uint32_t index_of(std::uint32_t e) noexcept { return e >> 6; }
+
+    // The dense register and rank the same hash would have produced
+    [[nodiscard]] static std::pair<std::size_t, std::uint8_t> to_dense(std::uint32_t e) noexcept {
+        constexpr unsigned extra = sparse_p - P;
+        const std::uint32_t idx = index_of(e);
+        const std::uint32_t low = idx & ((std::uint32_t{1} << extra) - 1);
+        const unsigned rank = low != 0 ? std::countl_zero(low) - (32 - extra) + 1
+                                       : extra + (e & 0x3f);
+        return {idx >> extra, static_cast<std::uint8_t>(rank)};
+    }
+
+    void apply(std::uint32_t e) noexcept {
+        const auto [idx, rank] = to_dense(e);
+        if (rank > registers_[idx]) registers_[idx] = rank;
+    }
+
+    // Sorted by index, one entry (the highest rank) per index
+    static void normalize(std::vector<std::uint32_t>& v) {
+        std::sort(v.begin(), v.end());
+        std::size_t out = 0;
+        for (std::size_t i = 0; i < v.size(); ++i) {
+            if (out > 0 && index_of(v[out - 1]) == index_of(v[i])) v[out - 1] = v[i];
+            else v[out++] = v[i];
+        }
+        v.resize(out);
+    }
+
+    void flush() {
+        buffer_.insert(buffer_.end(), list_.begin(), list_.end());
+        normalize(buffer_);
+        list_.swap(buffer_);
+        buffer_.clear();
+        if (list_.size() > sparse_limit) densify();
+    }
+
+    void densify() {
+        registers_.assign(registers, 0);
+        for (const std::uint32_t e : list_) apply(e);
+        for (const std::uint32_t e : buffer_) apply(e);
+        std::vector<std::uint32_t>().swap(list_);
+        std::vector<std::uint32_t>().swap(buffer_);
+    }
+
+    [[nodiscard]] std::vector<std::uint32_t> sparse_entries() const {
+        std::vector<std::uint32_t> all(list_);
+        all.insert(all.end(), buffer_.begin(), buffer_.end());
+        normalize(all);
+        return all;
+    }
+
+    [[nodiscard]] std::size_t sparse_distinct() const {
+        return buffer_.empty() ? list_.size() : sparse_entries().size();
+    }
+
+    [[nodiscard]] static std::size_t varint_size(const std::vector<std::uint32_t>& entries) noexcept {
+        std::size_t n = 0;
+        std::uint32_t prev = 0;
+        for (const std::uint32_t e : entries) {
+            n += (std::bit_width((e - prev) | 1) + 6) / 7;
+            prev = e;
+        }
+        return n;
+    }
+
+    std::vector<std::uint8_t> registers_;   // dense mode when non-empty
+    std::vector<std::uint32_t> list_;       // sparse: normalized entries
+    std::vector<std::uint32_t> buffer_;     // sparse: recent, unsorted
+};
+
+} // namespace zuu::aggregate
@@ -0,0 +1,290 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/partition.hpp
+ * @brief Hash-partitioning shuffle of string records into packed tables
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::aggregate::hash_partitioner<> shuffle(16);
+ *
+ *   // Route every line by its host field; each partition owns its copies
+ *   shuffle.scatter(lines, [](std::string_view l) { return l.substr(0, l.find(' ')); });
+ *   for (std::size_t p = 0; p < shuffle.partitions(); ++p) {
+ *       const auto& table = shuffle.table(p);          // packed string table
+ *       for (std::size_t i = 0; i < table.size(); ++i) consume(p, table[i]);
+ *   }
+ *
+ *   // Or only views into the input
+ *   shuffle.scatter_views(lines, key_of);
+ *   for (std::string_view rec : shuffle.views(3)) ...
+ *
+ *   std::size_t owner = shuffle.partition_of("host-17");   // same routing
+ *
+ * Records are hashed once in a first parallel pass that also counts the
+ * records and characters each task sends to each partition. Prefix sums
+ * over those counts give every task its own output range in every
+ * partition, so the second pass writes without locks and partitions
+ * keep input order. Each worker gathers the characters bound for a
+ * partition in a small staging line and copies whole lines out, keeping
+ * the working set of many partitions in cache.
+ *
+ * Both passes run on a par::worker_pool the partitioner starts once,
+ * and tables and scratch buffers are kept between calls: once a
+ * partitioner has seen its largest batch, further batches allocate
+ * nothing and start no threads.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include "../core/parallel.hpp"
+#include "count.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace zuu::aggregate {
+
+struct shuffle_options {
+    std::size_t threads = 0;        // 0 = all hardware threads
+    std::size_t min_chunk = 4096;   // records per task, lower bound
+    std::uint64_t seed = 0;         // routing hash seed; equal seeds route equally
+};
+
+// ==================== Packed String Table ====================
+
+/**
+ * @brief Strings stored back to back in one character buffer
+ * clear() keeps the capacity for reuse.
+ */
+template <meta::character CharT = char>
+class string_table {
+public:
+    using view_type = std::basic_string_view<CharT>;
+
+    [[nodiscard]] std::size_t size() const noexcept { return ends_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return ends_.empty(); }
+
+    [[nodiscard]] view_type operator[](std::size_t i) const noexcept {
+        const std::size_t b = i == 0 ? 0 : ends_[i - 1];
+        return {chars_.data() + b, ends_[i] - b};
+    }
+
+    /// Every string, concatenated
+    [[nodiscard]] view_type chars() const noexcept { return {chars_.data(), chars_.size()}; }
+
+    /// End offset of each string within chars()
+    [[nodiscard]] std::span<const std::size_t> ends() const noexcept { return ends_; }
+
+    void push_back(view_type s) {
+        chars_.insert(chars_.end(), s.begin(), s.end());
+        ends_.push_back(chars_.size());
+    }
+
+    void reserve(std::size_t strings, std::size_t chars) {
+        ends_.reserve(strings);
+        chars_.reserve(chars);
+    }
+
+    void clear() noexcept {
+        ends_.clear();
+        chars_.clear();
+    }
+
+private:
+    template <meta::character>
+    friend class hash_partitioner;
+
+    std::vector<CharT> chars_;
+    std::vector<std::size_t> ends_;
+};
+
+namespace detail {
+
+// Default key: the whole record
+struct whole_record {
+    template <meta::char_range R>
+    [[nodiscard]] constexpr auto operator()(const R& r) const noexcept { return meta::as_view(r); }
+};
+
+} // namespace detail
+
+// ==================== Hash Partitioner ====================
+
+/**
+ * @brief Scatters records into N partitions by the hash of their key
+ * Partition p receives, in input order, every record whose key hashes
+ * to p. A key function maps a record (as a basic_string_view) to its
+ * key, any string-like value.
+ */
+template <meta::character CharT = char>
+class hash_partitioner {
+public:
+    using view_type = std::basic_string_view<CharT>;
+    using table_type = string_table<CharT>;
+
+    explicit hash_partitioner(std::size_t partitions, shuffle_options opt = {})
+        : parts_(std::max<std::size_t>(partitions, 1)), opt_(opt),
+          tables_(parts_), views_(parts_), pool_(opt.threads) {}
+
+    [[nodiscard]] std::size_t partitions() const noexcept { return parts_; }
+
+    /// Partition a record with this key is routed to
+    [[nodiscard]] std::size_t partition_of(view_type key) const noexcept {
+        return detail::partition_of(hash_chars(key.data(), key.size(), opt_.seed), parts_);
+    }
+
+    /// Copies every record into the string table of its partition
+    template <std::ranges::random_access_range R, typename KeyFn = detail::whole_record>
+    requires std::ranges::sized_range<R> && meta::char_range<std::ranges::range_value_t<R>>
+    void scatter(const R& records, KeyFn key_fn = {}) {
+        route(records, key_fn);
+        for (std::size_t p = 0; p < parts_; ++p) {
+            tables_[p].ends_.resize(strings_[tasks_ * parts_ + p]);
+            tables_[p].chars_.resize(chars_[tasks_ * parts_ + p]);
+        }
+        stages_.resize(pool_.size() * parts_);
+
+        auto first = std::ranges::begin(records);
+        pool_.for_each_task(tasks_, [&](std::size_t t, std::size_t w) {
+            stage* st = stages_.data() + w * parts_;
+            std::size_t* next_string = strings_.data() + t * parts_;
+            std::size_t* next_char = chars_.data() + t * parts_;
+            for (std::size_t p = 0; p < parts_; ++p) {
+                st[p].fill = 0;
+                st[p].flushed = next_char[p];
+            }
+
+            const std::size_t end = std::min(size_, (t + 1) * chunk_);
+            for (std::size_t i = t * chunk_; i < end; ++i) {
+                const std::uint32_t p = ids_[i];
+                const view_type rec = meta::as_view(first[static_cast<std::ptrdiff_t>(i)]);
+                table_type& table = tables_[p];
+                st[p].put(rec, table.chars_.data());
+                next_char[p] += rec.size();
+                table.ends_[next_string[p]++] = next_char[p];
+            }
+            for (std::size_t p = 0; p < parts_; ++p) st[p].flush(tables_[p].chars_.data());
+        });
+    }
+
+    /// Collects views of the records (which must outlive them) per partition
+    template <std::ranges::random_access_range R, typename KeyFn = detail::whole_record>
+    requires std::ranges::sized_range<R> && meta::char_range<std::ranges::range_value_t<R>>
+    void scatter_views(const R& records, KeyFn key_fn = {}) {
+        route(records, key_fn);
+        for (std::size_t p = 0; p < parts_; ++p) views_[p].resize(strings_[tasks_ * parts_ + p]);
+
+        auto first = std::ranges::begin(records);
+        pool_.for_each_task(tasks_, [&](std::size_t t, std::size_t) {
+            std::size_t* next = strings_.data() + t * parts_;
+            const std::size_t end = std::min(size_, (t + 1) * chunk_);
+            for (std::size_t i = t * chunk_; i < end; ++i) {
+                const std::uint32_t p = ids_[i];
+                views_[p][next[p]++] = meta::as_view(first[static_cast<std::ptrdiff_t>(i)]);
+            }
+        });
+    }
+
+    /// Records of partition p after scatter()
+    [[nodiscard]] const table_type& table(std::size_t p) const noexcept { return tables_[p]; }
+
+    /// Records of partition p after scatter_views()
+    [[nodiscard]] std::span<const view_type> views(std::size_t p) const noexcept { return views_[p]; }
+
+private:
+    static constexpr std::size_t stage_chars = 128 / sizeof(CharT);
+
+    // Write-combining buffer for one partition within one task
+    struct stage {
+        CharT line[stage_chars];
+        std::size_t fill = 0;
+        std::size_t flushed = 0;   // where line[0] goes in the partition
+
+        void flush(CharT* dest) noexcept {
+            if (fill == 0) return;
+            std::memcpy(dest + flushed, line, fill * sizeof(CharT));
+            flushed += fill;
+            fill = 0;
+        }
+
+        void put(view_type s, CharT* dest) noexcept {
+            if (fill + s.size() > stage_chars) {
+                flush(dest);
+                if (s.size() > stage_chars) {
+                    std::memcpy(dest + flushed, s.data(), s.size() * sizeof(CharT));
+                    flushed += s.size();
+                    return;
+                }
+            }
+            std::copy_n(s.data(), s.size(), line + fill);
+            fill += s.size();
+        }
+    };
+
+    /**
+     * Pass 1: hashes every key into ids_, then turns the per-task counts
+     * into each task's first string and character index per partition.
+     * Row tasks_ of strings_ / chars_ holds the partition totals.
+     */
+    template <typename R, typename KeyFn>
+    void route(const R& records, KeyFn& key_fn) {
+        size_ = std::ranges::size(records);
+        chunk_ = std::max(opt_.min_chunk, size_ / (pool_.size() * 8) + 1);
+        tasks_ = (size_ + chunk_ - 1) / chunk_;
+
+        ids_.resize(size_);
+        strings_.assign((tasks_ + 1) * parts_, 0);
+        chars_.assign((tasks_ + 1) * parts_, 0);
+
+        auto first = std::ranges::begin(records);
+        pool_.for_each_task(tasks_, [&](std::size_t t, std::size_t) {
+            std::size_t* strings = strings_.data() + t * parts_;
+            std::size_t* chars = chars_.data() + t * parts_;
+            const std::size_t end = std::min(size_, (t + 1) * chunk_);
+            for (std::size_t i = t * chunk_; i < end; ++i) {
+                const view_type rec = meta::as_view(first[static_cast<std::ptrdiff_t>(i)]);
+                const auto& key = key_fn(rec);
+                const std::size_t p = partition_of(view_type{key});
+                ids_[i] = static_cast<std::uint32_t>(p);
+                ++strings[p];
+                chars[p] += rec.size();
+            }
+        });
+
+        for (std::size_t p = 0; p < parts_; ++p) {
+            std::size_t s = 0;
+            std::size_t c = 0;
+            for (std::size_t t = 0; t <= tasks_; ++t) {
+                const std::size_t row = t * parts_ + p;
+                const std::size_t ns = strings_[row];
+                const std::size_t nc = chars_[row];
+                strings_[row] = s;
+                chars_[row] = c;
+                s += ns;
+                c += nc;
+            }
+        }
+    }
+
+    std::size_t parts_;
+    shuffle_options opt_;
+    std::vector<table_type> tables_;
+    std::vector<std::vector<view_type>> views_;
+    par::worker_pool pool_;
+
+    // Scratch reused by every call
+    std::vector<std::uint32_t> ids_;
+    std::vector<std::size_t> strings_;   // (tasks + 1) x partitions
+    std::vector<std::size_t> chars_;
+    std::vector<stage> stages_;          // workers x partitions
+    std::size_t size_ = 0;
+    std::size_t chunk_ = 1;
+    std::size_t tasks_ = 0;
+};
+
+} // namespace zuu::aggregate
@@ -0,0 +1,358 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/similarity.hpp
+ * @brief Shingling, MinHash and SimHash signatures, LSH candidate pairs
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::aggregate::minhash<128> mh({.unit = shingle_unit::chars, .size = 5});
+ *   auto sigs = mh.batch(messages);                 // parallel, one per message
+ *   double j = mh.similarity(sigs[0], sigs[1]);      // ~ Jaccard of shingle sets
+ *
+ *   // Pairs worth comparing, without comparing all n^2 of them
+ *   for (auto [a, b] : zuu::aggregate::lsh_candidates(sigs, {.bands = 32})) ...
+ *
+ *   zuu::aggregate::simhash sh({.unit = shingle_unit::tokens, .size = 2});
+ *   std::uint64_t fp = sh(message);
+ *   if (sh.distance(fp, other) <= 3) ...            // near-duplicate
+ *
+ * Shingles are hashed in place, folding ASCII case inside the hash's own
+ * loads; no shingle strings are built. Token shingles use the tokens
+ * and n-gram hashes of hash_tokens, so a k-token shingle hash equals the
+ * k-gram feature id it emits. MinHash applies K multiply-shift hash
+ * functions to every shingle; their coefficients sit in flat arrays so
+ * the update is a branchless loop compilers vectorize.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include "../core/parallel.hpp"
+#include "features.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace zuu::aggregate {
+
+enum class shingle_unit { chars, tokens };
+
+struct shingle_options {
+    shingle_unit unit = shingle_unit::chars;
+    std::size_t size = 5;       // characters or tokens per shingle (tokens: max 8)
+    bool fold_case = true;      // hash ASCII letters as lowercase
+    std::uint64_t seed = 0;
+};
+
+struct lsh_options {
+    std::size_t bands = 16;     // rows per band = signature size / bands
+    std::size_t threads = 0;    // 0 = all hardware threads
+};
+
+namespace detail {
+
+/**
+ * @brief Calls fn(hash) for every shingle of the text
+ * Text shorter than one shingle is a single shingle; empty text has none.
+ */
+template <bool Fold, meta::character CharT, typename Fn>
+constexpr void for_each_shingle(const CharT* p, std::size_t n, const shingle_options& opt, Fn&& fn) {
+    const std::uint64_t seed = zuu::detail::hash_seed(opt.seed);
+    const auto hash_at = [&](std::size_t b, std::size_t len) {
+        return zuu::detail::hash_bytes(zuu::detail::byte_reader<CharT, Fold>{p + b}, len * sizeof(CharT), seed);
+    };
+
+    if (opt.unit == shingle_unit::chars) {
+        if (n == 0) return;
+        const std::size_t w = std::clamp<std::size_t>(opt.size, 1, n);
+        for (std::size_t i = 0; i + w <= n; ++i) fn(hash_at(i, w));
+        return;
+    }
+
+    const std::size_t k = std::clamp<std::size_t>(opt.size, 1, max_ngrams);
+    std::uint64_t recent[max_ngrams]{};     // recent[j]: j tokens before the current one
+    std::size_t seen = 0;
+    const auto window = [&](std::size_t len) {
+        std::uint64_t acc = recent[0];
+        for (std::size_t j = 1; j < len; ++j) acc = ngram_mix(acc, recent[j]);
+        return acc;
+    };
+    for_each_token(p, n, [&](std::size_t b, std::size_t e) {
+        for (std::size_t j = k - 1; j > 0; --j) recent[j] = recent[j - 1];
+        recent[0] = hash_at(b, e - b);
+        if (++seen >= k) fn(window(k));
+        return true;
+    });
+    if (seen > 0 && seen < k) fn(window(seen));
+}
+
+template <meta::character CharT, typename Fn>
+constexpr void for_each_shingle(std::basic_string_view<CharT> text, const shingle_options& opt, Fn&& fn) {
+    if (opt.fold_case) {
+        for_each_shingle<true>(text.data(), text.size(), opt, fn);
+    } else {
+        for_each_shingle<false>(text.data(), text.size(), opt, fn);
+    }
+}
+
+[[nodiscard]] constexpr std::uint64_t splitmix(std::uint64_t& state) noexcept {
+    std::uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+    return z ^ (z >> 31);
+}
+
+// bit_spread[v]: byte j holds bit j of v
+inline constexpr auto bit_spread = [] {
+    std::array<std::uint64_t, 256> t{};
+    for (std::size_t v = 0; v < 256; ++v) {
+        for (unsigned j = 0; j < 8; ++j) t[v] |= std::uint64_t((v >> j) & 1) << (8 * j);
+    }
+    return t;
+}();
+
+// Any random-access range of contiguous character ranges (fstrings, views, ...)
+template <typename R>
+concept document_range =
+    std::ranges::random_access_range<const R> &&
+    std::ranges::sized_range<const R> &&
+    meta::char_range<std::ranges::range_value_t<R>>;
+
+// out[i] = fn(docs[i]), in parallel over blocks of documents
+template <typename Out, typename R, typename Fn>
+std::vector<Out> map_documents(const R& docs, std::size_t threads, Fn&& fn) {
+    constexpr std::size_t block = 64;
+    const std::size_t n = std::ranges::size(docs);
+    std::vector<Out> out(n);
+    auto first = std::ranges::begin(docs);
+    par::for_each_task((n + block - 1) / block, threads, [&](std::size_t t, std::size_t) {
+        const std::size_t end = std::min(n, (t + 1) * block);
+        for (std::size_t i = t * block; i < end; ++i) {
+            out[i] = fn(meta::as_view(first[static_cast<std::ptrdiff_t>(i)]));
+        }
+    });
+    return out;
+}
+
+} // namespace detail
+
+// ==================== Shingles ====================
+
+/**
+ * @brief Writes the shingle hashes of `text` to `out`, returns the count
+ * Stops when `out` is full.
+ */
+struct shingles_fn {
+    template <meta::character CharT, std::size_t Extent>
+    constexpr std::size_t operator()(
+        std::basic_string_view<CharT> text, std::span<std::uint64_t, Extent> out, const shingle_options& opt = {}
+    ) const noexcept {
+        std::size_t written = 0;
+        const std::size_t cap = out.size();
+        std::uint64_t* dst = out.data();
+        if (cap == 0) return 0;
+        detail::for_each_shingle(text, opt, [&](std::uint64_t h) {
+            if (written < cap) dst[written++] = h;
+        });
+        return written;
+    }
+
+    template <meta::character CharT, std::size_t Cap, std::size_t Extent>
+    constexpr std::size_t operator()(
+        const basic_fstring<CharT, Cap>& text, std::span<std::uint64_t, Extent> out, const shingle_options& opt = {}
+    ) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text.data(), text.size()}, out, opt);
+    }
+};
+
+inline constexpr shingles_fn shingles;
+
+// ==================== MinHash ====================
+
+/**
+ * @brief K-value MinHash signatures of shingle sets
+ * The fraction of equal positions in two signatures estimates the
+ * Jaccard similarity of the shingle sets, with standard error about
+ * sqrt(J(1-J)/K). Signatures are comparable only between hashers built
+ * with the same options.
+ */
+template <std::size_t K = 128>
+class minhash {
+    static_assert(K > 0, "minhash needs at least one hash function");
+
+public:
+    using signature = std::array<std::uint32_t, K>;
+    static constexpr std::size_t size = K;
+
+    explicit minhash(const shingle_options& opt = {}) noexcept : opt_(opt) {
+        std::uint64_t state = opt.seed ^ zuu::detail::hash_k0;
+        for (std::size_t i = 0; i < K; ++i) {
+            mul_[i] = detail::splitmix(state) | 1;
+            add_[i] = detail::splitmix(state);
+        }
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] signature operator()(std::basic_string_view<CharT> text) const noexcept {
+        signature sig;
+        sig.fill(std::numeric_limits<std::uint32_t>::max());
+        detail::for_each_shingle(text, opt_, [&](std::uint64_t h) {
+            // h_i(x) = (a_i * x + b_i) >> 32 over the folded 32-bit shingle hash
+            const std::uint64_t x = (h ^ (h >> 32)) & 0xffffffffu;
+            for (std::size_t i = 0; i < K; ++i) {
+                const auto v = static_cast<std::uint32_t>((mul_[i] * x + add_[i]) >> 32);
+                sig[i] = v < sig[i] ? v : sig[i];
+            }
+        });
+        return sig;
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] signature operator()(const basic_fstring<CharT, Cap>& text) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text.data(), text.size()});
+    }
+
+    /// One signature per document, computed in parallel
+    template <detail::document_range R>
+    [[nodiscard]] std::vector<signature> batch(const R& docs, std::size_t threads = 0) const {
+        return detail::map_documents<signature>(docs, threads, [this](auto text) { return (*this)(text); });
+    }
+
+    /// Estimated Jaccard similarity in [0, 1]
+    [[nodiscard]] static double similarity(const signature& a, const signature& b) noexcept {
+        std::size_t same = 0;
+        for (std::size_t i = 0; i < K; ++i) same += a[i] == b[i];
+        return double(same) / double(K);
+    }
+
+private:
+    shingle_options opt_;
+    std::array<std::uint64_t, K> mul_{};
+    std::array<std::uint64_t, K> add_{};
+};
+
+// ==================== SimHash ====================
+
+/**
+ * @brief 64-bit SimHash fingerprints
+ * Every shingle votes on every bit; similar shingle sets give
+ * fingerprints a small Hamming distance apart.
+ */
+class simhash {
+public:
+    explicit simhash(const shingle_options& opt = {}) noexcept : opt_(opt) {}
+
+    template <meta::character CharT>
+    [[nodiscard]] std::uint64_t operator()(std::basic_string_view<CharT> text) const noexcept {
+        // Set-bit counts per bit, eight byte-wide counters to a word,
+        // widened to 32 bits before a byte can overflow
+        std::uint64_t lanes[8]{};
+        std::uint32_t ones[64]{};
+        std::size_t total = 0, pending = 0;
+        const auto flush = [&] {
+            for (unsigned k = 0; k < 8; ++k) {
+                for (unsigned j = 0; j < 8; ++j) ones[8 * k + j] += static_cast<std::uint32_t>((lanes[k] >> (8 * j)) & 0xff);
+                lanes[k] = 0;
+            }
+            pending = 0;
+        };
+        detail::for_each_shingle(text, opt_, [&](std::uint64_t h) {
+            for (unsigned k = 0; k < 8; ++k) lanes[k] += detail::bit_spread[(h >> (8 * k)) & 0xff];
+            ++total;
+            if (++pending == 255) flush();
+        });
+        flush();
+
+        // Bit b is set when most shingles have it set
+        std::uint64_t fp = 0;
+        for (unsigned b = 0; b < 64; ++b) fp |= std::uint64_t(2 * std::size_t{ones[b]} > total) << b;
+        return fp;
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] std::uint64_t operator()(const basic_fstring<CharT, Cap>& text) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text.data(), text.size()});
+    }
+
+    /// One fingerprint per document, computed in parallel
+    template <detail::document_range R>
+    [[nodiscard]] std::vector<std::uint64_t> batch(const R& docs, std::size_t threads = 0) const {
+        return detail::map_documents<std::uint64_t>(docs, threads, [this](auto text) { return (*this)(text); });
+    }
+
+    /// Hamming distance between two fingerprints
+    [[nodiscard]] static unsigned distance(std::uint64_t a, std::uint64_t b) noexcept {
+        return static_cast<unsigned>(std::popcount(a ^ b));
+    }
+
+private:
+    shingle_options opt_;
+};
+
+// ==================== LSH Banding ====================
+
+/**
+ * @brief Index pairs (i < j) of signatures that agree on a whole band
+ *
+ * Signatures are cut into `bands` bands of K / bands rows. Two documents
+ * of Jaccard similarity s become candidates with probability
+ * 1 - (1 - s^rows)^bands, an S-curve rising around (1 / bands)^(1 / rows).
+ * Bands are bucketed in parallel by sorting their hashes; pairs are
+ * returned sorted and unique. A bucket of b identical documents yields
+ * b(b-1)/2 pairs, so exact duplicates are best collapsed first.
+ */
+template <std::size_t K>
+[[nodiscard]] std::vector<std::pair<std::uint32_t, std::uint32_t>> lsh_candidates(
+    std::span<const std::array<std::uint32_t, K>> sigs, const lsh_options& opt = {}
+) {
+    using pair_type = std::pair<std::uint32_t, std::uint32_t>;
+    const std::size_t bands = std::clamp<std::size_t>(opt.bands, 1, K);
+    const std::size_t rows = K / bands;
+    const std::size_t n = std::min<std::size_t>(sigs.size(), std::numeric_limits<std::uint32_t>::max());
+
+    std::vector<std::vector<pair_type>> found(bands);
+    par::for_each_task(bands, opt.threads, [&](std::size_t band, std::size_t) {
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> keys(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            std::uint64_t acc = zuu::detail::hash_k1 ^ band;
+            for (std::size_t r = band * rows; r < (band + 1) * rows; ++r) {
+                acc = zuu::detail::hash_mix(acc ^ sigs[i][r], zuu::detail::hash_k2);
+            }
+            keys[i] = {acc, static_cast<std::uint32_t>(i)};
+        }
+        std::sort(keys.begin(), keys.end());
+
+        auto& out = found[band];
+        for (std::size_t b = 0, e = 0; b < n; b = e) {
+            while (e < n && keys[e].first == keys[b].first) ++e;
+            for (std::size_t i = b; i < e; ++i) {
+                for (std::size_t j = i + 1; j < e; ++j) out.emplace_back(keys[i].second, keys[j].second);
+            }
+        }
+    });
+
+    std::size_t total = 0;
+    for (const auto& f : found) total += f.size();
+    std::vector<pair_type> pairs;
+    pairs.reserve(total);
+    for (const auto& f : found) pairs.insert(pairs.end(), f.begin(), f.end());
+    std::sort(pairs.begin(), pairs.end());
+    pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+    return pairs;
+}
+
+template <std::size_t K>
+[[nodiscard]] std::vector<std::pair<std::uint32_t, std::uint32_t>> lsh_candidates(
+    const std::vector<std::array<std::uint32_t, K>>& sigs, const lsh_options& opt = {}
+) {
+    return lsh_candidates(std::span<const std::array<std::uint32_t, K>>{sigs}, opt);
+}
+
+} // namespace zuu::aggregate
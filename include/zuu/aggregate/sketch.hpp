@@ -0,0 +1,359 @@
+#pragma once
+
+/**
+ * @file zuu/aggregate/sketch.hpp
+ * @brief Fixed-footprint frequency sketches: Count-Min and Space-Saving
+ * @version 3.0.0
+ *
+ * Usage:
+ *   // Approximate counts for any key, never underestimated
+ *   auto cms = std::make_unique<zuu::aggregate::count_min<1 << 16, 4>>();
+ *   cms->add_all(hosts);                     // span / vector of fstrings
+ *   cms->estimate("example.com");
+ *
+ *   // The k heaviest keys with per-key error bounds
+ *   zuu::aggregate::space_saving<1024> top;  // 1024 counters, keys fstring<64>
+ *   top.add_all(agents);
+ *   for (auto& h : top.top(10)) std::cout << h.key << ' ' << h.count << '\n';
+ *
+ *   // Per-thread (or per-process) sketches combine exactly like one
+ *   a.merge(b);
+ *
+ * Both sketches keep all state in fixed arrays sized by template
+ * arguments and are trivially copyable: a sketch can be written to a
+ * pipe or file as raw bytes and merged by another process built from
+ * the same definitions. Keys are hashed with zuu::hash; Space-Saving
+ * stores them as basic_fstring<CharT, KeyCap>, truncated like every
+ * other fstring operation.
+ */
+
+#include "count.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+namespace zuu::aggregate {
+
+namespace detail {
+
+// Keys hashed per block before any counter is touched, so the hash
+// arithmetic overlaps the cache misses of the updates
+inline constexpr std::size_t sketch_block = 32;
+
+template <typename S>
+[[nodiscard]] constexpr auto key_view(const S& key) noexcept {
+    return as_view<meta::char_type_of_t<S>>(key);
+}
+
+} // namespace detail
+
+// ==================== Count-Min Sketch ====================
+
+/**
+ * @brief Count-Min sketch with Depth rows of Width counters
+ *
+ * estimate(key) >= true count, and exceeds it by more than
+ * e / Width * total() with probability at most e^-Depth. Row indices
+ * come from one 64-bit hash by double hashing.
+ */
+template <std::size_t Width, std::size_t Depth = 4, std::unsigned_integral Counter = std::uint32_t>
+class count_min {
+    static_assert(std::has_single_bit(Width), "count_min width must be a power of two");
+    static_assert(Depth > 0 && Depth <= 16, "count_min depth must be in [1, 16]");
+
+public:
+    using counter_type = Counter;
+
+    static constexpr std::size_t width = Width;
+    static constexpr std::size_t depth = Depth;
+
+    template <meta::string_like S>
+    void add(const S& key, Counter n = 1) noexcept {
+        add_hashed(zuu::hash(detail::key_view(key)), n);
+    }
+
+    void add_hashed(std::uint64_t h, Counter n = 1) noexcept {
+        for (std::size_t r = 0; r < Depth; ++r) rows_[r * Width + index(h, r)] += n;
+        total_ += n;
+    }
+
+    /// Adds every key of a range (span, vector, split_result, ...)
+    template <meta::string_range R>
+    void add_all(const R& keys) noexcept {
+        std::array<std::uint64_t, detail::sketch_block> hashes;
+        std::size_t n = 0;
+        for (const auto& key : keys) {
+            hashes[n++] = zuu::hash(detail::key_view(key));
+            if (n == hashes.size()) {
+                for (const std::uint64_t h : hashes) add_hashed(h);
+                n = 0;
+            }
+        }
+        for (std::size_t i = 0; i < n; ++i) add_hashed(hashes[i]);
+    }
+
+    template <meta::string_like S>
+    [[nodiscard]] Counter estimate(const S& key) const noexcept {
+        return estimate_hashed(zuu::hash(detail::key_view(key)));
+    }
+
+    [[nodiscard]] Counter estimate_hashed(std::uint64_t h) const noexcept {
+        Counter best = std::numeric_limits<Counter>::max();
+        for (std::size_t r = 0; r < Depth; ++r) best = std::min(best, rows_[r * Width + index(h, r)]);
+        return best;
+    }
+
+    /// Sum of all added counts
+    [[nodiscard]] std::uint64_t total() const noexcept { return total_; }
+
+    /// Counter-wise sum: the result sketches the union of both streams
+    count_min& merge(const count_min& other) noexcept {
+        for (std::size_t i = 0; i < rows_.size(); ++i) rows_[i] += other.rows_[i];
+        total_ += other.total_;
+        return *this;
+    }
+
+    void clear() noexcept {
+        rows_.fill(0);
+        total_ = 0;
+    }
+
+private:
+    [[nodiscard]] static constexpr std::size_t index(std::uint64_t h, std::size_t r) noexcept {
+        const std::uint64_t step = (h >> 32) | 1;
+        return static_cast<std::size_t>((h + r * step) & (Width - 1));
+    }
+
+    std::array<Counter, Width * Depth> rows_{};
+    std::uint64_t total_ = 0;
+};
+
+// ==================== Space-Saving ====================
+
+template <typename Key>
+struct heavy_hitter {
+    Key key;
+    std::uint64_t count = 0;   // upper bound of the true count
+    std::uint64_t error = 0;   // count - error is a lower bound
+};
+
+/**
+ * @brief Space-Saving top-K summary with K counters
+ *
+ * Any key whose true count exceeds total() / K is tracked. An untracked
+ * key evicts the smallest counter and inherits its count as error.
+ * Counters sit in a min-heap by count, with a linear-probing index
+ * from key hash to counter, so each update is O(log K).
+ */
+template <std::size_t K, std::size_t KeyCap = 64, meta::character CharT = char>
+class space_saving {
+    static_assert(K > 0 && K < (std::size_t{1} << 31), "space_saving needs 1 <= K < 2^31 counters");
+
+public:
+    using key_type = basic_fstring<CharT, KeyCap>;
+    using view_type = std::basic_string_view<CharT>;
+    using entry_type = heavy_hitter<key_type>;
+
+    static constexpr std::size_t capacity = K;
+
+    [[nodiscard]] static view_type clamp(view_type key) noexcept {
+        return key.substr(0, std::min(key.size(), KeyCap));
+    }
+
+    void add(view_type key, std::uint64_t n = 1) noexcept {
+        key = clamp(key);
+        add_hashed(key, zuu::hash(key), n);
+    }
+
+    // `key` must already be clamped and `h` must be its hash
+    void add_hashed(view_type key, std::uint64_t h, std::uint64_t n = 1) noexcept {
+        total_ += n;
+        const std::size_t at = probe(key, h);
+        if (index_[at] != 0) {
+            const std::uint32_t c = index_[at] - 1;
+            counters_[c].count += n;
+            sift_down(pos_[c]);
+            return;
+        }
+        if (size_ < K) {
+            const std::uint32_t c = size_++;
+            counters_[c] = {key_type{key}, n, 0};
+            hashes_[c] = h;
+            index_[at] = c + 1;
+            heap_[c] = c;
+            pos_[c] = c;
+            sift_up(c);
+            return;
+        }
+        // Evict the minimum; the newcomer may have occurred that often
+        const std::uint32_t c = heap_[0];
+        const std::uint64_t floor = counters_[c].count;
+        erase_index(hashes_[c], c);
+        counters_[c] = {key_type{key}, floor + n, floor};
+        hashes_[c] = h;
+        index_[probe(key, h)] = c + 1;
+        sift_down(0);
+    }
+
+    template <meta::string_range R>
+    void add_all(const R& keys) noexcept {
+        for (const auto& key : keys) add(detail::as_view<CharT>(key));
+    }
+
+    /// Tracked count of `key` (an upper bound), or 0 when untracked
+    [[nodiscard]] std::uint64_t count(view_type key) const noexcept {
+        const entry_type* e = find(key);
+        return e ? e->count : 0;
+    }
+
+    [[nodiscard]] const entry_type* find(view_type key) const noexcept {
+        key = clamp(key);
+        const std::size_t at = probe(key, zuu::hash(key));
+        return index_[at] ? &counters_[index_[at] - 1] : nullptr;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] std::uint64_t total() const noexcept { return total_; }
+
+    /// Bound on the count of any untracked key
+    [[nodiscard]] std::uint64_t min_count() const noexcept {
+        return size_ < K ? 0 : counters_[heap_[0]].count;
+    }
+
+    /// The n largest counters, by count descending then key
+    [[nodiscard]] std::vector<entry_type> top(std::size_t n) const {
+        std::vector<entry_type> out(counters_.begin(), counters_.begin() + size_);
+        n = std::min(n, out.size());
+        std::partial_sort(out.begin(), out.begin() + n, out.end(), [](const entry_type& a, const entry_type& b) {
+            return a.count != b.count ? a.count > b.count : a.key < b.key;
+        });
+        out.resize(n);
+        return out;
+    }
+
+    /**
+     * @brief Combine with a summary of another stream
+     * Keys missing from a full summary may have occurred up to its
+     * min_count() times there, so they are credited that much (as
+     * error). The K largest of the union are kept.
+     */
+    space_saving& merge(const space_saving& other) {
+        const std::uint64_t mine = min_count();
+        const std::uint64_t theirs = other.min_count();
+
+        struct hashed {
+            entry_type e;
+            std::uint64_t hash;
+        };
+        std::vector<hashed> all;
+        all.reserve(size_ + other.size_);
+        for (std::uint32_t c = 0; c < size_; ++c) {
+            hashed m{counters_[c], hashes_[c]};
+            const std::size_t at = other.probe(view_type{m.e.key}, m.hash);
+            const entry_type* o = other.index_[at] ? &other.counters_[other.index_[at] - 1] : nullptr;
+            m.e.count += o ? o->count : theirs;
+            m.e.error += o ? o->error : theirs;
+            all.push_back(m);
+        }
+        for (std::uint32_t c = 0; c < other.size_; ++c) {
+            const entry_type& o = other.counters_[c];
+            if (index_[probe(view_type{o.key}, other.hashes_[c])] != 0) continue;
+            all.push_back({{o.key, o.count + mine, o.error + mine}, other.hashes_[c]});
+        }
+        if (all.size() > K) {
+            std::nth_element(all.begin(), all.begin() + K, all.end(),
+                             [](const hashed& a, const hashed& b) { return a.e.count > b.e.count; });
+            all.resize(K);
+        }
+
+        const std::uint64_t total = total_ + other.total_;
+        clear();
+        total_ = total;
+        for (const hashed& m : all) {
+            const auto i = size_++;
+            counters_[i] = m.e;
+            hashes_[i] = m.hash;
+            index_[probe(view_type{m.e.key}, m.hash)] = i + 1;
+            heap_[i] = i;
+            pos_[i] = i;
+        }
+        for (std::size_t i = size_ / 2; i-- > 0;) sift_down(i);
+        return *this;
+    }
+
+    void clear() noexcept {
+        index_.fill(0);
+        size_ = 0;
+        total_ = 0;
+    }
+
+private:
+    static constexpr std::size_t table_size = std::bit_ceil(K * 2);
+    static constexpr std::size_t mask = table_size - 1;
+
+    // Slot holding `key`, or the empty slot where it would go
+    [[nodiscard]] std::size_t probe(view_type key, std::uint64_t h) const noexcept {
+        for (std::size_t i = h & mask;; i = (i + 1) & mask) {
+            const std::uint32_t c = index_[i];
+            if (c == 0) return i;
+            if (hashes_[c - 1] == h && view_type{counters_[c - 1].key} == key) return i;
+        }
+    }
+
+    // Backward-shift deletion keeps every probe chain unbroken
+    void erase_index(std::uint64_t h, std::uint32_t c) noexcept {
+        std::size_t hole = h & mask;
+        while (index_[hole] != c + 1) hole = (hole + 1) & mask;
+        for (std::size_t i = (hole + 1) & mask; index_[i] != 0; i = (i + 1) & mask) {
+            const std::size_t ideal = hashes_[index_[i] - 1] & mask;
+            if (((i - ideal) & mask) >= ((i - hole) & mask)) {
+                index_[hole] = index_[i];
+                hole = i;
+            }
+        }
+        index_[hole] = 0;
+    }
+
+    [[nodiscard]] bool less(std::size_t a, std::size_t b) const noexcept {
+        return counters_[heap_[a]].count < counters_[heap_[b]].count;
+    }
+
+    void swap_heap(std::size_t a, std::size_t b) noexcept {
+        std::swap(heap_[a], heap_[b]);
+        pos_[heap_[a]] = static_cast<std::uint32_t>(a);
+        pos_[heap_[b]] = static_cast<std::uint32_t>(b);
+    }
+
+    void sift_up(std::size_t i) noexcept {
+        while (i > 0 && less(i, (i - 1) / 2)) {
+            swap_heap(i, (i - 1) / 2);
+            i = (i - 1) / 2;
+        }
+    }
+
+    void sift_down(std::size_t i) noexcept {
+        for (;;) {
+            std::size_t m = i;
+            const std::size_t l = 2 * i + 1, r = l + 1;
+            if (l < size_ && less(l, m)) m = l;
+            if (r < size_ && less(r, m)) m = r;
+            if (m == i) return;
+            swap_heap(i, m);
+            i = m;
+        }
+    }
+
+    std::array<entry_type, K> counters_{};
+    std::array<std::uint64_t, K> hashes_{};
+    std::array<std::uint32_t, K> heap_{};    // counter indices, min-heap by count
+    std::array<std::uint32_t, K> pos_{};     // heap position of each counter
+    std::array<std::uint32_t, table_size> index_{};  // counter index + 1, 0 = empty
+    std::uint32_t size_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+} // namespace zuu::aggregate
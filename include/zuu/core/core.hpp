@@ -13,13 +13,18 @@
 
 #include "../meta/concepts.hpp"
 #include "../meta/traits.hpp"
+#include "simd.hpp"
 #include <algorithm>
+#include <compare>
 #include <stdexcept>
 
 namespace zuu {
 
 // ==================== Core Storage Class ====================
 
+template <meta::character CharT>
+class fstring_ref;
+
 template <meta::character CharT, std::size_t Cap>
 class basic_fstring {
 public:
@@ -41,6 +46,10 @@ private:
     alignas(CharT) CharT data_[Cap + 1]{}; 
     size_type size_{};
 
+    // Edits data_ and size_ in place
+    template <meta::character>
+    friend class fstring_ref;
+
     // Internal helpers
     constexpr void set_null_terminator() noexcept {
         data_[size_] = CharT{};
@@ -208,10 +217,9 @@ public:
 	// ==================== Search Operations ====================
 
 	[[nodiscard]] constexpr size_type find(CharT ch, size_type pos = 0) const noexcept {
-        for (size_type i = pos; i < size_; ++i) {
-            if (data_[i] == ch) return i;
-        }
-        return npos;
+        if (pos >= size_) return npos;
+        const auto at = simd::find_char(data_ + pos, size_ - pos, ch);
+        return at == simd::npos ? npos : pos + at;
     }
     
     [[nodiscard]] constexpr size_type find(const_pointer str, size_type pos = 0) const noexcept {
@@ -223,27 +231,16 @@ public:
         if (str_len == 0) return pos;
         if (pos + str_len > size_) return npos;
         
-        for (size_type i = pos; i <= size_ - str_len; ++i) {
-            bool match = true;
-            for (size_type j = 0; j < str_len; ++j) {
-                if (data_[i + j] != str[j]) {
-                    match = false;
-                    break;
-                }
-            }
-            if (match) return i;
-        }
-        return npos;
+        const auto at = simd::find(data_ + pos, size_ - pos, str, str_len);
+        return at == simd::npos ? npos : pos + at;
     }
     
     [[nodiscard]] constexpr size_type rfind(CharT ch, size_type pos = npos) const noexcept {
         if (size_ == 0) return npos;
         
         size_type search_end = (pos >= size_) ? size_ - 1 : pos;
-        for (size_type i = search_end + 1; i > 0; --i) {
-            if (data_[i - 1] == ch) return i - 1;
-        }
-        return npos;
+        const auto at = simd::rfind_char(data_, search_end + 1, ch);
+        return at == simd::npos ? npos : at;
     }
     
     [[nodiscard]] constexpr bool contains(CharT ch) const noexcept {
@@ -279,10 +276,7 @@ public:
         
         if (str_len > size_) return false;
         
-        for (size_type i = 0; i < str_len; ++i) {
-            if (data_[size_ - str_len + i] != str[i]) return false;
-        }
-        return true;
+        return simd::equal(data_ + size_ - str_len, str, str_len);
     }
 
 	// ==================== Substring ====================
@@ -304,10 +298,24 @@ public:
 
     // ==================== Comparison ====================
     
-    [[nodiscard]] constexpr auto operator<=>(const basic_fstring&) const noexcept = default;
+    // Only [0, size) takes part: bytes past the terminator may be stale
+    [[nodiscard]] constexpr bool operator==(const basic_fstring& rhs) const noexcept {
+        return size_ == rhs.size_ && simd::equal(data_, rhs.data_, size_);
+    }
+    
+    [[nodiscard]] constexpr std::strong_ordering operator<=>(const basic_fstring& rhs) const noexcept {
+        return simd::compare(data_, size_, rhs.data_, rhs.size_) <=> 0;
+    }
     
     [[nodiscard]] constexpr bool operator==(std::basic_string_view<CharT> sv) const noexcept {
-        return std::basic_string_view<CharT>{data_, size_} == sv;
+        return size_ == sv.size() && simd::equal(data_, sv.data(), size_);
+    }
+    
+    template <size_type N>
+    [[nodiscard]] constexpr bool operator==(const CharT (&str)[N]) const noexcept {
+        size_type len = 0;
+        while (len < N && str[len] != CharT{}) ++len;
+        return size_ == len && simd::equal(data_, str, len);
     }
 
     // ==================== Conversions ====================
@@ -334,7 +342,7 @@ public:
     [[nodiscard]] constexpr auto operator+(const CharT (&rhs)[N]) const noexcept {
         basic_fstring<CharT, Cap + N> result;
         result.append(data_, size_);
-        result.append(rhs, N);
+        result.append(rhs, N - 1);
         return result;
     }
 
@@ -345,7 +353,7 @@ public:
 
 	template <std::size_t N>
     constexpr basic_fstring& operator+=(const CharT (&rhs)[N]) noexcept {
-        return append(rhs, N);
+        return append(rhs, N - 1);
     }
 
     constexpr basic_fstring& operator+=(CharT ch) noexcept {
@@ -0,0 +1,632 @@
+#pragma once
+
+/**
+ * @file zuu/core/digest.hpp
+ * @brief CRC32C and SHA-256 of strings, with hex output
+ * @version 3.0.0
+ *
+ * Usage:
+ *   std::uint32_t c = zuu::crc32c(record);               // Castagnoli CRC
+ *   c = zuu::crc32c(more, c);                            // continues the same stream
+ *   zuu::fstring<8> tag = zuu::hex_digest(c);            // "e3069283"
+ *
+ *   zuu::sha256_digest d = zuu::sha256(record);          // 32 bytes
+ *   zuu::fstring<64> id = zuu::sha256_hex(record);
+ *
+ *   zuu::sha256_state st;                                // incremental
+ *   st.update(header); st.update(body);
+ *   auto whole = st.finish();
+ *
+ *   // Many short records: several messages in flight at once
+ *   std::vector<zuu::sha256_digest> out(keys.size());
+ *   zuu::sha256_batch(keys, std::span{out});
+ *
+ * Both digests are constexpr; constant evaluation takes the scalar path
+ * and agrees with run time. Code units are digested by their
+ * little-endian byte image, as in hash.hpp.
+ *
+ * CRC32C uses the SSE4.2 crc32 instruction when the build targets it
+ * (-msse4.2 or -march=...), and slicing-by-8 tables otherwise. Long
+ * inputs run three independent crc32 streams over adjacent blocks, which
+ * hides the instruction's latency; the streams are joined with
+ * precomputed shift tables. SHA-256 uses the SHA extensions when the
+ * build targets them (-msha -msse4.1). ZUU_NO_SIMD turns both off.
+ *
+ * sha256_batch interleaves four messages in the lanes of SSE2 registers
+ * when the SHA extensions are not available. With the SHA instructions,
+ * two interleaved messages measured no faster than one, so messages are
+ * digested one after another. crc32c_batch digests records one at a
+ * time: interleaving three short records of uneven length measured
+ * slower than a plain loop, the per-record tails costing more in branch
+ * misses than the overlapped crc32 latency saved.
+ */
+
+#include "core.hpp"
+#include "simd.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#if !defined(ZUU_NO_SIMD) && defined(__SSE4_2__) && (defined(__x86_64__) || defined(_M_X64))
+    #define ZUU_SIMD_CRC32C 1
+    #include <nmmintrin.h>
+#endif
+
+#if !defined(ZUU_NO_SIMD) && defined(__SHA__) && defined(__SSE4_1__)
+    #define ZUU_SIMD_SHA 1
+    #include <immintrin.h>
+#endif
+
+namespace zuu {
+
+using sha256_digest = std::array<std::uint8_t, 32>;
+
+namespace detail {
+
+// ==================== Byte Access ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint8_t code_unit_byte(const CharT* p, std::size_t i) noexcept {
+    using unit_t = std::make_unsigned_t<CharT>;
+    return static_cast<std::uint8_t>(static_cast<unit_t>(p[i / sizeof(CharT)]) >> (8 * (i % sizeof(CharT))));
+}
+
+// Run time only: the byte image of code units, when it is their memory layout
+template <meta::character CharT>
+[[nodiscard]] inline const unsigned char* byte_image(const CharT* p) noexcept {
+    return reinterpret_cast<const unsigned char*>(p);
+}
+
+inline constexpr bool native_byte_image = std::endian::native == std::endian::little;
+
+[[nodiscard]] inline std::uint64_t load_le64(const unsigned char* p) noexcept {
+    std::uint64_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+[[nodiscard]] constexpr std::uint32_t load_be32(const unsigned char* p) noexcept {
+    return (std::uint32_t{p[0]} << 24) | (std::uint32_t{p[1]} << 16) | (std::uint32_t{p[2]} << 8) | p[3];
+}
+
+// ==================== CRC32C Tables ====================
+
+inline constexpr std::uint32_t crc32c_poly = 0x82F63B78u;   // reflected Castagnoli
+
+// Slicing-by-8: table k advances a byte that is followed by k more
+inline constexpr auto crc32c_tables = [] {
+    std::array<std::array<std::uint32_t, 256>, 8> t{};
+    for (std::uint32_t b = 0; b < 256; ++b) {
+        std::uint32_t c = b;
+        for (int k = 0; k < 8; ++k) c = (c >> 1) ^ (crc32c_poly & (0u - (c & 1)));
+        t[0][b] = c;
+    }
+    for (std::size_t k = 1; k < 8; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) t[k][b] = (t[k - 1][b] >> 8) ^ t[0][t[k - 1][b] & 0xff];
+    }
+    return t;
+}();
+
+/**
+ * Tables for appending Len zero bytes to a CRC state: the map is linear,
+ * so it is the XOR of one table entry per state byte. Joins a stream's
+ * CRC with the one of the Len bytes that follow it.
+ */
+template <std::size_t Len>
+inline constexpr auto crc32c_shift_tables = [] {
+    std::array<std::uint32_t, 32> basis{};
+    for (std::size_t bit = 0; bit < 32; ++bit) {
+        std::uint32_t v = std::uint32_t{1} << bit;
+        for (std::size_t i = 0; i < Len; ++i) v = crc32c_tables[0][v & 0xff] ^ (v >> 8);
+        basis[bit] = v;
+    }
+    std::array<std::array<std::uint32_t, 256>, 4> t{};
+    for (std::size_t k = 0; k < 4; ++k) {
+        for (std::size_t b = 0; b < 256; ++b) {
+            std::uint32_t v = 0;
+            for (std::size_t j = 0; j < 8; ++j) {
+                if ((b >> j) & 1) v ^= basis[8 * k + j];
+            }
+            t[k][b] = v;
+        }
+    }
+    return t;
+}();
+
+template <std::size_t Len>
+[[nodiscard]] inline std::uint32_t crc32c_shift(std::uint32_t s) noexcept {
+    const auto& t = crc32c_shift_tables<Len>;
+    return t[0][s & 0xff] ^ t[1][(s >> 8) & 0xff] ^ t[2][(s >> 16) & 0xff] ^ t[3][s >> 24];
+}
+
+// ==================== CRC32C Kernels ====================
+
+// Raw state update (no pre/post inversion), scalar
+[[nodiscard]] inline std::uint32_t crc32c_update_sw(std::uint32_t s, const unsigned char* p, std::size_t n) noexcept {
+    const auto& t = crc32c_tables;
+    if constexpr (native_byte_image) {
+        for (; n >= 8; p += 8, n -= 8) {
+            const std::uint64_t w = load_le64(p) ^ s;
+            s = t[7][w & 0xff] ^ t[6][(w >> 8) & 0xff] ^ t[5][(w >> 16) & 0xff] ^ t[4][(w >> 24) & 0xff] ^
+                t[3][(w >> 32) & 0xff] ^ t[2][(w >> 40) & 0xff] ^ t[1][(w >> 48) & 0xff] ^ t[0][w >> 56];
+        }
+    }
+    for (; n > 0; ++p, --n) s = t[0][(s ^ *p) & 0xff] ^ (s >> 8);
+    return s;
+}
+
+#if defined(ZUU_SIMD_CRC32C)
+
+// Three streams over [p, p + 3 * Len) joined into one state
+template <std::size_t Len>
+[[nodiscard]] inline std::uint32_t crc32c_3way(std::uint32_t s, const unsigned char* p) noexcept {
+    std::uint64_t a = s, b = 0, c = 0;
+    for (std::size_t i = 0; i < Len; i += 8) {
+        a = _mm_crc32_u64(a, load_le64(p + i));
+        b = _mm_crc32_u64(b, load_le64(p + Len + i));
+        c = _mm_crc32_u64(c, load_le64(p + 2 * Len + i));
+    }
+    return crc32c_shift<Len>(crc32c_shift<Len>(static_cast<std::uint32_t>(a)) ^ static_cast<std::uint32_t>(b)) ^
+           static_cast<std::uint32_t>(c);
+}
+
+[[nodiscard]] inline std::uint32_t crc32c_update_hw(std::uint32_t s, const unsigned char* p, std::size_t n) noexcept {
+    for (; n >= 3 * 1024; p += 3 * 1024, n -= 3 * 1024) s = crc32c_3way<1024>(s, p);
+    for (; n >= 3 * 128; p += 3 * 128, n -= 3 * 128) s = crc32c_3way<128>(s, p);
+    std::uint64_t s64 = s;
+    for (; n >= 8; p += 8, n -= 8) s64 = _mm_crc32_u64(s64, load_le64(p));
+    s = static_cast<std::uint32_t>(s64);
+    if (n & 4) {
+        std::uint32_t w;
+        std::memcpy(&w, p, 4);
+        s = _mm_crc32_u32(s, w);
+        p += 4;
+    }
+    if (n & 2) {
+        std::uint16_t w;
+        std::memcpy(&w, p, 2);
+        s = _mm_crc32_u16(s, w);
+        p += 2;
+    }
+    if (n & 1) s = _mm_crc32_u8(s, *p);
+    return s;
+}
+
+#endif
+
+[[nodiscard]] inline std::uint32_t crc32c_update(std::uint32_t s, const unsigned char* p, std::size_t n) noexcept {
+#if defined(ZUU_SIMD_CRC32C)
+    return crc32c_update_hw(s, p, n);
+#else
+    return crc32c_update_sw(s, p, n);
+#endif
+}
+
+// ==================== SHA-256 Kernels ====================
+
+inline constexpr std::uint32_t sha256_k[64] = {
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+inline constexpr std::uint32_t sha256_init[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+constexpr void sha256_blocks_sw(std::uint32_t* state, const unsigned char* p, std::size_t blocks) noexcept {
+    for (; blocks > 0; --blocks, p += 64) {
+        std::uint32_t w[64];
+        for (std::size_t t = 0; t < 16; ++t) w[t] = load_be32(p + 4 * t);
+        for (std::size_t t = 16; t < 64; ++t) {
+            const std::uint32_t s0 = std::rotr(w[t - 15], 7) ^ std::rotr(w[t - 15], 18) ^ (w[t - 15] >> 3);
+            const std::uint32_t s1 = std::rotr(w[t - 2], 17) ^ std::rotr(w[t - 2], 19) ^ (w[t - 2] >> 10);
+            w[t] = w[t - 16] + s0 + w[t - 7] + s1;
+        }
+
+        std::uint32_t a = state[0], b = state[1], c = state[2], d = state[3];
+        std::uint32_t e = state[4], f = state[5], g = state[6], h = state[7];
+        for (std::size_t t = 0; t < 64; ++t) {
+            const std::uint32_t t1 = h + (std::rotr(e, 6) ^ std::rotr(e, 11) ^ std::rotr(e, 25)) +
+                                     ((e & f) ^ (~e & g)) + sha256_k[t] + w[t];
+            const std::uint32_t t2 = (std::rotr(a, 2) ^ std::rotr(a, 13) ^ std::rotr(a, 22)) +
+                                     ((a & b) ^ (a & c) ^ (b & c));
+            h = g; g = f; f = e; e = d + t1;
+            d = c; c = b; b = a; a = t1 + t2;
+        }
+        state[0] += a; state[1] += b; state[2] += c; state[3] += d;
+        state[4] += e; state[5] += f; state[6] += g; state[7] += h;
+    }
+}
+
+#if defined(ZUU_SIMD_SHA)
+
+// State kept as ABEF / CDGH, the layout sha256rnds2 works on
+inline void sha256_blocks_ni(std::uint32_t* state, const unsigned char* data, std::size_t blocks) noexcept {
+#if defined(__AVX__)
+    _mm256_zeroupper();   // sha256* have no VEX form; dirty upper halves stall them
+#endif
+    const __m128i bswap = _mm_set_epi64x(0x0c0d0e0f08090a0bll, 0x0405060700010203ll);
+    const __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state)), 0xB1);
+    const __m128i hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(state + 4)), 0x1B);
+    __m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+    __m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        const __m128i save0 = abef;
+        const __m128i save1 = cdgh;
+        __m128i m[4];
+        // Four rounds per group; groups are unrolled so the schedule stays in registers
+        const auto group = [&]<std::size_t G>(std::integral_constant<std::size_t, G>) {
+            __m128i& cur = m[G % 4];
+            if constexpr (G < 4) {
+                cur = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * G)), bswap);
+            }
+            __m128i msg = _mm_add_epi32(cur, _mm_loadu_si128(reinterpret_cast<const __m128i*>(sha256_k + 4 * G)));
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, msg);
+            if constexpr (G >= 3 && G < 15) {
+                __m128i& next = m[(G + 1) % 4];
+                next = _mm_add_epi32(next, _mm_alignr_epi8(cur, m[(G + 3) % 4], 4));
+                next = _mm_sha256msg2_epu32(next, cur);
+            }
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, msg);
+            if constexpr (G >= 1 && G < 13) {
+                __m128i& prev = m[(G + 3) % 4];
+                prev = _mm_sha256msg1_epu32(prev, cur);
+            }
+        };
+        [&]<std::size_t... G>(std::index_sequence<G...>) {
+            (group(std::integral_constant<std::size_t, G>{}), ...);
+        }(std::make_index_sequence<16>{});
+        abef = _mm_add_epi32(abef, save0);
+        cdgh = _mm_add_epi32(cdgh, save1);
+    }
+
+    const __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    const __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state + 4), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+#elif defined(ZUU_SIMD_SSE2)
+
+// Four messages in the 32-bit lanes of SSE2 registers, one block each
+inline void sha256_blocks_x4(std::uint32_t* const* state, const unsigned char* const* data) noexcept {
+    const auto rotr = [](__m128i x, int n) {
+        return _mm_or_si128(_mm_srli_epi32(x, n), _mm_slli_epi32(x, 32 - n));
+    };
+    const auto word = [&](std::size_t t) {
+        return _mm_set_epi32(static_cast<int>(load_be32(data[3] + 4 * t)), static_cast<int>(load_be32(data[2] + 4 * t)),
+                             static_cast<int>(load_be32(data[1] + 4 * t)), static_cast<int>(load_be32(data[0] + 4 * t)));
+    };
+
+    __m128i v[8];
+    for (std::size_t i = 0; i < 8; ++i) {
+        v[i] = _mm_set_epi32(static_cast<int>(state[3][i]), static_cast<int>(state[2][i]),
+                             static_cast<int>(state[1][i]), static_cast<int>(state[0][i]));
+    }
+    __m128i a = v[0], b = v[1], c = v[2], d = v[3], e = v[4], f = v[5], g = v[6], h = v[7];
+    __m128i w[16];
+    for (std::size_t t = 0; t < 64; ++t) {
+        if (t < 16) {
+            w[t] = word(t);
+        } else {
+            const __m128i w15 = w[(t - 15) % 16];
+            const __m128i w2 = w[(t - 2) % 16];
+            const __m128i s0 = _mm_xor_si128(_mm_xor_si128(rotr(w15, 7), rotr(w15, 18)), _mm_srli_epi32(w15, 3));
+            const __m128i s1 = _mm_xor_si128(_mm_xor_si128(rotr(w2, 17), rotr(w2, 19)), _mm_srli_epi32(w2, 10));
+            w[t % 16] = _mm_add_epi32(_mm_add_epi32(w[t % 16], s0), _mm_add_epi32(w[(t - 7) % 16], s1));
+        }
+        const __m128i big_e = _mm_xor_si128(_mm_xor_si128(rotr(e, 6), rotr(e, 11)), rotr(e, 25));
+        const __m128i ch = _mm_xor_si128(_mm_and_si128(e, f), _mm_andnot_si128(e, g));
+        const __m128i t1 = _mm_add_epi32(_mm_add_epi32(h, big_e),
+                                         _mm_add_epi32(ch, _mm_add_epi32(_mm_set1_epi32(static_cast<int>(sha256_k[t])), w[t % 16])));
+        const __m128i big_a = _mm_xor_si128(_mm_xor_si128(rotr(a, 2), rotr(a, 13)), rotr(a, 22));
+        const __m128i maj = _mm_xor_si128(_mm_and_si128(a, b), _mm_and_si128(c, _mm_xor_si128(a, b)));
+        const __m128i t2 = _mm_add_epi32(big_a, maj);
+        h = g; g = f; f = e; e = _mm_add_epi32(d, t1);
+        d = c; c = b; b = a; a = _mm_add_epi32(t1, t2);
+    }
+    const __m128i out[8] = {a, b, c, d, e, f, g, h};
+    for (std::size_t i = 0; i < 8; ++i) {
+        alignas(16) std::uint32_t lanes[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(lanes), _mm_add_epi32(v[i], out[i]));
+        for (std::size_t l = 0; l < 4; ++l) state[l][i] = lanes[l];
+    }
+}
+
+#endif
+
+constexpr void sha256_blocks(std::uint32_t* state, const unsigned char* p, std::size_t blocks) noexcept {
+#if defined(ZUU_SIMD_SHA)
+    if (!std::is_constant_evaluated()) {
+        sha256_blocks_ni(state, p, blocks);
+        return;
+    }
+#endif
+    sha256_blocks_sw(state, p, blocks);
+}
+
+// Last one or two blocks of a message: its tail, 0x80, zeros, bit length
+constexpr std::size_t sha256_pad(unsigned char* out, const unsigned char* tail, std::size_t tail_len,
+                                 std::uint64_t total) noexcept {
+    const std::size_t blocks = tail_len + 9 <= 64 ? 1 : 2;
+    for (std::size_t i = 0; i < 64 * blocks; ++i) out[i] = 0;
+    for (std::size_t i = 0; i < tail_len; ++i) out[i] = tail[i];
+    out[tail_len] = 0x80;
+    const std::uint64_t bits = total * 8;
+    for (std::size_t i = 0; i < 8; ++i) out[64 * blocks - 1 - i] = static_cast<unsigned char>(bits >> (8 * i));
+    return blocks;
+}
+
+constexpr sha256_digest sha256_output(const std::uint32_t* state) noexcept {
+    sha256_digest d{};
+    for (std::size_t i = 0; i < 32; ++i) d[i] = static_cast<std::uint8_t>(state[i / 4] >> (24 - 8 * (i % 4)));
+    return d;
+}
+
+// ==================== Hex ====================
+
+constexpr void hex_encode(const std::uint8_t* in, std::size_t n, char* out) noexcept {
+#if defined(ZUU_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        const __m128i nibble = _mm_set1_epi8(0x0f);
+        const auto ascii = [](__m128i x) {   // 0..15 -> '0'..'9', 'a'..'f'
+            const __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(x, _mm_set1_epi8(9)), _mm_set1_epi8('a' - '0' - 10));
+            return _mm_add_epi8(x, _mm_add_epi8(_mm_set1_epi8('0'), letters));
+        };
+        for (; n >= 16; in += 16, out += 32, n -= 16) {
+            const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in));
+            const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+            const __m128i lo = _mm_and_si128(v, nibble);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), ascii(_mm_unpacklo_epi8(hi, lo)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), ascii(_mm_unpackhi_epi8(hi, lo)));
+        }
+    }
+#endif
+    constexpr char digits[] = "0123456789abcdef";
+    for (std::size_t i = 0; i < n; ++i) {
+        out[2 * i] = digits[in[i] >> 4];
+        out[2 * i + 1] = digits[in[i] & 0x0f];
+    }
+}
+
+} // namespace detail
+
+// ==================== CRC32C ====================
+
+/// CRC32C of the byte image of [p, p + n); pass a previous result to continue it
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint32_t crc32c_chars(const CharT* p, std::size_t n, std::uint32_t crc = 0) noexcept {
+    std::uint32_t s = ~crc;
+    const std::size_t bytes = n * sizeof(CharT);
+    if (std::is_constant_evaluated() || !detail::native_byte_image) {
+        for (std::size_t i = 0; i < bytes; ++i) {
+            s = detail::crc32c_tables[0][(s ^ detail::code_unit_byte(p, i)) & 0xff] ^ (s >> 8);
+        }
+    } else if (bytes > 0) {
+        s = detail::crc32c_update(s, detail::byte_image(p), bytes);
+    }
+    return ~s;
+}
+
+struct crc32c_fn {
+    template <meta::char_range R>
+    [[nodiscard]] constexpr std::uint32_t operator()(const R& text, std::uint32_t crc = 0) const noexcept {
+        const auto sv = meta::as_view(text);
+        return crc32c_chars(sv.data(), sv.size(), crc);
+    }
+
+    template <meta::character CharT, std::size_t N>
+    [[nodiscard]] constexpr std::uint32_t operator()(const CharT (&str)[N], std::uint32_t crc = 0) const noexcept {
+        return crc32c_chars(str, N - 1, crc);
+    }
+};
+
+inline constexpr crc32c_fn crc32c;
+
+// ==================== SHA-256 ====================
+
+/// Incremental SHA-256: update() any number of times, then finish() once
+class sha256_state {
+public:
+    template <meta::character CharT>
+    constexpr sha256_state& update(const CharT* p, std::size_t n) noexcept {
+        const std::size_t bytes = n * sizeof(CharT);
+        total_ += bytes;
+        std::size_t i = 0;
+        if (!std::is_constant_evaluated() && detail::native_byte_image) {
+            const unsigned char* src = detail::byte_image(p);
+            if (fill_ > 0) {
+                i = std::min(bytes, 64 - fill_);
+                std::memcpy(buf_ + fill_, src, i);
+                fill_ += i;
+                if (fill_ < 64) return *this;
+                detail::sha256_blocks(h_, buf_, 1);
+                fill_ = 0;
+            }
+            const std::size_t blocks = (bytes - i) / 64;
+            if (blocks > 0) detail::sha256_blocks(h_, src + i, blocks);
+            i += blocks * 64;
+            fill_ = bytes - i;
+            if (fill_ > 0) std::memcpy(buf_, src + i, fill_);
+            return *this;
+        }
+        for (; i < bytes; ++i) {
+            buf_[fill_++] = detail::code_unit_byte(p, i);
+            if (fill_ == 64) {
+                detail::sha256_blocks(h_, buf_, 1);
+                fill_ = 0;
+            }
+        }
+        return *this;
+    }
+
+    template <meta::char_range R>
+    constexpr sha256_state& update(const R& text) noexcept {
+        const auto sv = meta::as_view(text);
+        return update(sv.data(), sv.size());
+    }
+
+    [[nodiscard]] constexpr sha256_digest finish() noexcept {
+        unsigned char last[128]{};
+        const std::size_t blocks = detail::sha256_pad(last, buf_, fill_, total_);
+        detail::sha256_blocks(h_, last, blocks);
+        return detail::sha256_output(h_);
+    }
+
+private:
+    std::uint32_t h_[8] = {
+        detail::sha256_init[0], detail::sha256_init[1], detail::sha256_init[2], detail::sha256_init[3],
+        detail::sha256_init[4], detail::sha256_init[5], detail::sha256_init[6], detail::sha256_init[7],
+    };
+    unsigned char buf_[64]{};
+    std::size_t fill_ = 0;
+    std::uint64_t total_ = 0;
+};
+
+template <meta::character CharT>
+[[nodiscard]] constexpr sha256_digest sha256_chars(const CharT* p, std::size_t n) noexcept {
+    return sha256_state{}.update(p, n).finish();
+}
+
+struct sha256_fn {
+    template <meta::char_range R>
+    [[nodiscard]] constexpr sha256_digest operator()(const R& text) const noexcept {
+        const auto sv = meta::as_view(text);
+        return sha256_chars(sv.data(), sv.size());
+    }
+
+    template <meta::character CharT, std::size_t N>
+    [[nodiscard]] constexpr sha256_digest operator()(const CharT (&str)[N]) const noexcept {
+        return sha256_chars(str, N - 1);
+    }
+};
+
+inline constexpr sha256_fn sha256;
+
+// ==================== Hex Output ====================
+
+/// Lowercase hex of a digest's bytes, in order
+template <std::size_t N>
+[[nodiscard]] constexpr basic_fstring<char, 2 * N> hex_digest(const std::array<std::uint8_t, N>& digest) noexcept {
+    char buf[2 * N];
+    detail::hex_encode(digest.data(), N, buf);
+    basic_fstring<char, 2 * N> result;
+    result.append(buf, 2 * N);
+    return result;
+}
+
+/// Lowercase hex of a CRC, most significant byte first
+[[nodiscard]] constexpr basic_fstring<char, 8> hex_digest(std::uint32_t crc) noexcept {
+    return hex_digest(std::array<std::uint8_t, 4>{
+        static_cast<std::uint8_t>(crc >> 24), static_cast<std::uint8_t>(crc >> 16),
+        static_cast<std::uint8_t>(crc >> 8), static_cast<std::uint8_t>(crc)});
+}
+
+template <typename T>
+[[nodiscard]] constexpr basic_fstring<char, 64> sha256_hex(const T& text) noexcept {
+    return hex_digest(sha256(text));
+}
+
+template <typename T>
+[[nodiscard]] constexpr basic_fstring<char, 8> crc32c_hex(const T& text) noexcept {
+    return hex_digest(crc32c(text));
+}
+
+// ==================== Batches ====================
+
+/// out[i] = crc32c(texts[i]) for every i < min(sizes)
+template <std::ranges::random_access_range R>
+requires std::ranges::sized_range<R> && meta::char_range<std::ranges::range_value_t<R>>
+void crc32c_batch(const R& texts, std::span<std::uint32_t> out) noexcept {
+    const std::size_t n = std::min<std::size_t>(std::ranges::size(texts), out.size());
+    auto first = std::ranges::begin(texts);
+    for (std::size_t i = 0; i < n; ++i) out[i] = crc32c(first[static_cast<std::ptrdiff_t>(i)]);
+}
+
+/// out[i] = sha256(texts[i]) for every i < min(sizes)
+template <std::ranges::random_access_range R>
+requires std::ranges::sized_range<R> && meta::char_range<std::ranges::range_value_t<R>>
+void sha256_batch(const R& texts, std::span<sha256_digest> out) noexcept {
+    const std::size_t n = std::min<std::size_t>(std::ranges::size(texts), out.size());
+    auto first = std::ranges::begin(texts);
+    std::size_t next = 0;
+
+#if defined(ZUU_SIMD_SSE2) && !defined(ZUU_SIMD_SHA)
+    constexpr std::size_t width = 4;
+
+    // One message per lane, walked a block at a time
+    struct lane {
+        std::uint32_t h[8];
+        const unsigned char* data;
+        std::size_t full;          // blocks read from the message itself
+        std::size_t blocks;        // including the padded tail
+        std::size_t at;
+        std::size_t index;
+        unsigned char tail[128];
+
+        [[nodiscard]] const unsigned char* block() const noexcept {
+            return at < full ? data + 64 * at : tail + 64 * (at - full);
+        }
+    };
+    lane lanes[width];
+    const auto load = [&](lane& l) {
+        const auto sv = meta::as_view(first[static_cast<std::ptrdiff_t>(next)]);
+        using char_type = typename decltype(sv)::value_type;
+        const std::size_t len = sv.size() * sizeof(char_type);
+        std::copy(std::begin(detail::sha256_init), std::end(detail::sha256_init), l.h);
+        l.data = detail::byte_image(sv.data());
+        l.full = len / 64;
+        l.blocks = l.full + detail::sha256_pad(l.tail, l.data + 64 * l.full, len % 64, len);
+        l.at = 0;
+        l.index = next++;
+    };
+
+    if (n >= width) {
+        for (lane& l : lanes) load(l);
+        std::size_t active = width;
+        while (active == width) {
+            std::uint32_t* states[width];
+            const unsigned char* blocks[width];
+            for (std::size_t i = 0; i < width; ++i) {
+                states[i] = lanes[i].h;
+                blocks[i] = lanes[i].block();
+            }
+            detail::sha256_blocks_x4(states, blocks);
+            for (lane& l : lanes) {
+                if (++l.at < l.blocks) continue;
+                out[l.index] = detail::sha256_output(l.h);
+                if (next < n) {
+                    load(l);
+                } else {
+                    l.index = n;
+                    --active;
+                }
+            }
+        }
+        // Lanes still holding a message finish on their own
+        for (lane& l : lanes) {
+            if (l.index >= n) continue;
+            for (; l.at < l.blocks; ++l.at) detail::sha256_blocks(l.h, l.block(), 1);
+            out[l.index] = detail::sha256_output(l.h);
+        }
+    }
+#endif
+
+    for (; next < n; ++next) out[next] = sha256(first[static_cast<std::ptrdiff_t>(next)]);
+}
+
+} // namespace zuu
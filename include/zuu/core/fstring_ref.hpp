@@ -0,0 +1,300 @@
+#pragma once
+
+/**
+ * @file zuu/core/fstring_ref.hpp
+ * @brief Non-owning fixed-capacity string over an external buffer
+ * @version 3.0.0
+ *
+ * Usage:
+ *   // A slot inside a packet, with its length kept next to it
+ *   struct record { char name[48]; std::size_t name_len; } rec;
+ *   zuu::fstring_ref name(rec.name, rec.name_len);
+ *   name.append("user-", 5);
+ *   name += zuu::fmt::to_fstring(42);               // rec.name_len == 7
+ *   auto upper = name | zuu::str::to_upper;         // algorithms and pipes
+ *
+ *   // Any basic_fstring, whatever its capacity
+ *   void fill(zuu::fstring_ref<char> out);
+ *   zuu::fstring<64> a;  zuu::fstring<4096> b;
+ *   fill(a);  fill(b);
+ *
+ * The handle is a pointer, a capacity and a pointer to the length; the
+ * characters and the length live in caller-owned memory, so every
+ * mutation is seen by whoever owns them. A ref to a basic_fstring edits
+ * it in place and keeps its null terminator. A ref to a raw buffer uses
+ * all of it and writes no terminator, so data() is not a C string.
+ * Mutations truncate at capacity like basic_fstring. Copying the handle
+ * copies the reference, not the text.
+ */
+
+#include "core.hpp"
+#include <algorithm>
+#include <compare>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+namespace zuu {
+
+template <meta::character CharT = char>
+class fstring_ref {
+public:
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using pointer = CharT*;
+    using const_pointer = const CharT*;
+    using reference = CharT&;
+    using const_reference = const CharT&;
+    using iterator = CharT*;
+    using const_iterator = const CharT*;
+
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    CharT* data_;
+    size_type* size_;
+    size_type cap_;
+    bool terminated_;
+
+    constexpr void set_null_terminator() noexcept {
+        if (terminated_) data_[*size_] = CharT{};
+    }
+
+public:
+    // ==================== Construction ====================
+
+    // Edits `str` in place
+    template <std::size_t Cap>
+    constexpr fstring_ref(basic_fstring<CharT, Cap>& str) noexcept
+        : data_(str.data_), size_(&str.size_), cap_(Cap), terminated_(true) {}
+
+    /// `capacity` characters at `buf`; the current length is `size` (clamped)
+    constexpr fstring_ref(CharT* buf, size_type capacity, size_type& size) noexcept
+        : data_(buf), size_(&size), cap_(capacity), terminated_(false) {
+        size = std::min(size, capacity);
+    }
+
+    template <std::size_t N>
+    constexpr fstring_ref(CharT (&buf)[N], size_type& size) noexcept : fstring_ref(buf, N, size) {}
+
+    constexpr fstring_ref(std::span<CharT> buf, size_type& size) noexcept : fstring_ref(buf.data(), buf.size(), size) {}
+
+    // ==================== Capacity ====================
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return *size_ == 0; }
+    [[nodiscard]] constexpr size_type size() const noexcept { return *size_; }
+    [[nodiscard]] constexpr size_type length() const noexcept { return *size_; }
+    [[nodiscard]] constexpr size_type capacity() const noexcept { return cap_; }
+    [[nodiscard]] constexpr size_type max_size() const noexcept { return cap_; }
+    [[nodiscard]] constexpr size_type available() const noexcept { return cap_ - *size_; }
+    [[nodiscard]] constexpr bool full() const noexcept { return *size_ == cap_; }
+
+    // ==================== Element Access ====================
+
+    [[nodiscard]] constexpr const_reference operator[](size_type pos) const noexcept { return data_[pos]; }
+    [[nodiscard]] constexpr reference operator[](size_type pos) noexcept { return data_[pos]; }
+
+    [[nodiscard]] constexpr const_reference at(size_type pos) const {
+        if (pos >= *size_) throw std::out_of_range("fstring_ref::at");
+        return data_[pos];
+    }
+
+    [[nodiscard]] constexpr reference at(size_type pos) {
+        if (pos >= *size_) throw std::out_of_range("fstring_ref::at");
+        return data_[pos];
+    }
+
+    [[nodiscard]] constexpr reference front() noexcept { return data_[0]; }
+    [[nodiscard]] constexpr const_reference front() const noexcept { return data_[0]; }
+    [[nodiscard]] constexpr reference back() noexcept { return data_[*size_ - 1]; }
+    [[nodiscard]] constexpr const_reference back() const noexcept { return data_[*size_ - 1]; }
+
+    [[nodiscard]] constexpr pointer data() noexcept { return data_; }
+    [[nodiscard]] constexpr const_pointer data() const noexcept { return data_; }
+
+    // ==================== Iterators ====================
+
+    [[nodiscard]] constexpr iterator begin() noexcept { return data_; }
+    [[nodiscard]] constexpr const_iterator begin() const noexcept { return data_; }
+    [[nodiscard]] constexpr const_iterator cbegin() const noexcept { return data_; }
+
+    [[nodiscard]] constexpr iterator end() noexcept { return data_ + *size_; }
+    [[nodiscard]] constexpr const_iterator end() const noexcept { return data_ + *size_; }
+    [[nodiscard]] constexpr const_iterator cend() const noexcept { return data_ + *size_; }
+
+    // ==================== Modifiers ====================
+
+    constexpr void clear() noexcept {
+        *size_ = 0;
+        set_null_terminator();
+    }
+
+    constexpr void push_back(CharT ch) noexcept {
+        if (!full()) {
+            data_[(*size_)++] = ch;
+            set_null_terminator();
+        }
+    }
+
+    constexpr void pop_back() noexcept {
+        if (*size_ > 0) {
+            --*size_;
+            set_null_terminator();
+        }
+    }
+
+    constexpr void resize(size_type new_size, CharT ch = CharT{}) noexcept {
+        new_size = std::min(new_size, cap_);
+        if (new_size > *size_) std::fill(data_ + *size_, data_ + new_size, ch);
+        *size_ = new_size;
+        set_null_terminator();
+    }
+
+    // `str` may point into this string
+    constexpr fstring_ref& append(const_pointer str, size_type len) noexcept {
+        if (str && !full()) {
+            len = std::min(len, available());
+            std::copy_n(str, len, data_ + *size_);
+            *size_ += len;
+            set_null_terminator();
+        }
+        return *this;
+    }
+
+    constexpr fstring_ref& append(CharT ch) noexcept {
+        push_back(ch);
+        return *this;
+    }
+
+    constexpr fstring_ref& append(size_type count, CharT ch) noexcept {
+        count = std::min(count, available());
+        std::fill_n(data_ + *size_, count, ch);
+        *size_ += count;
+        set_null_terminator();
+        return *this;
+    }
+
+    // ==================== Search Operations ====================
+
+    [[nodiscard]] constexpr size_type find(CharT ch, size_type pos = 0) const noexcept {
+        if (pos >= *size_) return npos;
+        const auto at = simd::find_char(data_ + pos, *size_ - pos, ch);
+        return at == simd::npos ? npos : pos + at;
+    }
+
+    [[nodiscard]] constexpr size_type find(const_pointer str, size_type pos = 0) const noexcept {
+        if (!str) return npos;
+        const size_type len = std::char_traits<CharT>::length(str);
+        if (len == 0) return pos;
+        if (pos + len > *size_) return npos;
+        const auto at = simd::find(data_ + pos, *size_ - pos, str, len);
+        return at == simd::npos ? npos : pos + at;
+    }
+
+    [[nodiscard]] constexpr size_type rfind(CharT ch, size_type pos = npos) const noexcept {
+        if (*size_ == 0) return npos;
+        const size_type search_end = (pos >= *size_) ? *size_ - 1 : pos;
+        const auto at = simd::rfind_char(data_, search_end + 1, ch);
+        return at == simd::npos ? npos : at;
+    }
+
+    [[nodiscard]] constexpr bool contains(CharT ch) const noexcept { return find(ch) != npos; }
+    [[nodiscard]] constexpr bool contains(const_pointer str) const noexcept { return find(str) != npos; }
+
+    [[nodiscard]] constexpr bool starts_with(CharT ch) const noexcept { return *size_ > 0 && data_[0] == ch; }
+
+    [[nodiscard]] constexpr bool starts_with(const_pointer str) const noexcept {
+        return str && std::basic_string_view<CharT>{*this}.starts_with(str);
+    }
+
+    [[nodiscard]] constexpr bool ends_with(CharT ch) const noexcept { return *size_ > 0 && data_[*size_ - 1] == ch; }
+
+    [[nodiscard]] constexpr bool ends_with(const_pointer str) const noexcept {
+        if (!str) return false;
+        const size_type len = std::char_traits<CharT>::length(str);
+        return len <= *size_ && simd::equal(data_ + *size_ - len, str, len);
+    }
+
+    // ==================== Substring ====================
+
+    template <std::size_t ResultCap>
+    [[nodiscard]] constexpr basic_fstring<CharT, ResultCap> substr(
+        size_type pos = 0,
+        size_type count = npos
+    ) const noexcept {
+        basic_fstring<CharT, ResultCap> result;
+        if (pos >= *size_) return result;
+        result.append(data_ + pos, std::min(count, *size_ - pos));
+        return result;
+    }
+
+    // ==================== Comparison ====================
+
+    // By contents; fstrings, other refs and views convert to the view
+    [[nodiscard]] constexpr bool operator==(std::basic_string_view<CharT> sv) const noexcept {
+        return *size_ == sv.size() && simd::equal(data_, sv.data(), *size_);
+    }
+
+    [[nodiscard]] constexpr std::strong_ordering operator<=>(std::basic_string_view<CharT> sv) const noexcept {
+        return simd::compare(data_, *size_, sv.data(), sv.size()) <=> 0;
+    }
+
+    template <size_type N>
+    [[nodiscard]] constexpr bool operator==(const CharT (&str)[N]) const noexcept {
+        size_type len = 0;
+        while (len < N && str[len] != CharT{}) ++len;
+        return *size_ == len && simd::equal(data_, str, len);
+    }
+
+    // ==================== Conversions ====================
+
+    [[nodiscard]] constexpr operator std::basic_string_view<CharT>() const noexcept { return {data_, *size_}; }
+
+    [[nodiscard]] constexpr std::basic_string<CharT> to_string() const { return {data_, *size_}; }
+
+    // ==================== Concatenation ====================
+
+    template <std::size_t N>
+    constexpr fstring_ref& operator+=(const basic_fstring<CharT, N>& rhs) noexcept {
+        return append(rhs.data(), rhs.size());
+    }
+
+    template <std::size_t N>
+    constexpr fstring_ref& operator+=(const CharT (&rhs)[N]) noexcept {
+        return append(rhs, N - 1);
+    }
+
+    constexpr fstring_ref& operator+=(std::basic_string_view<CharT> rhs) noexcept {
+        return append(rhs.data(), rhs.size());
+    }
+
+    constexpr fstring_ref& operator+=(CharT ch) noexcept { return append(ch); }
+};
+
+// ==================== Deduction Guides ====================
+
+template <meta::character CharT, std::size_t Cap>
+fstring_ref(basic_fstring<CharT, Cap>&) -> fstring_ref<CharT>;
+
+template <meta::character CharT>
+fstring_ref(CharT*, std::size_t, std::size_t&) -> fstring_ref<CharT>;
+
+template <meta::character CharT, std::size_t N>
+fstring_ref(CharT (&)[N], std::size_t&) -> fstring_ref<CharT>;
+
+// ==================== Stream Operators ====================
+
+template <meta::character CharT>
+std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const fstring_ref<CharT>& str) {
+    return os << std::basic_string_view<CharT>{str};
+}
+
+} // namespace zuu
+
+// Iterators point into the referenced buffer, not into the handle
+template <zuu::meta::character CharT>
+inline constexpr bool std::ranges::enable_borrowed_range<zuu::fstring_ref<CharT>> = true;
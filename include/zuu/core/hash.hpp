@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file zuu/core/hash.hpp
+ * @brief Fast 64-bit string hash (constexpr) and std::hash support
+ * @version 3.0.0
+ *
+ * A wyhash-style mixer reading 8/16-byte blocks. Code units are hashed
+ * by their little-endian byte image, so compile-time and run-time
+ * results agree and equal strings of any CharT hash identically to
+ * their byte content.
+ *
+ * Usage:
+ *   auto h = zuu::hash("key"_sfs);
+ *   std::unordered_map<zuu::fstring<32>, int> m;   // std::hash provided
+ */
+
+#include "core.hpp"
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace zuu {
+
+namespace detail {
+
+inline constexpr std::uint64_t hash_k0 = 0xa0761d6478bd642full;
+inline constexpr std::uint64_t hash_k1 = 0xe7037ed1a0b428dbull;
+inline constexpr std::uint64_t hash_k2 = 0x8ebc6af09c88c6e3ull;
+inline constexpr std::uint64_t hash_k3 = 0x589965cc75374cc3ull;
+
+// 64x64 -> 128 multiply, folded back into (a, b)
+constexpr void hash_mum(std::uint64_t& a, std::uint64_t& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+    __extension__ using u128 = unsigned __int128;
+    const u128 r = static_cast<u128>(a) * b;
+    a = static_cast<std::uint64_t>(r);
+    b = static_cast<std::uint64_t>(r >> 64);
+#else
+    const std::uint64_t ha = a >> 32, hb = b >> 32;
+    const std::uint64_t la = a & 0xffffffffull, lb = b & 0xffffffffull;
+    const std::uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    const std::uint64_t t = rl + (rm0 << 32);
+    std::uint64_t lo = t + (rm1 << 32);
+    std::uint64_t hi = rh + (rm0 >> 32) + (rm1 >> 32) + (t < rl) + (lo < t);
+    a = lo;
+    b = hi;
+#endif
+}
+
+constexpr std::uint64_t hash_mix(std::uint64_t a, std::uint64_t b) noexcept {
+    hash_mum(a, b);
+    return a ^ b;
+}
+
+// 'A'..'Z' -> 'a'..'z' in each byte of w; bytes >= 0x80 are left alone
+[[nodiscard]] constexpr std::uint64_t fold_ascii_bytes(std::uint64_t w) noexcept {
+    constexpr std::uint64_t ones = 0x0101010101010101ull;
+    const std::uint64_t low7 = w & (0x7f * ones);
+    const std::uint64_t ge_a = low7 + (0x80 - 'A') * ones;        // high bit: byte >= 'A'
+    const std::uint64_t gt_z = low7 + (0x80 - 'Z' - 1) * ones;    // high bit: byte > 'Z'
+    return w | (((ge_a ^ gt_z) & ~w & (0x80 * ones)) >> 2);
+}
+
+// Little-endian byte view over a run of code units; Fold lowercases
+// ASCII code units as they are read
+template <meta::character CharT, bool Fold = false>
+struct byte_reader {
+    const CharT* p;
+
+    [[nodiscard]] constexpr std::uint64_t byte(std::size_t i) const noexcept {
+        using unit_t = std::make_unsigned_t<CharT>;
+        std::uint64_t unit = static_cast<unit_t>(p[i / sizeof(CharT)]);
+        if constexpr (Fold) {
+            if (unit >= 'A' && unit <= 'Z') unit += 0x20;
+        }
+        if constexpr (sizeof(CharT) == 1) {
+            return unit;
+        } else {
+            return (unit >> (8 * (i % sizeof(CharT)))) & 0xff;
+        }
+    }
+
+    template <typename T>
+    [[nodiscard]] constexpr std::uint64_t load(std::size_t i) const noexcept {
+        if constexpr (std::endian::native == std::endian::little && (!Fold || sizeof(CharT) == 1)) {
+            if (!std::is_constant_evaluated()) {
+                T v;
+                std::memcpy(&v, reinterpret_cast<const unsigned char*>(p) + i, sizeof(T));
+                if constexpr (Fold) return fold_ascii_bytes(v);
+                return v;
+            }
+        }
+        std::uint64_t v = 0;
+        for (std::size_t k = 0; k < sizeof(T); ++k) v |= byte(i + k) << (8 * k);
+        return v;
+    }
+
+    [[nodiscard]] constexpr std::uint64_t r8(std::size_t i) const noexcept { return load<std::uint64_t>(i); }
+    [[nodiscard]] constexpr std::uint64_t r4(std::size_t i) const noexcept { return load<std::uint32_t>(i); }
+
+    [[nodiscard]] constexpr std::uint64_t r3(std::size_t i, std::size_t k) const noexcept {
+        return (byte(i) << 16) | (byte(i + (k >> 1)) << 8) | byte(i + k - 1);
+    }
+};
+
+// Seed as the block loop consumes it; hoisted out of per-key loops
+[[nodiscard]] constexpr std::uint64_t hash_seed(std::uint64_t seed) noexcept {
+    return seed ^ hash_mix(seed ^ hash_k0, hash_k1);
+}
+
+template <typename Reader>
+[[nodiscard]] constexpr std::uint64_t hash_bytes(
+    const Reader& in, std::size_t len, std::uint64_t seed   // seed from hash_seed()
+) noexcept {
+    std::uint64_t a = 0, b = 0;
+    std::size_t i = 0;
+
+    if (len <= 16) {
+        if (len >= 4) {
+            const std::size_t off = (len >> 3) << 2;
+            a = (in.r4(0) << 32) | in.r4(off);
+            b = (in.r4(len - 4) << 32) | in.r4(len - 4 - off);
+        } else if (len > 0) {
+            a = in.r3(0, len);
+        }
+    } else {
+        std::size_t left = len;
+        if (left > 48) {
+            std::uint64_t see1 = seed, see2 = seed;
+            do {
+                seed = hash_mix(in.r8(i) ^ hash_k1, in.r8(i + 8) ^ seed);
+                see1 = hash_mix(in.r8(i + 16) ^ hash_k2, in.r8(i + 24) ^ see1);
+                see2 = hash_mix(in.r8(i + 32) ^ hash_k3, in.r8(i + 40) ^ see2);
+                i += 48;
+                left -= 48;
+            } while (left > 48);
+            seed ^= see1 ^ see2;
+        }
+        while (left > 16) {
+            seed = hash_mix(in.r8(i) ^ hash_k1, in.r8(i + 8) ^ seed);
+            i += 16;
+            left -= 16;
+        }
+        a = in.r8(i + left - 16);
+        b = in.r8(i + left - 8);
+    }
+
+    a ^= hash_k1;
+    b ^= seed;
+    hash_mum(a, b);
+    return hash_mix(a ^ hash_k0 ^ len, b ^ hash_k1);
+}
+
+} // namespace detail
+
+// ==================== Raw Hash ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint64_t hash_chars(
+    const CharT* p, std::size_t n, std::uint64_t seed = 0
+) noexcept {
+    return detail::hash_bytes(detail::byte_reader<CharT>{p}, n * sizeof(CharT), detail::hash_seed(seed));
+}
+
+/// Same as hash_chars of the ASCII-lowercased text, without the copy
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint64_t hash_chars_ignore_case(
+    const CharT* p, std::size_t n, std::uint64_t seed = 0
+) noexcept {
+    return detail::hash_bytes(detail::byte_reader<CharT, true>{p}, n * sizeof(CharT), detail::hash_seed(seed));
+}
+
+// ==================== Hash Function Object ====================
+
+struct hash_fn {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::uint64_t operator()(
+        std::basic_string_view<CharT> sv, std::uint64_t seed = 0
+    ) const noexcept {
+        return hash_chars(sv.data(), sv.size(), seed);
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr std::uint64_t operator()(
+        const basic_fstring<CharT, Cap>& str, std::uint64_t seed = 0
+    ) const noexcept {
+        return hash_chars(str.data(), str.size(), seed);
+    }
+};
+
+inline constexpr hash_fn hash;
+
+} // namespace zuu
+
+// ==================== std::hash Support ====================
+
+template <zuu::meta::character CharT, std::size_t Cap>
+struct std::hash<zuu::basic_fstring<CharT, Cap>> {
+    [[nodiscard]] std::size_t operator()(const zuu::basic_fstring<CharT, Cap>& str) const noexcept {
+        return static_cast<std::size_t>(zuu::hash_chars(str.data(), str.size()));
+    }
+};
@@ -0,0 +1,280 @@
+#pragma once
+
+/**
+ * @file zuu/core/lit_pool.hpp
+ * @brief Deduplicated string literal ids and packed compile-time pools
+ * @version 3.0.0
+ *
+ * A `_fs` literal materializes a full `basic_fstring<CharT, 256>`
+ * constant at every use. Interned literals instead store their
+ * characters once per program: each distinct literal is a template
+ * parameter object, which the linker merges across translation units,
+ * plus a 16-byte entry. The id is one pointer to that entry, so ids
+ * compare and hash as integers and equal literals share one id in
+ * every TU.
+ *
+ * When the full set of strings is known up front, `pool<...>` packs
+ * them into one blob with an offset table. Its keys are the smallest
+ * unsigned integer enum that indexes the set.
+ *
+ * Usage:
+ *   using namespace zuu::literals;
+ *   lit::id m = "GET"_id;                 // or ZUU_LIT("GET")
+ *   m == "GET"_id;                        // pointer compare
+ *   std::string_view v = m;               // "GET"
+ *
+ *   using verbs = lit::pool<"GET", "PUT", "POST", "GET">;
+ *   constexpr auto k = verbs::key_of<"PUT">();   // 1 (one byte)
+ *   verbs::view(k);                              // "PUT"
+ *   verbs::find("POST");                         // std::optional<key>
+ */
+
+#include "../meta/concepts.hpp"
+#include <algorithm>
+#include <array>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <string_view>
+#include <type_traits>
+
+namespace zuu::lit {
+
+// ==================== Fixed String ====================
+
+/**
+ * @brief Literal wrapper usable as a template argument
+ * Holds the characters and terminator of a string literal by value.
+ */
+template <meta::character CharT, std::size_t N>
+struct fixed_string {
+    using char_type = CharT;
+
+    CharT chars[N]{};
+
+    constexpr fixed_string() noexcept = default;
+
+    constexpr fixed_string(const CharT (&str)[N]) noexcept {
+        for (std::size_t i = 0; i < N; ++i) chars[i] = str[i];
+    }
+
+    [[nodiscard]] static constexpr std::size_t size() noexcept { return N - 1; }
+
+    [[nodiscard]] constexpr std::basic_string_view<CharT> view() const noexcept {
+        return {chars, N - 1};
+    }
+};
+
+// ==================== Interned Id ====================
+
+template <meta::character CharT>
+struct entry {
+    const CharT* data;
+    std::size_t size;
+};
+
+namespace detail {
+
+// One entry per distinct literal; like the parameter object it points
+// into, it is emitted as a mergeable symbol in every TU that uses it
+template <fixed_string S>
+inline constexpr entry<typename decltype(S)::char_type> entry_for{S.chars, S.size()};
+
+} // namespace detail
+
+/**
+ * @brief Interned literal: one pointer, equal iff the literals are equal
+ * Default-constructed ids are the empty literal.
+ */
+template <meta::character CharT>
+class basic_id {
+public:
+    using char_type = CharT;
+    using view_type = std::basic_string_view<CharT>;
+
+    constexpr basic_id() noexcept : entry_(&detail::entry_for<fixed_string<CharT, 1>{}>) {}
+
+    template <fixed_string S>
+        requires std::same_as<typename decltype(S)::char_type, CharT>
+    [[nodiscard]] static constexpr basic_id of() noexcept {
+        return basic_id{&detail::entry_for<S>};
+    }
+
+    [[nodiscard]] constexpr view_type view() const noexcept { return {entry_->data, entry_->size}; }
+    [[nodiscard]] constexpr const CharT* data() const noexcept { return entry_->data; }
+    [[nodiscard]] constexpr const CharT* c_str() const noexcept { return entry_->data; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return entry_->size; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return entry_->size == 0; }
+
+    [[nodiscard]] constexpr operator view_type() const noexcept { return view(); }
+
+    /// Address-derived integer; stable for the lifetime of the process
+    [[nodiscard]] std::uintptr_t value() const noexcept {
+        return reinterpret_cast<std::uintptr_t>(entry_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(basic_id a, basic_id b) noexcept {
+        return a.entry_ == b.entry_;
+    }
+
+    // Address order: consistent within a process, not alphabetical
+    [[nodiscard]] friend constexpr std::strong_ordering operator<=>(basic_id a, basic_id b) noexcept {
+        return std::compare_three_way{}(a.entry_, b.entry_);
+    }
+
+private:
+    constexpr explicit basic_id(const entry<CharT>* e) noexcept : entry_(e) {}
+
+    const entry<CharT>* entry_;
+};
+
+using id = basic_id<char>;
+using wid = basic_id<wchar_t>;
+using u8id = basic_id<char8_t>;
+using u16id = basic_id<char16_t>;
+using u32id = basic_id<char32_t>;
+
+template <fixed_string S>
+inline constexpr auto intern = basic_id<typename decltype(S)::char_type>::template of<S>();
+
+// ==================== Packed Pool ====================
+
+/**
+ * @brief Distinct literals packed into one blob with an offset table
+ * Duplicates in the argument list share a key; each string is stored
+ * once, followed by a terminator.
+ */
+template <fixed_string First, fixed_string... Rest>
+class pool {
+public:
+    using char_type = typename decltype(First)::char_type;
+    using view_type = std::basic_string_view<char_type>;
+
+    static_assert((std::same_as<typename decltype(Rest)::char_type, char_type> && ...),
+                  "pool literals must share one character type");
+
+private:
+    static constexpr std::size_t args = 1 + sizeof...(Rest);
+
+    struct layout_t {
+        std::array<std::size_t, args> distinct{}; // argument index of each distinct literal
+        std::size_t count = 0;
+        std::size_t chars = 0;
+    };
+
+    static constexpr layout_t layout = [] {
+        const std::array<view_type, args> views{First.view(), Rest.view()...};
+        layout_t l{};
+        for (std::size_t i = 0; i < args; ++i) {
+            bool seen = false;
+            for (std::size_t k = 0; k < l.count && !seen; ++k) seen = views[l.distinct[k]] == views[i];
+            if (seen) continue;
+            l.distinct[l.count++] = i;
+            l.chars += views[i].size() + 1;
+        }
+        return l;
+    }();
+
+public:
+    using key_type = std::conditional_t<layout.count <= 0x100, std::uint8_t,
+                     std::conditional_t<layout.count <= 0x10000, std::uint16_t, std::uint32_t>>;
+
+    enum class key : key_type {};
+
+    static constexpr std::size_t count = layout.count;
+
+    /// Every distinct literal, NUL-separated, in first-seen order
+    static constexpr std::array<char_type, layout.chars> blob = [] {
+        const std::array<view_type, args> views{First.view(), Rest.view()...};
+        std::array<char_type, layout.chars> b{};
+        std::size_t pos = 0;
+        for (std::size_t k = 0; k < count; ++k) {
+            for (const char_type ch : views[layout.distinct[k]]) b[pos++] = ch;
+            b[pos++] = char_type{};
+        }
+        return b;
+    }();
+
+    static_assert(blob.size() <= std::numeric_limits<std::uint32_t>::max(), "pool blob too large");
+
+    /// offsets[k] is where literal k starts; offsets[count] is the blob end.
+    /// Taken from the literal sizes, so embedded NULs are kept.
+    static constexpr std::array<std::uint32_t, count + 1> offsets = [] {
+        const std::array<view_type, args> views{First.view(), Rest.view()...};
+        std::array<std::uint32_t, count + 1> o{};
+        for (std::size_t k = 0; k < count; ++k) {
+            o[k + 1] = static_cast<std::uint32_t>(o[k] + views[layout.distinct[k]].size() + 1);
+        }
+        return o;
+    }();
+
+    [[nodiscard]] static constexpr view_type view(key k) noexcept {
+        const auto i = static_cast<std::size_t>(k);
+        return {blob.data() + offsets[i], offsets[i + 1] - offsets[i] - 1};
+    }
+
+    [[nodiscard]] static constexpr const char_type* c_str(key k) noexcept {
+        return blob.data() + offsets[static_cast<std::size_t>(k)];
+    }
+
+    template <fixed_string S>
+    [[nodiscard]] static constexpr key key_of() noexcept {
+        constexpr auto k = find(S.view());
+        static_assert(k.has_value(), "literal is not in this pool");
+        return *k;
+    }
+
+    /// Key of `sv`, for interning parsed input; binary search by (size, chars)
+    [[nodiscard]] static constexpr std::optional<key> find(view_type sv) noexcept {
+        const auto it = std::lower_bound(sorted.begin(), sorted.end(), sv, [](key k, view_type v) {
+            return before(view(k), v);
+        });
+        if (it != sorted.end() && view(*it) == sv) return *it;
+        return std::nullopt;
+    }
+
+private:
+    static constexpr bool before(view_type a, view_type b) noexcept {
+        return a.size() != b.size() ? a.size() < b.size() : a < b;
+    }
+
+    static constexpr std::array<key, count> sorted = [] {
+        std::array<key, count> s{};
+        for (std::size_t k = 0; k < count; ++k) s[k] = static_cast<key>(k);
+        std::sort(s.begin(), s.end(), [](key a, key b) { return before(view(a), view(b)); });
+        return s;
+    }();
+};
+
+} // namespace zuu::lit
+
+// ==================== Literals ====================
+
+namespace zuu::inline literals::inline lit_literals {
+
+/**
+ * @brief Interned literal id
+ * Usage: auto m = "GET"_id;   // zuu::lit::id
+ */
+template <lit::fixed_string S>
+[[nodiscard]] constexpr auto operator""_id() noexcept {
+    return lit::intern<S>;
+}
+
+} // namespace zuu::inline literals::inline lit_literals
+
+/// Interned id of a string literal, without `using namespace zuu::literals`
+#define ZUU_LIT(str) (::zuu::lit::intern<str>)
+
+// ==================== Hash Support ====================
+
+template <zuu::meta::character CharT>
+struct std::hash<zuu::lit::basic_id<CharT>> {
+    [[nodiscard]] std::size_t operator()(zuu::lit::basic_id<CharT> i) const noexcept {
+        return std::hash<std::uintptr_t>{}(i.value());
+    }
+};
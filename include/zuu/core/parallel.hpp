@@ -0,0 +1,165 @@
+#pragma once
+
+/**
+ * @file zuu/core/parallel.hpp
+ * @brief Minimal fork-join helpers for the parallel algorithms
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::par::for_each_task(tasks, threads, [&](std::size_t task, std::size_t worker) {
+ *       ...  // `worker` < thread count, stable for the calling thread
+ *   });
+ *
+ *   // Threads started once and reused by every call
+ *   zuu::par::worker_pool pool(threads);
+ *   pool.for_each_task(tasks, [&](std::size_t task, std::size_t worker) { ... });
+ *
+ * Tasks are claimed dynamically, so uneven chunks balance themselves.
+ * With one thread (or one task) everything runs on the caller.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace zuu::par {
+
+// ==================== Thread Count ====================
+
+// 0 means "all hardware threads"; the result is never 0
+[[nodiscard]] inline std::size_t thread_count(std::size_t requested = 0) noexcept {
+    if (requested == 0) requested = std::thread::hardware_concurrency();
+    return std::max<std::size_t>(1, requested);
+}
+
+// ==================== Fork-Join ====================
+
+template <typename Fn>
+void for_each_task(std::size_t tasks, std::size_t threads, Fn&& fn) {
+    threads = std::min(thread_count(threads), tasks);
+    if (threads <= 1) {
+        for (std::size_t t = 0; t < tasks; ++t) fn(t, std::size_t{0});
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto work = [&](std::size_t worker) {
+        for (std::size_t t = next++; t < tasks; t = next++) fn(t, worker);
+    };
+
+    std::vector<std::jthread> pool;
+    pool.reserve(threads - 1);
+    for (std::size_t w = 1; w < threads; ++w) pool.emplace_back(work, w);
+    work(0);
+}
+
+// Number of workers for_each_task will actually use
+[[nodiscard]] inline std::size_t workers_for(std::size_t tasks, std::size_t threads) noexcept {
+    return std::max<std::size_t>(1, std::min(thread_count(threads), tasks));
+}
+
+// ==================== Worker Pool ====================
+
+/**
+ * @brief Fork-join over threads started once, for repeated calls
+ * for_each_task behaves like the free function but allocates nothing
+ * and starts no threads: the caller is worker 0 and size() - 1 parked
+ * threads join each call. Calls must not overlap or nest.
+ */
+class worker_pool {
+public:
+    explicit worker_pool(std::size_t threads = 0) : state_(std::make_unique<state>()) {
+        const std::size_t n = thread_count(threads);
+        threads_.reserve(n - 1);
+        for (std::size_t w = 1; w < n; ++w) {
+            threads_.emplace_back([st = state_.get(), w] { st->serve(w); });
+        }
+    }
+
+    worker_pool(worker_pool&&) noexcept = default;
+    worker_pool& operator=(worker_pool&&) = delete;
+
+    ~worker_pool() {
+        if (!state_) return;
+        {
+            std::lock_guard lock(state_->mutex);
+            state_->stop = true;
+        }
+        state_->wake.notify_all();
+        threads_.clear();
+    }
+
+    /// Workers per call, the caller included
+    [[nodiscard]] std::size_t size() const noexcept { return threads_.size() + 1; }
+
+    template <typename Fn>
+    void for_each_task(std::size_t tasks, Fn&& fn) {
+        if (threads_.empty() || tasks <= 1) {
+            for (std::size_t t = 0; t < tasks; ++t) fn(t, std::size_t{0});
+            return;
+        }
+
+        state& st = *state_;
+        st.next = 0;
+        st.tasks = tasks;
+        st.context = &fn;
+        st.run = [](void* ctx, std::size_t t, std::size_t w) { (*static_cast<std::remove_reference_t<Fn>*>(ctx))(t, w); };
+        {
+            std::lock_guard lock(st.mutex);
+            st.busy = threads_.size();
+            ++st.generation;
+        }
+        st.wake.notify_all();
+
+        st.work(0);
+        std::unique_lock lock(st.mutex);
+        st.idle.wait(lock, [&] { return st.busy == 0; });
+    }
+
+private:
+    // Shared with the threads; heap-held so the pool stays movable
+    struct state {
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::condition_variable idle;
+        std::uint64_t generation = 0;
+        std::size_t busy = 0;
+        bool stop = false;
+
+        std::atomic<std::size_t> next{0};
+        std::size_t tasks = 0;
+        void* context = nullptr;
+        void (*run)(void*, std::size_t, std::size_t) = nullptr;
+
+        void work(std::size_t worker) {
+            for (std::size_t t = next++; t < tasks; t = next++) run(context, t, worker);
+        }
+
+        void serve(std::size_t worker) {
+            std::uint64_t seen = 0;
+            for (;;) {
+                {
+                    std::unique_lock lock(mutex);
+                    wake.wait(lock, [&] { return stop || generation != seen; });
+                    if (stop) return;
+                    seen = generation;
+                }
+                work(worker);
+                std::lock_guard lock(mutex);
+                if (--busy == 0) idle.notify_one();
+            }
+        }
+    };
+
+    std::unique_ptr<state> state_;
+    std::vector<std::jthread> threads_;
+};
+
+} // namespace zuu::par
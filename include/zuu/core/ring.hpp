@@ -0,0 +1,232 @@
+#pragma once
+
+/**
+ * @file zuu/core/ring.hpp
+ * @brief Fixed-capacity ring buffer string with O(1) consume-front
+ * @version 3.0.0
+ *
+ * Usage:
+ *   ring_fstring<4096> rx;
+ *   auto room = rx.prepare();                      // contiguous free space
+ *   rx.commit(::read(fd, room.data(), room.size()));
+ *   while ((nl = rx.find('\n')) != rx.npos) {
+ *       handle_line(rx, nl);                       // rx[i], rx.views()
+ *       rx.consume(nl + 1);                        // O(1), no memmove
+ *   }
+ *   std::string_view all = rx.linearize();         // one view on demand
+ *
+ * Contents are `size()` characters starting at a moving head. They are
+ * exposed as one or two views (the second non-empty only when the data
+ * wraps past the end of storage); find() runs the SIMD kernels on each
+ * part and checks matches straddling the wrap point separately.
+ */
+
+#include "core.hpp"
+#include <algorithm>
+#include <array>
+#include <span>
+#include <string_view>
+
+namespace zuu {
+
+template <meta::character CharT, std::size_t Cap>
+class basic_ring_fstring {
+    static_assert(Cap > 0, "ring capacity must be positive");
+
+public:
+    using value_type = CharT;
+    using size_type = std::size_t;
+    using reference = CharT&;
+    using const_reference = const CharT&;
+    using view_type = std::basic_string_view<CharT>;
+
+    static constexpr size_type capacity = Cap;
+    static constexpr size_type npos = static_cast<size_type>(-1);
+
+private:
+    CharT data_[Cap]{};
+    size_type head_{};
+    size_type size_{};
+
+    [[nodiscard]] static constexpr size_type wrap(size_type i) noexcept {
+        return i >= Cap ? i - Cap : i;
+    }
+
+    [[nodiscard]] constexpr size_type tail() const noexcept { return wrap(head_ + size_); }
+
+public:
+    constexpr basic_ring_fstring() noexcept = default;
+
+    explicit constexpr basic_ring_fstring(view_type sv) noexcept { append(sv); }
+
+    // ==================== Capacity ====================
+
+    [[nodiscard]] constexpr size_type size() const noexcept { return size_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] constexpr bool full() const noexcept { return size_ == Cap; }
+    [[nodiscard]] constexpr size_type available() const noexcept { return Cap - size_; }
+
+    // ==================== Element Access ====================
+
+    [[nodiscard]] constexpr reference operator[](size_type i) noexcept { return data_[wrap(head_ + i)]; }
+    [[nodiscard]] constexpr const_reference operator[](size_type i) const noexcept { return data_[wrap(head_ + i)]; }
+
+    [[nodiscard]] constexpr reference front() noexcept { return data_[head_]; }
+    [[nodiscard]] constexpr const_reference front() const noexcept { return data_[head_]; }
+    [[nodiscard]] constexpr reference back() noexcept { return (*this)[size_ - 1]; }
+    [[nodiscard]] constexpr const_reference back() const noexcept { return (*this)[size_ - 1]; }
+
+    /// Contents in order; the second view is empty unless the data wraps
+    [[nodiscard]] constexpr std::array<view_type, 2> views() const noexcept {
+        const size_type first = std::min(size_, Cap - head_);
+        return {view_type{data_ + head_, first}, view_type{data_, size_ - first}};
+    }
+
+    [[nodiscard]] constexpr bool contiguous() const noexcept { return head_ + size_ <= Cap; }
+
+    /// Moves the contents to the start of storage and returns them as one view
+    constexpr view_type linearize() noexcept {
+        if (head_ != 0) {
+            if (contiguous()) {
+                std::copy_n(data_ + head_, size_, data_);
+            } else {
+                std::rotate(data_, data_ + head_, data_ + Cap);
+            }
+            head_ = 0;
+        }
+        return {data_, size_};
+    }
+
+    // ==================== Modifiers ====================
+
+    constexpr void clear() noexcept { head_ = size_ = 0; }
+
+    /// Appends what fits; the rest is dropped, like every fstring write
+    constexpr basic_ring_fstring& append(const CharT* str, size_type len) noexcept {
+        len = std::min(len, available());
+        const size_type t = tail();
+        const size_type first = std::min(len, Cap - t);
+        std::copy_n(str, first, data_ + t);
+        std::copy_n(str + first, len - first, data_);
+        size_ += len;
+        return *this;
+    }
+
+    constexpr basic_ring_fstring& append(view_type sv) noexcept { return append(sv.data(), sv.size()); }
+
+    constexpr basic_ring_fstring& operator+=(view_type sv) noexcept { return append(sv); }
+
+    constexpr void push_back(CharT ch) noexcept {
+        if (size_ < Cap) {
+            data_[tail()] = ch;
+            ++size_;
+        }
+    }
+
+    /// Drops up to n characters from the front in O(1)
+    constexpr void consume(size_type n) noexcept {
+        n = std::min(n, size_);
+        size_ -= n;
+        // An emptied ring restarts at 0 so the next fill stays contiguous
+        head_ = size_ == 0 ? 0 : wrap(head_ + n);
+    }
+
+    constexpr void pop_front() noexcept { consume(1); }
+
+    constexpr void pop_back() noexcept {
+        if (size_ > 0) --size_;
+    }
+
+    /**
+     * @brief Contiguous free space after the last character
+     * Fill a prefix of it (e.g. with read()) and commit() that many
+     * characters. Empty when full; call again after commit() to reach
+     * space that wraps to the start of storage.
+     */
+    [[nodiscard]] constexpr std::span<CharT> prepare() noexcept {
+        const size_type t = tail();
+        const size_type room = (size_ == Cap) ? 0 : (t >= head_ ? Cap - t : head_ - t);
+        return {data_ + t, room};
+    }
+
+    constexpr void commit(size_type n) noexcept {
+        size_ += std::min(n, prepare().size());
+    }
+
+    // ==================== Search ====================
+
+    [[nodiscard]] constexpr size_type find(CharT ch, size_type pos = 0) const noexcept {
+        const auto [a, b] = views();
+        if (pos < a.size()) {
+            const size_type r = simd::find_char(a.data() + pos, a.size() - pos, ch);
+            if (r != simd::npos) return pos + r;
+            pos = a.size();
+        }
+        if (pos >= size_) return npos;
+        const size_type off = pos - a.size();
+        const size_type r = simd::find_char(b.data() + off, b.size() - off, ch);
+        return r == simd::npos ? npos : pos + r;
+    }
+
+    /// First occurrence at or after pos, including ones across the wrap point
+    [[nodiscard]] constexpr size_type find(view_type needle, size_type pos = 0) const noexcept {
+        const size_type m = needle.size();
+        if (m == 0) return pos <= size_ ? pos : npos;
+        if (pos > size_ || m > size_ - pos) return npos;
+        if (m == 1) return find(needle[0], pos);
+
+        const auto [a, b] = views();
+        if (pos < a.size()) {
+            const size_type r = simd::find(a.data() + pos, a.size() - pos, needle.data(), m);
+            if (r != simd::npos) return pos + r;
+        }
+
+        // Starts in the last m-1 characters of `a` that run on into `b`
+        if (!b.empty()) {
+            const size_type lo = std::max(pos, a.size() > m - 1 ? a.size() - (m - 1) : 0);
+            for (size_type s = lo; s < a.size() && s + m <= size_; ++s) {
+                const size_type k = a.size() - s;
+                if (a[s] == needle[0] &&
+                    simd::equal(a.data() + s, needle.data(), k) &&
+                    simd::equal(b.data(), needle.data() + k, m - k)) {
+                    return s;
+                }
+            }
+        }
+
+        const size_type off = pos > a.size() ? pos - a.size() : 0;
+        const size_type r = simd::find(b.data() + off, b.size() - off, needle.data(), m);
+        return r == simd::npos ? npos : a.size() + off + r;
+    }
+
+    [[nodiscard]] constexpr bool contains(CharT ch) const noexcept { return find(ch) != npos; }
+    [[nodiscard]] constexpr bool contains(view_type needle) const noexcept { return find(needle) != npos; }
+
+    // ==================== Comparison ====================
+
+    [[nodiscard]] friend constexpr bool operator==(const basic_ring_fstring& r, view_type sv) noexcept {
+        if (r.size_ != sv.size()) return false;
+        const auto [a, b] = r.views();
+        return simd::equal(a.data(), sv.data(), a.size()) &&
+               simd::equal(b.data(), sv.data() + a.size(), b.size());
+    }
+};
+
+// ==================== Type Aliases ====================
+
+template <std::size_t Cap>
+using ring_fstring = basic_ring_fstring<char, Cap>;
+
+template <std::size_t Cap>
+using wring_fstring = basic_ring_fstring<wchar_t, Cap>;
+
+template <std::size_t Cap>
+using u8ring_fstring = basic_ring_fstring<char8_t, Cap>;
+
+template <std::size_t Cap>
+using u16ring_fstring = basic_ring_fstring<char16_t, Cap>;
+
+template <std::size_t Cap>
+using u32ring_fstring = basic_ring_fstring<char32_t, Cap>;
+
+} // namespace zuu
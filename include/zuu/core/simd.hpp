@@ -0,0 +1,736 @@
+#pragma once
+
+/**
+ * @file zuu/core/simd.hpp
+ * @brief Vectorized scanning kernels over raw character ranges
+ * @version 3.0.0
+ *
+ * Pointer + length primitives shared by the search, split and tooling
+ * layers. Every kernel is constexpr: constant evaluation (and builds
+ * without SSE2, or with ZUU_NO_SIMD defined) take the scalar path.
+ *
+ * Usage:
+ *   auto pos = zuu::simd::find_char(buf, len, '\n');
+ *   auto n   = zuu::simd::count_char(buf, len, ',');
+ *   auto at  = zuu::simd::find(buf, len, "needle", 6);
+ *
+ * 1-, 2- and 4-byte code units (char, char8_t, char16_t, char32_t and
+ * wchar_t on either platform) share one SSE2 path with 8/16/32-bit lane
+ * compares, so wide strings scan 8 or 4 characters per instruction.
+ */
+
+#include "../meta/concepts.hpp"
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if !defined(ZUU_NO_SIMD) && \
+    (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define ZUU_SIMD_SSE2 1
+    #include <emmintrin.h>
+#endif
+
+namespace zuu::simd {
+
+inline constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+// ==================== Lane Detection ====================
+
+// Character types scanned by the SSE2 kernels: 16, 8 or 4 lanes per register
+template <typename CharT>
+inline constexpr bool simd_lanes_v = meta::character<CharT> &&
+    (sizeof(CharT) == 1 || sizeof(CharT) == 2 || sizeof(CharT) == 4);
+
+// Code units per 16-byte register
+template <typename CharT>
+inline constexpr std::size_t lanes_v = 16 / sizeof(CharT);
+
+#if defined(ZUU_SIMD_SSE2)
+
+namespace detail {
+
+// movemask_epi8 yields sizeof(CharT) identical bits per lane
+template <typename CharT>
+inline constexpr unsigned lane_bits = (1u << sizeof(CharT)) - 1;
+
+// Callers only reach a load with n >= lanes_v<CharT> code units in range, but
+// GCC cannot see that bound for strlen-sized literals and flags the 16-byte
+// read against the literal's size.
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Warray-bounds"
+#endif
+template <typename CharT>
+inline __m128i load(const CharT* p) noexcept {
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+template <typename CharT>
+inline void store(CharT* p, __m128i v) noexcept {
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(p), v);
+}
+
+template <typename CharT>
+inline __m128i splat(CharT ch) noexcept {
+    if constexpr (sizeof(CharT) == 1) return _mm_set1_epi8(static_cast<char>(ch));
+    else if constexpr (sizeof(CharT) == 2) return _mm_set1_epi16(static_cast<short>(ch));
+    else return _mm_set1_epi32(static_cast<int>(ch));
+}
+
+template <typename CharT>
+inline __m128i cmpeq(__m128i a, __m128i b) noexcept {
+    if constexpr (sizeof(CharT) == 1) return _mm_cmpeq_epi8(a, b);
+    else if constexpr (sizeof(CharT) == 2) return _mm_cmpeq_epi16(a, b);
+    else return _mm_cmpeq_epi32(a, b);
+}
+
+// Signed lane compare; code units >= 0x80 / 0x8000 / 0x80000000 read as
+// negative, which keeps them outside every ASCII range test below
+template <typename CharT>
+inline __m128i cmpgt(__m128i a, __m128i b) noexcept {
+    if constexpr (sizeof(CharT) == 1) return _mm_cmpgt_epi8(a, b);
+    else if constexpr (sizeof(CharT) == 2) return _mm_cmpgt_epi16(a, b);
+    else return _mm_cmpgt_epi32(a, b);
+}
+
+template <typename CharT>
+inline __m128i add(__m128i a, __m128i b) noexcept {
+    if constexpr (sizeof(CharT) == 1) return _mm_add_epi8(a, b);
+    else if constexpr (sizeof(CharT) == 2) return _mm_add_epi16(a, b);
+    else return _mm_add_epi32(a, b);
+}
+
+template <typename CharT>
+inline __m128i sub(__m128i a, __m128i b) noexcept {
+    if constexpr (sizeof(CharT) == 1) return _mm_sub_epi8(a, b);
+    else if constexpr (sizeof(CharT) == 2) return _mm_sub_epi16(a, b);
+    else return _mm_sub_epi32(a, b);
+}
+
+inline unsigned movemask(__m128i v) noexcept {
+    return static_cast<unsigned>(_mm_movemask_epi8(v));
+}
+
+template <typename CharT>
+inline unsigned mask_eq(__m128i block, __m128i needle) noexcept {
+    return movemask(cmpeq<CharT>(block, needle));
+}
+
+// Lane index of the lowest / highest set lane
+template <typename CharT>
+inline std::size_t first_lane(unsigned mask) noexcept {
+    return static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(CharT);
+}
+
+template <typename CharT>
+inline std::size_t last_lane(unsigned mask) noexcept {
+    return static_cast<std::size_t>(31 - std::countl_zero(mask)) / sizeof(CharT);
+}
+
+template <typename CharT>
+inline unsigned clear_first_lane(unsigned mask) noexcept {
+    return mask & ~(lane_bits<CharT> << std::countr_zero(mask));
+}
+
+// Sum of the lanes read as unsigned counters
+template <typename CharT>
+inline std::size_t lane_sum(__m128i v) noexcept {
+    using lane_t = std::conditional_t<sizeof(CharT) == 1, std::uint8_t,
+                   std::conditional_t<sizeof(CharT) == 2, std::uint16_t, std::uint32_t>>;
+    lane_t lanes[16 / sizeof(CharT)];
+    std::memcpy(lanes, &v, sizeof(v));
+    std::size_t sum = 0;
+    for (const lane_t x : lanes) sum += x;
+    return sum;
+}
+
+// All-ones lanes where lo <= v <= hi (ASCII bounds)
+template <typename CharT>
+inline __m128i in_range(__m128i v, CharT lo, CharT hi) noexcept {
+    return _mm_and_si128(cmpgt<CharT>(v, splat(static_cast<CharT>(lo - 1))),
+                         cmpgt<CharT>(splat(static_cast<CharT>(hi + 1)), v));
+}
+
+// ' ', '\t', '\n', '\v', '\f', '\r'
+template <typename CharT>
+inline __m128i is_space(__m128i v) noexcept {
+    return _mm_or_si128(cmpeq<CharT>(v, splat(CharT(' '))), in_range(v, CharT('\t'), CharT('\r')));
+}
+
+} // namespace detail
+
+#endif // ZUU_SIMD_SSE2
+
+// ==================== Find Character ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find_char(
+    const CharT* p, std::size_t n, CharT ch
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i needle = detail::splat(ch);
+            for (; i + L <= n; i += L) {
+                if (unsigned m = detail::mask_eq<CharT>(detail::load(p + i), needle)) {
+                    return i + detail::first_lane<CharT>(m);
+                }
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i] == ch) return i;
+    }
+    return npos;
+}
+
+// ==================== Reverse Find Character ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t rfind_char(
+    const CharT* p, std::size_t n, CharT ch
+) noexcept {
+    std::size_t i = n;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i needle = detail::splat(ch);
+            for (; i >= L; i -= L) {
+                if (unsigned m = detail::mask_eq<CharT>(detail::load(p + i - L), needle)) {
+                    return i - L + detail::last_lane<CharT>(m);
+                }
+            }
+        }
+    }
+#endif
+    for (; i > 0; --i) {
+        if (p[i - 1] == ch) return i - 1;
+    }
+    return npos;
+}
+
+// ==================== Count Character ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t count_char(
+    const CharT* p, std::size_t n, CharT ch
+) noexcept {
+    std::size_t i = 0;
+    std::size_t cnt = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            // Matching lanes are -1: subtracting them counts per lane,
+            // flushed before any lane counter can wrap
+            constexpr std::size_t L = lanes_v<CharT>;
+            constexpr std::size_t flush = sizeof(CharT) == 4 ? (std::size_t{1} << 30)
+                                                             : (std::size_t{1} << (8 * sizeof(CharT))) - 1;
+            const __m128i needle = detail::splat(ch);
+            while (i + L <= n) {
+                __m128i acc = _mm_setzero_si128();
+                for (std::size_t b = 0; b < flush && i + L <= n; ++b, i += L) {
+                    acc = detail::sub<CharT>(acc, detail::cmpeq<CharT>(detail::load(p + i), needle));
+                }
+                cnt += detail::lane_sum<CharT>(acc);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (p[i] == ch) ++cnt;
+    }
+    return cnt;
+}
+
+// ==================== Equality ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr bool equal(
+    const CharT* a, const CharT* b, std::size_t n
+) noexcept {
+    if (!std::is_constant_evaluated()) {
+        return n == 0 || std::memcmp(a, b, n * sizeof(CharT)) == 0;
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        if (a[i] != b[i]) return false;
+    }
+    return true;
+}
+
+// ==================== Mismatch / Compare ====================
+
+// Index of the first differing code unit, or n when the ranges are equal
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t mismatch(
+    const CharT* a, const CharT* b, std::size_t n
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            for (; i + L <= n; i += L) {
+                const unsigned eq = detail::mask_eq<CharT>(detail::load(a + i), detail::load(b + i));
+                if (eq != 0xffffu) return i + detail::first_lane<CharT>(~eq & 0xffffu);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (a[i] != b[i]) return i;
+    }
+    return n;
+}
+
+// Lexicographic by code unit value, then by length
+template <meta::character CharT>
+[[nodiscard]] constexpr int compare(
+    const CharT* a, std::size_t na,
+    const CharT* b, std::size_t nb
+) noexcept {
+    const std::size_t n = na < nb ? na : nb;
+    const std::size_t at = mismatch(a, b, n);
+    if (at != n) return a[at] < b[at] ? -1 : 1;
+    return na < nb ? -1 : (na > nb ? 1 : 0);
+}
+
+// ==================== Find Substring ====================
+
+/**
+ * @brief Substring search with a first/last character SIMD filter
+ *
+ * Each 16-byte block is compared against the needle's first and last
+ * characters at their relative offsets; only positions matching both
+ * are verified, which keeps natural-language haystacks near memchr speed.
+ */
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find(
+    const CharT* hay, std::size_t n,
+    const CharT* needle, std::size_t m
+) noexcept {
+    if (m == 0) return 0;
+    if (m > n) return npos;
+    if (m == 1) return find_char(hay, n, needle[0]);
+
+    const std::size_t last = m - 1;
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated()) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i first_v = detail::splat(needle[0]);
+            const __m128i last_v = detail::splat(needle[last]);
+            for (; i + last + L <= n; i += L) {
+                unsigned mask =
+                    detail::mask_eq<CharT>(detail::load(hay + i), first_v) &
+                    detail::mask_eq<CharT>(detail::load(hay + i + last), last_v);
+                while (mask) {
+                    const std::size_t at = i + detail::first_lane<CharT>(mask);
+                    if (equal(hay + at + 1, needle + 1, m - 2)) return at;
+                    mask = detail::clear_first_lane<CharT>(mask);
+                }
+            }
+        }
+    }
+#endif
+    for (; i + m <= n; ++i) {
+        if (hay[i] == needle[0] && hay[i + last] == needle[last] &&
+            equal(hay + i + 1, needle + 1, m - 2)) {
+            return i;
+        }
+    }
+    return npos;
+}
+
+// ==================== Count Substring ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t count(
+    const CharT* hay, std::size_t n,
+    const CharT* needle, std::size_t m
+) noexcept {
+    if (m == 0) return 0;
+    if (m == 1) return count_char(hay, n, needle[0]);
+
+    std::size_t cnt = 0;
+    std::size_t pos = 0;
+    while (pos < n) {
+        const std::size_t at = find(hay + pos, n - pos, needle, m);
+        if (at == npos) break;
+        ++cnt;
+        pos += at + m;
+    }
+    return cnt;
+}
+
+// ==================== Find First Of ====================
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find_first_of(
+    const CharT* p, std::size_t n,
+    const CharT* set, std::size_t k
+) noexcept {
+    if (k == 0) return npos;
+    if (k == 1) return find_char(p, n, set[0]);
+
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT> && k <= 4) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i s0 = detail::splat(set[0]);
+            const __m128i s1 = detail::splat(set[1]);
+            const __m128i s2 = detail::splat(set[k > 2 ? 2 : 1]);
+            const __m128i s3 = detail::splat(set[k > 3 ? 3 : 1]);
+            for (; i + L <= n; i += L) {
+                const __m128i block = detail::load(p + i);
+                const __m128i hit = _mm_or_si128(
+                    _mm_or_si128(detail::cmpeq<CharT>(block, s0), detail::cmpeq<CharT>(block, s1)),
+                    _mm_or_si128(detail::cmpeq<CharT>(block, s2), detail::cmpeq<CharT>(block, s3)));
+                if (unsigned m = detail::movemask(hit)) {
+                    return i + detail::first_lane<CharT>(m);
+                }
+            }
+        }
+    }
+#endif
+    if constexpr (sizeof(CharT) == 1) {
+        // Membership table: one lookup per character instead of k compares
+        bool table[256]{};
+        for (std::size_t j = 0; j < k; ++j) {
+            table[static_cast<unsigned char>(set[j])] = true;
+        }
+        for (; i < n; ++i) {
+            if (table[static_cast<unsigned char>(p[i])]) return i;
+        }
+    } else {
+        for (; i < n; ++i) {
+            for (std::size_t j = 0; j < k; ++j) {
+                if (p[i] == set[j]) return i;
+            }
+        }
+    }
+    return npos;
+}
+
+// ==================== Range Span ====================
+
+/**
+ * @brief Length of the leading run inside k <= 4 ASCII ranges [lo[j], hi[j]]
+ *
+ * Identifier-style runs ([A-Za-z0-9_]) are a handful of ranges, so a
+ * block is classified with two signed compares per range. Code units
+ * past 0x7F never match, whatever their width.
+ */
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t span_ranges(
+    const CharT* p, std::size_t n,
+    const CharT* lo, const CharT* hi, std::size_t k
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT> && k > 0 && k <= 4) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            __m128i los[4], his[4];
+            for (std::size_t j = 0; j < 4; ++j) {
+                los[j] = detail::splat(lo[j < k ? j : 0]);
+                his[j] = detail::splat(hi[j < k ? j : 0]);
+            }
+            for (; i + L <= n; i += L) {
+                const __m128i v = detail::load(p + i);
+                __m128i in = _mm_setzero_si128();
+                for (std::size_t j = 0; j < 4; ++j) {
+                    // Outside means v > hi or lo > v (signed, so bytes >= 0x80 fall out)
+                    const __m128i out = _mm_or_si128(detail::cmpgt<CharT>(v, his[j]),
+                                                     detail::cmpgt<CharT>(los[j], v));
+                    in = _mm_or_si128(in, _mm_andnot_si128(out, _mm_set1_epi8(-1)));
+                }
+                const unsigned m = detail::movemask(in);
+                if (m != 0xffffu) return i + detail::first_lane<CharT>(~m & 0xffffu);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        bool in = false;
+        for (std::size_t j = 0; j < k && !in; ++j) {
+            in = p[i] >= lo[j] && p[i] <= hi[j];
+        }
+        if (!in) return i;
+    }
+    return n;
+}
+
+// ==================== ASCII Case ====================
+
+/**
+ * @brief Map ASCII letters to one case, copying src -> dst (may alias)
+ *
+ * Non-ASCII code units pass through unchanged, matching the scalar
+ * is_upper / is_lower rules used by the case algorithms.
+ */
+template <meta::character CharT>
+constexpr void ascii_case(
+    const CharT* src, CharT* dst, std::size_t n, bool upper
+) noexcept {
+    const CharT lo = upper ? CharT('a') : CharT('A');
+    const CharT hi = upper ? CharT('z') : CharT('Z');
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i flip = detail::splat(CharT(0x20));
+            for (; i + L <= n; i += L) {
+                const __m128i v = detail::load(src + i);
+                const __m128i delta = _mm_and_si128(detail::in_range(v, lo, hi), flip);
+                detail::store(dst + i, upper ? detail::sub<CharT>(v, delta)
+                                             : detail::add<CharT>(v, delta));
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        const CharT ch = src[i];
+        dst[i] = (ch >= lo && ch <= hi)
+            ? static_cast<CharT>(upper ? ch - 0x20 : ch + 0x20)
+            : ch;
+    }
+}
+
+template <meta::character CharT>
+constexpr void to_lower(const CharT* src, CharT* dst, std::size_t n) noexcept {
+    ascii_case(src, dst, n, false);
+}
+
+template <meta::character CharT>
+constexpr void to_upper(const CharT* src, CharT* dst, std::size_t n) noexcept {
+    ascii_case(src, dst, n, true);
+}
+
+// Equality after folding ASCII letters to lower case
+template <meta::character CharT>
+[[nodiscard]] constexpr bool equal_ignore_case(
+    const CharT* a, const CharT* b, std::size_t n
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            const __m128i flip = detail::splat(CharT(0x20));
+            const auto fold = [&](__m128i v) {
+                return detail::add<CharT>(v, _mm_and_si128(detail::in_range(v, CharT('A'), CharT('Z')), flip));
+            };
+            for (; i + L <= n; i += L) {
+                const unsigned eq = detail::mask_eq<CharT>(fold(detail::load(a + i)), fold(detail::load(b + i)));
+                if (eq != 0xffffu) return false;
+            }
+        }
+    }
+#endif
+    const auto fold = [](CharT ch) {
+        return (ch >= CharT('A') && ch <= CharT('Z')) ? static_cast<CharT>(ch + 0x20) : ch;
+    };
+    for (; i < n; ++i) {
+        if (fold(a[i]) != fold(b[i])) return false;
+    }
+    return true;
+}
+
+// ==================== Whitespace Skip ====================
+
+namespace detail {
+
+template <meta::character CharT>
+constexpr bool scalar_space(CharT ch) noexcept {
+    return ch == CharT(' ') || (ch >= CharT('\t') && ch <= CharT('\r'));
+}
+
+} // namespace detail
+
+// First code unit that is not ASCII whitespace, or npos
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find_first_not_space(
+    const CharT* p, std::size_t n
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            for (; i + L <= n; i += L) {
+                const unsigned sp = detail::movemask(detail::is_space<CharT>(detail::load(p + i)));
+                if (sp != 0xffffu) return i + detail::first_lane<CharT>(~sp & 0xffffu);
+            }
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (!detail::scalar_space(p[i])) return i;
+    }
+    return npos;
+}
+
+// Last code unit that is not ASCII whitespace, or npos
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find_last_not_space(
+    const CharT* p, std::size_t n
+) noexcept {
+    std::size_t i = n;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (simd_lanes_v<CharT>) {
+        if (!std::is_constant_evaluated() && n >= lanes_v<CharT>) {
+            constexpr std::size_t L = lanes_v<CharT>;
+            for (; i >= L; i -= L) {
+                const unsigned sp = detail::movemask(detail::is_space<CharT>(detail::load(p + i - L)));
+                if (sp != 0xffffu) return i - L + detail::last_lane<CharT>(~sp & 0xffffu);
+            }
+        }
+    }
+#endif
+    for (; i > 0; --i) {
+        if (!detail::scalar_space(p[i - 1])) return i - 1;
+    }
+    return npos;
+}
+
+// ==================== Character Bitmap ====================
+
+// Bit i set when p[i] == ch, for up to 64 code units; bits past n are clear
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint64_t match_mask(const CharT* p, std::size_t n, CharT ch) noexcept {
+    if (n > 64) n = 64;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (sizeof(CharT) == 1) {
+        if (!std::is_constant_evaluated() && n == 64) {
+            const __m128i needle = detail::splat(ch);
+            std::uint64_t mask = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                mask |= std::uint64_t(detail::mask_eq<CharT>(detail::load(p + 16 * k), needle)) << (16 * k);
+            }
+            return mask;
+        }
+    }
+#endif
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (p[i] == ch) mask |= std::uint64_t{1} << i;
+    }
+    return mask;
+}
+
+// ==================== Range Bitmap ====================
+
+// Bit i set when p[i] lies in one of k <= 4 ASCII ranges [lo[j], hi[j]],
+// for up to 64 code units; bits past n are clear
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint64_t range_mask(
+    const CharT* p, std::size_t n,
+    const CharT* lo, const CharT* hi, std::size_t k
+) noexcept {
+    if (n > 64) n = 64;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (sizeof(CharT) == 1) {
+        if (!std::is_constant_evaluated() && k > 0 && k <= 4) {
+            CharT pad[64];
+            if (n < 64) {
+                std::memset(pad, 0, sizeof(pad));
+                std::memcpy(pad, p, n);
+                p = pad;
+            }
+            __m128i los[4], his[4];
+            for (std::size_t j = 0; j < 4; ++j) {
+                los[j] = detail::splat(lo[j < k ? j : 0]);
+                his[j] = detail::splat(hi[j < k ? j : 0]);
+            }
+            std::uint64_t mask = 0;
+            for (unsigned b = 0; b < 4; ++b) {
+                const __m128i v = detail::load(p + 16 * b);
+                __m128i in = _mm_setzero_si128();
+                for (std::size_t j = 0; j < 4; ++j) {
+                    const __m128i out = _mm_or_si128(detail::cmpgt<CharT>(v, his[j]),
+                                                     detail::cmpgt<CharT>(los[j], v));
+                    in = _mm_or_si128(in, _mm_andnot_si128(out, _mm_set1_epi8(-1)));
+                }
+                mask |= std::uint64_t(detail::movemask(in)) << (16 * b);
+            }
+            return n < 64 ? mask & ((std::uint64_t{1} << n) - 1) : mask;
+        }
+    }
+#endif
+    std::uint64_t mask = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < k; ++j) {
+            if (p[i] >= lo[j] && p[i] <= hi[j]) {
+                mask |= std::uint64_t{1} << i;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+// ==================== Whitespace Bitmap ====================
+
+// Bit i set when p[i] is ASCII whitespace, for up to 64 code units;
+// bits at and past n are set, so a token ending at n is terminated
+template <meta::character CharT>
+[[nodiscard]] constexpr std::uint64_t space_mask(const CharT* p, std::size_t n) noexcept {
+    if (n > 64) n = 64;
+#if defined(ZUU_SIMD_SSE2)
+    if constexpr (sizeof(CharT) == 1) {
+        if (!std::is_constant_evaluated()) {
+            CharT pad[64];
+            if (n < 64) {
+                std::memset(pad, ' ', sizeof(pad));
+                std::memcpy(pad, p, n);
+                p = pad;
+            }
+            std::uint64_t mask = 0;
+            for (unsigned k = 0; k < 4; ++k) {
+                const __m128i v = detail::load(p + 16 * k);
+                mask |= std::uint64_t(detail::movemask(detail::is_space<CharT>(v))) << (16 * k);
+            }
+            return mask;
+        }
+    }
+#endif
+    std::uint64_t mask = n < 64 ? ~std::uint64_t{0} << n : 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (detail::scalar_space(p[i])) mask |= std::uint64_t{1} << i;
+    }
+    return mask;
+}
+
+// ==================== Byte-wise Maximum ====================
+
+// dst[i] = max(dst[i], src[i]); merges HyperLogLog registers
+constexpr void max_bytes(
+    std::uint8_t* dst, const std::uint8_t* src, std::size_t n
+) noexcept {
+    std::size_t i = 0;
+#if defined(ZUU_SIMD_SSE2)
+    if (!std::is_constant_evaluated()) {
+        for (; i + 16 <= n; i += 16) {
+            const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i));
+            const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_max_epu8(a, b));
+        }
+    }
+#endif
+    for (; i < n; ++i) {
+        if (src[i] > dst[i]) dst[i] = src[i];
+    }
+}
+
+} // namespace zuu::simd
@@ -273,8 +273,10 @@ constexpr auto to_fstring(T value, int precision) noexcept {
 
 // ==================== Parsing ====================
 
-template <std::integral IntT, meta::character CharT, std::size_t Cap>
-constexpr IntT parse_int(const basic_fstring<CharT, Cap>& str, int base = 10) noexcept {
+template <std::integral IntT, meta::char_range R>
+constexpr IntT parse_int(const R& text, int base = 10) noexcept {
+    using CharT = meta::range_char_t<R>;
+    const auto str = meta::as_view(text);
     if (str.empty()) return IntT{};
     
     IntT result = 0;
@@ -309,8 +311,10 @@ constexpr IntT parse_int(const basic_fstring<CharT, Cap>& str, int base = 10) no
     return negative ? -result : result;
 }
 
-template <std::floating_point FloatT, meta::character CharT, std::size_t Cap>
-constexpr FloatT parse_float(const basic_fstring<CharT, Cap>& str) noexcept {
+template <std::floating_point FloatT, meta::char_range R>
+constexpr FloatT parse_float(const R& text) noexcept {
+    using CharT = meta::range_char_t<R>;
+    const auto str = meta::as_view(text);
     if (str.empty()) return FloatT{};
     
     FloatT result = 0;
@@ -65,7 +65,9 @@ namespace zuu {
 
 // Core storage
 #include "core/core.hpp"
+#include "core/fstring_ref.hpp"
 #include "core/literals.hpp"
+#include "core/ring.hpp"
 
 // String algorithms (pipeable)
 #include "str/pipe.hpp"
@@ -73,6 +75,8 @@ namespace zuu {
 #include "str/case.hpp"
 #include "str/split.hpp"
 #include "str/find.hpp"
+#include "str/search.hpp"
+#include "str/path.hpp"
 
 // Formatting system
 #include "fmt/core.hpp"
@@ -0,0 +1,382 @@
+#pragma once
+
+/**
+ * @file zuu/io/external_sort.hpp
+ * @brief External merge sort of fixed-size records larger than memory
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::io::external_sorter<zuu::fstring<64>> sorter({.memory_budget = 1u << 30, .unique = true});
+ *   for (auto& key : source) {
+ *       if (!sorter.push(key)) return io_error();
+ *   }
+ *   sorter.finish([&](const zuu::fstring<64>& key) { out << key << '\n'; });
+ *
+ *   // Run files next to the data instead of the system temp directory
+ *   zuu::io::external_sorter<zuu::fstring<64>> local({.temp_dir = "/data/scratch"});
+ *
+ * Records fill an in-memory buffer of up to memory_budget bytes, grown
+ * as records arrive; a full buffer is sorted and written as one run
+ * file in a single sequential write, then closed. finish() merges the
+ * runs with a loser tree: one comparison per tree level per record,
+ * against the runs' current heads. The same buffer is carved into one
+ * read block per run, refilled with large sequential reads; on Linux
+ * the kernel is asked to read the following block ahead while the
+ * current one is merged. When there are more runs than blocks of a
+ * useful size, or than max_open_files allows, groups of runs are first
+ * merged into longer runs, so at most max_open_files run files are
+ * open at any time.
+ *
+ * Records are copied as raw bytes, so T must be trivially copyable;
+ * basic_fstring is. Input that fits the budget is sorted in memory and
+ * never touches disk. I/O failures are reported as false.
+ */
+
+#include "../core/core.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#endif
+
+namespace zuu::io {
+
+struct external_sort_options {
+    std::size_t memory_budget = 256u << 20;   // bytes for the sort buffer and merge blocks
+    std::string temp_dir = {};                // run files go here; empty = system temp directory
+    bool unique = false;                      // emit one record per run of equal records
+    std::size_t max_open_files = 64;          // run files open at once while merging (min 3)
+};
+
+namespace detail {
+
+// Smallest merge read block worth a seek; fewer, larger runs are merged first
+inline constexpr std::size_t min_merge_block = 256u << 10;
+
+[[nodiscard]] inline std::uint64_t run_file_id() noexcept {
+    static std::atomic<std::uint64_t> next{0};
+    const auto now = static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+    return now ^ (next++ << 48);
+}
+
+// Hints that [offset, offset + len) of `f` will be read soon
+inline void prefetch_file(std::FILE* f, std::uint64_t offset, std::size_t len) noexcept {
+#if defined(__linux__)
+    ::posix_fadvise(::fileno(f), static_cast<off_t>(offset), static_cast<off_t>(len), POSIX_FADV_WILLNEED);
+#else
+    (void)f; (void)offset; (void)len;
+#endif
+}
+
+} // namespace detail
+
+// ==================== Loser Tree ====================
+
+/**
+ * @brief Tournament tree over k sources for k-way merging
+ * Internal nodes keep the loser of each match, so replacing the winner
+ * replays only its path to the root: log2(k) comparisons. `beats(a, b)`
+ * tells whether source a's head goes first; exhausted sources must lose.
+ */
+template <typename Beats>
+class loser_tree {
+public:
+    loser_tree(std::size_t k, Beats beats) : k_(k), beats_(std::move(beats)), tree_(std::max<std::size_t>(k, 1)) {
+        tree_[0] = k_ <= 1 ? 0 : build(1);
+    }
+
+    /// Source whose head is smallest
+    [[nodiscard]] std::size_t winner() const noexcept { return tree_[0]; }
+
+    /// Call after the winner's head changed (advanced or exhausted)
+    void replay() {
+        std::size_t s = tree_[0];
+        for (std::size_t t = (s + k_) / 2; t > 0; t /= 2) {
+            if (beats_(tree_[t], s)) std::swap(s, tree_[t]);
+        }
+        tree_[0] = s;
+    }
+
+private:
+    // Leaves are nodes k..2k-1; returns the winner of the subtree
+    std::size_t build(std::size_t node) {
+        if (node >= k_) return node - k_;
+        const std::size_t a = build(2 * node);
+        const std::size_t b = build(2 * node + 1);
+        const bool a_wins = beats_(a, b);
+        tree_[node] = a_wins ? b : a;
+        return a_wins ? a : b;
+    }
+
+    std::size_t k_;
+    Beats beats_;
+    std::vector<std::size_t> tree_;
+};
+
+// ==================== External Sorter ====================
+
+template <typename T, typename Compare = std::less<T>>
+requires std::is_trivially_copyable_v<T> && std::default_initializable<T>
+class external_sorter {
+public:
+    explicit external_sorter(external_sort_options opt = {}, Compare cmp = {})
+        : opt_(std::move(opt)), cmp_(std::move(cmp)),
+          capacity_(std::max<std::size_t>(opt_.memory_budget / sizeof(T), 4)) {}
+
+    external_sorter(const external_sorter&) = delete;
+    external_sorter& operator=(const external_sorter&) = delete;
+
+    ~external_sorter() { discard(); }
+
+    /// Adds a record; false if spilling a full buffer failed
+    bool push(const T& rec) {
+        if (buffer_.size() == capacity_ && !spill()) return false;
+        if (buffer_.size() == buffer_.capacity()) {
+            // Grow on demand, never past the budget
+            buffer_.reserve(std::min(capacity_, std::max<std::size_t>(buffer_.size() * 2, 1024)));
+        }
+        buffer_.push_back(rec);
+        ++size_;
+        return true;
+    }
+
+    template <std::ranges::input_range R>
+    bool push_all(const R& recs) {
+        for (const T& rec : recs) {
+            if (!push(rec)) return false;
+        }
+        return true;
+    }
+
+    /// Records pushed since the last finish()
+    [[nodiscard]] std::size_t size() const noexcept { return size_; }
+
+    /// Run files written so far
+    [[nodiscard]] std::size_t runs() const noexcept { return runs_.size(); }
+
+    /**
+     * @brief Streams every record in order to fn(const T&), then resets
+     * Equal records keep no particular order. False on an I/O error;
+     * fn may then have seen only a prefix.
+     */
+    template <typename Fn>
+    bool finish(Fn&& fn) {
+        bool ok = true;
+        if (runs_.empty()) {
+            std::sort(buffer_.begin(), buffer_.end(), cmp_);
+            emit_sorted(std::span<const T>{buffer_}, fn);
+        } else {
+            ok = (buffer_.empty() || spill()) && merge_all(fn);
+        }
+        discard();
+        return ok;
+    }
+
+private:
+    struct run {
+        std::FILE* file = nullptr; // open only while being written or merged
+        std::string path;
+        std::uint64_t count = 0;
+    };
+
+    // Reads one run through a block of the shared buffer
+    struct run_reader {
+        std::FILE* file;
+        T* block;
+        std::size_t block_size;
+        std::uint64_t remaining;
+        std::uint64_t offset = 0;
+        std::size_t len = 0;
+        std::size_t pos = 0;
+        bool failed = false;
+
+        [[nodiscard]] bool empty() const noexcept { return pos == len; }
+        [[nodiscard]] const T& head() const noexcept { return block[pos]; }
+
+        void refill() noexcept {
+            pos = 0;
+            len = static_cast<std::size_t>(std::min<std::uint64_t>(block_size, remaining));
+            if (len == 0) return;
+            if (std::fread(block, sizeof(T), len, file) != len) {
+                failed = true;
+                len = 0;
+                return;
+            }
+            remaining -= len;
+            offset += len * sizeof(T);
+            if (remaining != 0) {
+                detail::prefetch_file(file, offset, std::min<std::uint64_t>(block_size, remaining) * sizeof(T));
+            }
+        }
+
+        void advance() noexcept {
+            if (++pos == len) refill();
+        }
+    };
+
+    // Creates a new run file for writing
+    [[nodiscard]] bool open_run(run& r) {
+        std::string dir = opt_.temp_dir;
+        if (dir.empty()) {
+            std::error_code ec;
+            dir = std::filesystem::temp_directory_path(ec).string();
+            if (ec) return false;
+        }
+        r.path = dir + "/zuu-sort-" + std::to_string(detail::run_file_id()) + ".run";
+        r.file = std::fopen(r.path.c_str(), "wb");
+        if (!r.file) r.path.clear();
+        return r.file != nullptr;
+    }
+
+    // Closes a run after writing; false if buffered data could not be flushed
+    [[nodiscard]] static bool seal_run(run& r) noexcept {
+        const bool ok = std::fclose(r.file) == 0;
+        r.file = nullptr;
+        return ok;
+    }
+
+    static void close_run(run& r) noexcept {
+        if (r.file) std::fclose(r.file);
+        if (!r.path.empty()) std::remove(r.path.c_str());
+        r = run{};
+    }
+
+    // Sorts the buffer and writes it as one run
+    bool spill() {
+        std::sort(buffer_.begin(), buffer_.end(), cmp_);
+        run r;
+        if (!open_run(r)) return false;
+        runs_.push_back(r);
+
+        if (opt_.unique) {
+            buffer_.erase(std::unique(buffer_.begin(), buffer_.end(),
+                                      [&](const T& a, const T& b) { return !cmp_(a, b); }),
+                          buffer_.end());
+        }
+        runs_.back().count = buffer_.size();
+        const bool ok = std::fwrite(buffer_.data(), sizeof(T), buffer_.size(), r.file) == buffer_.size();
+        buffer_.clear();
+        return seal_run(runs_.back()) && ok;
+    }
+
+    template <typename Fn>
+    void emit_sorted(std::span<const T> sorted, Fn& fn) {
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            if (opt_.unique && i > 0 && !cmp_(sorted[i - 1], sorted[i])) continue;
+            fn(sorted[i]);
+        }
+    }
+
+    // Merges groups of runs until one pass over all of them fits the budget
+    template <typename Fn>
+    bool merge_all(Fn& fn) {
+        buffer_.reserve(capacity_);
+        buffer_.resize(capacity_);
+        // Intermediate passes hold fan_in inputs plus one output open
+        const std::size_t max_fan_in = std::max<std::size_t>(std::min(capacity_, opt_.max_open_files) - 1, 2);
+        const std::size_t fan_in = std::clamp<std::size_t>(capacity_ * sizeof(T) / detail::min_merge_block, 2, max_fan_in);
+
+        while (runs_.size() > fan_in) {
+            run out;
+            if (!open_run(out)) return false;
+            // One block for output, the rest shared by the inputs
+            const std::size_t block = capacity_ / (fan_in + 1);
+            T* out_block = buffer_.data() + fan_in * block;
+            std::size_t fill = 0;
+            bool ok = true;
+
+            const bool merged = merge(std::span<run>{runs_.data(), fan_in}, block, [&](const T& rec) {
+                out_block[fill++] = rec;
+                ++out.count;
+                if (fill == block) {
+                    ok = ok && std::fwrite(out_block, sizeof(T), fill, out.file) == fill;
+                    fill = 0;
+                }
+            });
+            ok = ok && merged && std::fwrite(out_block, sizeof(T), fill, out.file) == fill;
+            ok = seal_run(out) && ok;
+
+            for (std::size_t i = 0; i < fan_in; ++i) close_run(runs_[i]);
+            runs_.erase(runs_.begin(), runs_.begin() + static_cast<std::ptrdiff_t>(fan_in));
+            runs_.push_back(out);
+            if (!ok) return false;
+        }
+        return merge(std::span<run>{runs_}, capacity_ / runs_.size(), fn);
+    }
+
+    // k-way merge of `group`, each read through `block` records of the buffer
+    template <typename Fn>
+    bool merge(std::span<run> group, std::size_t block, Fn&& fn) {
+        std::vector<run_reader> readers;
+        readers.reserve(group.size());
+        for (std::size_t i = 0; i < group.size(); ++i) {
+            group[i].file = std::fopen(group[i].path.c_str(), "rb");
+            if (!group[i].file) return false;
+            readers.push_back({group[i].file, buffer_.data() + i * block, block, group[i].count});
+            readers.back().refill();
+        }
+
+        const auto beats = [&](std::size_t a, std::size_t b) {
+            if (readers[a].empty()) return false;
+            if (readers[b].empty()) return true;
+            if (cmp_(readers[a].head(), readers[b].head())) return true;
+            if (cmp_(readers[b].head(), readers[a].head())) return false;
+            return a < b;
+        };
+        loser_tree<decltype(beats)> tree(readers.size(), beats);
+
+        // Under `unique`, the last record emitted; equal ones that follow are skipped
+        T last{};
+        bool has_last = false;
+
+        for (;;) {
+            run_reader& r = readers[tree.winner()];
+            if (r.empty()) break;
+            if (opt_.unique) {
+                if (!has_last || cmp_(last, r.head())) {
+                    last = r.head();
+                    has_last = true;
+                    fn(r.head());
+                }
+            } else {
+                fn(r.head());
+            }
+            r.advance();
+            tree.replay();
+        }
+
+        for (const run_reader& r : readers) {
+            if (r.failed) return false;
+        }
+        return true;
+    }
+
+    void discard() noexcept {
+        for (run& r : runs_) close_run(r);
+        runs_.clear();
+        buffer_.clear();
+        size_ = 0;
+    }
+
+    external_sort_options opt_;
+    Compare cmp_;
+    std::size_t capacity_;          // records per in-memory run
+    std::vector<T> buffer_;
+    std::vector<run> runs_;
+    std::size_t size_ = 0;
+};
+
+} // namespace zuu::io
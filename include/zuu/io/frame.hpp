@@ -0,0 +1,296 @@
+#pragma once
+
+/**
+ * @file zuu/io/frame.hpp
+ * @brief Length-prefixed message framing over POSIX file descriptors
+ * @version 3.0.0
+ *
+ * Wire format: a 4-byte little-endian payload length, then the payload.
+ * Works on sockets, pipes and FIFOs, blocking or non-blocking.
+ *
+ * The reader keeps one receive buffer of Batch maximum-size frames. A
+ * single read() fills it, and every complete frame in it is handed out
+ * as a view without further syscalls. The writer copies frames into a
+ * ring of basic_fstring<char, Cap> slots and sends a full ring (or an
+ * explicit flush) with one writev(), or one sendmsg() on a socket.
+ *
+ * Writing to a socket whose peer has closed reports frame_status::error
+ * with errno EPIPE instead of raising SIGPIPE (MSG_NOSIGNAL, or
+ * SO_NOSIGPIPE where that is what the platform offers). Pipes and FIFOs
+ * have no such flag: a process writing to them should ignore SIGPIPE
+ * to get the same error instead of being terminated.
+ *
+ * Usage:
+ *   zuu::io::frame_writer<256> out(fd);
+ *   out.push("hello");
+ *   out.push(msg);                    // any string_view / fstring
+ *   out.flush();
+ *
+ *   zuu::io::frame_reader<256> in(fd);
+ *   while (auto f = in.next()) handle(f.data);   // view into the buffer
+ *
+ *   in.poll([](std::string_view m) { handle(m); });  // one read, all frames
+ */
+
+#if defined(_WIN32)
+#error "zuu/io/frame.hpp requires POSIX file descriptors"
+#endif
+
+#include "../core/core.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#include <utility>
+
+namespace zuu::io {
+
+// ==================== Status ====================
+
+enum class frame_status {
+    ok,         // a frame (or the whole batch) was transferred
+    again,      // non-blocking fd would block; call again later
+    closed,     // peer closed (EOF); a trailing partial frame is dropped
+    oversized,  // frame longer than Cap; its payload is skipped
+    error       // read/write failed, see errno
+};
+
+struct frame {
+    std::string_view data;
+    frame_status status = frame_status::ok;
+
+    [[nodiscard]] explicit operator bool() const noexcept { return status == frame_status::ok; }
+};
+
+inline constexpr std::size_t frame_header = 4;
+
+namespace detail {
+
+inline void put_length(unsigned char* p, std::uint32_t n) noexcept {
+    p[0] = static_cast<unsigned char>(n);
+    p[1] = static_cast<unsigned char>(n >> 8);
+    p[2] = static_cast<unsigned char>(n >> 16);
+    p[3] = static_cast<unsigned char>(n >> 24);
+}
+
+inline std::uint32_t get_length(const char* p) noexcept {
+    const auto* u = reinterpret_cast<const unsigned char*>(p);
+    return std::uint32_t(u[0]) | std::uint32_t(u[1]) << 8 | std::uint32_t(u[2]) << 16 | std::uint32_t(u[3]) << 24;
+}
+
+inline frame_status errno_status() noexcept {
+    return (errno == EAGAIN || errno == EWOULDBLOCK) ? frame_status::again : frame_status::error;
+}
+
+} // namespace detail
+
+// ==================== Reader ====================
+
+/**
+ * @brief Pulls frames of at most Cap bytes from an fd
+ * Views stay valid until the next call to next() or poll().
+ */
+template <std::size_t Cap, std::size_t Batch = 64>
+class frame_reader {
+    static_assert(Cap > 0 && Cap <= 0xffffffffu, "frame capacity must fit the 32-bit prefix");
+    static_assert(Batch > 0, "reader needs room for at least one frame");
+
+public:
+    static constexpr std::size_t buffer_size = Batch * (frame_header + Cap);
+
+    explicit frame_reader(int fd)
+        : fd_(fd), buf_(std::make_unique_for_overwrite<char[]>(buffer_size)) {}
+
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+    /// Bytes received but not yet handed out
+    [[nodiscard]] std::size_t buffered() const noexcept { return tail_ - head_; }
+
+    /// Next frame; reads from the fd only when no complete frame is buffered
+    [[nodiscard]] frame next() {
+        for (;;) {
+            if (frame f = parse(); f.status != frame_status::again) return f;
+            if (const frame_status s = fill(); s != frame_status::ok) return {{}, s};
+        }
+    }
+
+    /**
+     * @brief One read, then every complete frame to fn(view)
+     * Returns the number of frames delivered and, via `status`, the
+     * outcome of the read (or `oversized` if a frame was skipped).
+     */
+    template <typename Fn>
+    std::size_t poll(Fn&& fn, frame_status* status = nullptr) {
+        frame_status s = frame_status::ok;
+        std::size_t n = drain(fn, s);
+        if (n == 0 && s == frame_status::ok) {
+            s = fill();
+            if (s == frame_status::ok) n = drain(fn, s);
+        }
+        if (status) *status = s;
+        return n;
+    }
+
+private:
+    // A complete frame at head_, `oversized` after dropping a header,
+    // or `again` when more bytes are needed
+    frame parse() noexcept {
+        if (skip_ > 0) {
+            const std::size_t k = std::min(skip_, tail_ - head_);
+            head_ += k;
+            skip_ -= k;
+            if (skip_ > 0) return {{}, frame_status::again};
+        }
+        if (tail_ - head_ < frame_header) return {{}, frame_status::again};
+        const std::uint32_t len = detail::get_length(buf_.get() + head_);
+        if (len > Cap) {
+            head_ += frame_header;
+            skip_ = len;
+            return {{}, frame_status::oversized};
+        }
+        if (tail_ - head_ < frame_header + len) return {{}, frame_status::again};
+        const std::string_view v(buf_.get() + head_ + frame_header, len);
+        head_ += frame_header + len;
+        return {v, frame_status::ok};
+    }
+
+    template <typename Fn>
+    std::size_t drain(Fn& fn, frame_status& s) {
+        std::size_t n = 0;
+        for (frame f = parse(); f.status != frame_status::again; f = parse()) {
+            if (f) { fn(f.data); ++n; }
+            else s = f.status;
+        }
+        return n;
+    }
+
+    frame_status fill() noexcept {
+        if (head_ == tail_) {
+            head_ = tail_ = 0;
+        } else if (head_ > 0) {
+            // At most one partial frame remains; move it to the front
+            std::memmove(buf_.get(), buf_.get() + head_, tail_ - head_);
+            tail_ -= head_;
+            head_ = 0;
+        }
+        for (;;) {
+            const ssize_t r = ::read(fd_, buf_.get() + tail_, buffer_size - tail_);
+            if (r > 0) { tail_ += static_cast<std::size_t>(r); return frame_status::ok; }
+            if (r == 0) return frame_status::closed;
+            if (errno != EINTR) return detail::errno_status();
+        }
+    }
+
+    int fd_;
+    std::unique_ptr<char[]> buf_;
+    std::size_t head_ = 0;
+    std::size_t tail_ = 0;
+    std::size_t skip_ = 0;   // payload bytes left of an oversized frame
+};
+
+// ==================== Writer ====================
+
+/**
+ * @brief Batches frames of at most Cap bytes into one writev per ring
+ * Longer payloads are truncated to Cap, like every fstring operation.
+ * The destructor flushes what is pending.
+ */
+template <std::size_t Cap, std::size_t Batch = 64>
+class frame_writer {
+    static_assert(Cap > 0 && Cap <= 0xffffffffu, "frame capacity must fit the 32-bit prefix");
+    static_assert(Batch > 0 && Batch <= 512, "two iovecs per frame must stay within IOV_MAX");
+
+public:
+    using slot_type = basic_fstring<char, Cap>;
+
+    explicit frame_writer(int fd)
+        : fd_(fd), slots_(std::make_unique<slot_type[]>(Batch)) {
+#if !defined(MSG_NOSIGNAL) && defined(SO_NOSIGPIPE)
+        // No per-call flag: set it on the socket (fails harmlessly on other fds)
+        const int on = 1;
+        (void)::setsockopt(fd_, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    }
+
+    frame_writer(const frame_writer&) = delete;
+    frame_writer& operator=(const frame_writer&) = delete;
+
+    ~frame_writer() { (void)flush(); }
+
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+    [[nodiscard]] std::size_t pending() const noexcept { return count_; }
+
+    /// Queue a frame; sends the ring first if it is full. Anything but
+    /// `ok` means the frame was not queued.
+    frame_status push(std::string_view msg) {
+        if (count_ == Batch) {
+            if (const frame_status s = flush(); s != frame_status::ok) return s;
+        }
+        slots_[count_].clear();
+        slots_[count_].append(msg.data(), msg.size());
+        detail::put_length(headers_[count_], static_cast<std::uint32_t>(slots_[count_].size()));
+        ++count_;
+        return frame_status::ok;
+    }
+
+    /// Send every queued frame; on `again`, call flush() again when writable
+    frame_status flush() noexcept {
+        while (count_ > 0) {
+            iovec iov[2 * Batch];
+            int n = 0;
+            std::size_t skip = sent_;
+            for (std::size_t i = 0; i < count_; ++i) {
+                const std::pair<const void*, std::size_t> parts[2] = {
+                    {headers_[i], frame_header}, {slots_[i].data(), slots_[i].size()}};
+                for (const auto& [p, len] : parts) {
+                    if (skip >= len) { skip -= len; continue; }
+                    iov[n++] = {const_cast<char*>(static_cast<const char*>(p)) + skip, len - skip};
+                    skip = 0;
+                }
+            }
+            const ssize_t w = send(iov, n);
+            if (w < 0) {
+                if (errno == EINTR) continue;
+                return detail::errno_status();
+            }
+            sent_ += static_cast<std::size_t>(w);
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < count_; ++i) total += frame_header + slots_[i].size();
+            if (sent_ == total) count_ = sent_ = 0;
+        }
+        return frame_status::ok;
+    }
+
+private:
+    // sendmsg on sockets so a closed peer is EPIPE, not SIGPIPE; writev otherwise
+    ssize_t send(iovec* iov, int n) noexcept {
+#if defined(MSG_NOSIGNAL)
+        if (socket_) {
+            msghdr msg{};
+            msg.msg_iov = iov;
+            msg.msg_iovlen = static_cast<decltype(msg.msg_iovlen)>(n);
+            const ssize_t w = ::sendmsg(fd_, &msg, MSG_NOSIGNAL);
+            if (w >= 0 || errno != ENOTSOCK) return w;
+            socket_ = false;
+        }
+#endif
+        return ::writev(fd_, iov, n);
+    }
+
+    int fd_;
+#if defined(MSG_NOSIGNAL)
+    bool socket_ = true;   // until sendmsg reports ENOTSOCK
+#endif
+    std::unique_ptr<slot_type[]> slots_;
+    unsigned char headers_[Batch][frame_header]{};
+    std::size_t count_ = 0;
+    std::size_t sent_ = 0;   // bytes of the current batch already written
+};
+
+} // namespace zuu::io
@@ -0,0 +1,306 @@
+#pragma once
+
+/**
+ * @file zuu/io/http.hpp
+ * @brief Zero-copy, incremental HTTP/1.x request head parser
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::http::request_parser parser;
+ *   zuu::http::request<> req;
+ *   switch (parser.parse(received, req)) {
+ *   case zuu::http::parse_status::complete:
+ *       route(req.method, req.target);
+ *       if (auto host = req.get(zuu::http::field::host)) ...
+ *       body_starts_at(req.head_size);
+ *       break;
+ *   case zuu::http::parse_status::partial: read_more(); break;   // then parse the grown buffer
+ *   default: reply_400();
+ *   }
+ *
+ * Every string in the result is a view into the caller's buffer. Line
+ * ends are found with the SIMD character kernels, and each call resumes
+ * scanning where the previous one stopped, so a head trickling in over
+ * many reads is scanned once. Well-known header names are interned
+ * case-insensitively into `field` through a compile-time perfect hash,
+ * so lookups compare one byte instead of strings.
+ *
+ * Accepts CRLF or bare LF line ends and skips leading empty lines;
+ * rejects obsolete header folding and control characters.
+ */
+
+#include "../core/simd.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+
+namespace zuu::http {
+
+// ==================== Well-Known Fields ====================
+
+enum class field : std::uint8_t {
+    unknown,
+    accept, accept_charset, accept_encoding, accept_language,
+    authorization, cache_control, connection, content_encoding,
+    content_length, content_type, cookie, date, expect, forwarded,
+    host, if_match, if_modified_since, if_none_match,
+    if_unmodified_since, keep_alive, origin, pragma, range, referer,
+    sec_websocket_key, sec_websocket_version, te, transfer_encoding,
+    upgrade, user_agent, x_forwarded_for, x_forwarded_proto,
+    x_real_ip, x_request_id
+};
+
+/// Canonical (lowercase) name of each field, indexed by its value
+inline constexpr std::array<std::string_view, 35> field_names = {
+    "",
+    "accept", "accept-charset", "accept-encoding", "accept-language",
+    "authorization", "cache-control", "connection", "content-encoding",
+    "content-length", "content-type", "cookie", "date", "expect", "forwarded",
+    "host", "if-match", "if-modified-since", "if-none-match",
+    "if-unmodified-since", "keep-alive", "origin", "pragma", "range", "referer",
+    "sec-websocket-key", "sec-websocket-version", "te", "transfer-encoding",
+    "upgrade", "user-agent", "x-forwarded-for", "x-forwarded-proto",
+    "x-real-ip", "x-request-id"
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr std::uint32_t lower_byte(char c) noexcept {
+    const auto u = static_cast<unsigned char>(c);
+    return (u >= 'A' && u <= 'Z') ? u + 0x20u : u;
+}
+
+// Length and three case-folded bytes; distinct for every field name
+[[nodiscard]] constexpr std::uint32_t field_key(std::string_view s) noexcept {
+    return static_cast<std::uint32_t>(s.size()) ^ lower_byte(s[0]) << 8 ^
+           lower_byte(s[s.size() / 2]) << 16 ^ lower_byte(s[s.size() - 1]) << 24;
+}
+
+struct field_hash {
+    static constexpr unsigned bits = 7;
+    std::uint32_t mul = 0;
+    std::array<std::uint8_t, std::size_t{1} << bits> slot{};   // field value, 0 = none
+
+    [[nodiscard]] constexpr std::size_t index(std::uint32_t key) const noexcept {
+        return (key * mul) >> (32 - bits);
+    }
+};
+
+// First odd multiplier that maps every name to its own slot
+consteval field_hash make_field_hash() {
+    for (std::uint32_t mul = 0x9e3779b1u; mul != 0x9e3779b1u + 2 * 100000; mul += 2) {
+        field_hash h{mul, {}};
+        bool ok = true;
+        for (std::size_t f = 1; f < field_names.size() && ok; ++f) {
+            auto& s = h.slot[h.index(field_key(field_names[f]))];
+            ok = s == 0;
+            s = static_cast<std::uint8_t>(f);
+        }
+        if (ok) return h;
+    }
+    throw "no perfect hash for the field names";
+}
+
+inline constexpr field_hash field_table = make_field_hash();
+
+// RFC 9110 tchar
+inline constexpr auto token_chars = [] {
+    std::array<bool, 256> t{};
+    for (int c = '0'; c <= '9'; ++c) t[c] = true;
+    for (int c = 'a'; c <= 'z'; ++c) t[c] = t[c - 0x20] = true;
+    for (const char c : std::string_view{"!#$%&'*+-.^_`|~"}) t[static_cast<unsigned char>(c)] = true;
+    return t;
+}();
+
+[[nodiscard]] constexpr bool is_token(char c) noexcept {
+    return token_chars[static_cast<unsigned char>(c)];
+}
+
+[[nodiscard]] constexpr std::size_t token_length(const char* p, std::size_t n) noexcept {
+    std::size_t i = 0;
+    while (i < n && is_token(p[i])) ++i;
+    return i;
+}
+
+// Length of a field value: HTAB, SP..~ and obs-text (>= 0x80)
+[[nodiscard]] constexpr std::size_t value_length(const char* p, std::size_t n) noexcept {
+    constexpr char lo[] = {'\t', ' '};
+    constexpr char hi[] = {'\t', '~'};
+    std::size_t i = 0;
+    for (;;) {
+        i += simd::span_ranges(p + i, n - i, lo, hi, 2);
+        if (i == n || static_cast<unsigned char>(p[i]) < 0x80) return i;
+        ++i;
+    }
+}
+
+} // namespace detail
+
+/// Interns a header name, ignoring ASCII case; `unknown` if not well-known
+[[nodiscard]] constexpr field lookup_field(std::string_view name) noexcept {
+    if (name.empty()) return field::unknown;
+    const auto& t = detail::field_table;
+    const std::uint8_t f = t.slot[t.index(detail::field_key(name))];
+    const std::string_view canon = field_names[f];
+    if (f == 0 || canon.size() != name.size() ||
+        !simd::equal_ignore_case(canon.data(), name.data(), name.size())) {
+        return field::unknown;
+    }
+    return static_cast<field>(f);
+}
+
+// ==================== Request ====================
+
+struct header {
+    field id = field::unknown;
+    std::string_view name;    // as sent
+    std::string_view value;   // without surrounding whitespace
+};
+
+enum class parse_status {
+    complete,          // the head is parsed; the body starts at head_size
+    partial,           // no blank line yet; call again with more bytes
+    invalid,           // malformed request line or header
+    too_many_headers   // more than MaxHeaders header lines
+};
+
+template <std::size_t MaxHeaders = 64>
+struct request {
+    std::string_view method;
+    std::string_view target;
+    int minor_version = 0;               // HTTP/1.<minor_version>
+    std::size_t head_size = 0;           // bytes up to and including the blank line
+    std::array<header, MaxHeaders> fields{};
+    std::size_t field_count = 0;
+
+    [[nodiscard]] std::span<const header> headers() const noexcept {
+        return {fields.data(), field_count};
+    }
+
+    /// Value of the first header with this id
+    [[nodiscard]] std::optional<std::string_view> get(field id) const noexcept {
+        for (const header& h : headers()) {
+            if (h.id == id) return h.value;
+        }
+        return std::nullopt;
+    }
+
+    /// Value of the first header with this name, ignoring ASCII case
+    [[nodiscard]] std::optional<std::string_view> get(std::string_view name) const noexcept {
+        if (const field id = lookup_field(name); id != field::unknown) return get(id);
+        for (const header& h : headers()) {
+            if (h.id == field::unknown && h.name.size() == name.size() &&
+                simd::equal_ignore_case(h.name.data(), name.data(), name.size())) {
+                return h.value;
+            }
+        }
+        return std::nullopt;
+    }
+};
+
+// ==================== Parser ====================
+
+/**
+ * @brief Incremental request head parser
+ * While the result is `partial`, pass the whole buffer received so far
+ * on every call; only bytes not yet scanned are searched for the end of
+ * the head. Any other result leaves the parser ready for the next
+ * request (e.g. the bytes after head_size plus the body).
+ */
+class request_parser {
+public:
+    template <std::size_t MaxHeaders>
+    parse_status parse(std::string_view buf, request<MaxHeaders>& out) noexcept {
+        const char* p = buf.data();
+        const std::size_t n = buf.size();
+
+        // Leading empty lines are ignored (RFC 9112 section 2.2)
+        std::size_t start = 0;
+        while (start < n && (p[start] == '\r' || p[start] == '\n')) ++start;
+        if (scanned_ < start) scanned_ = start;
+
+        // Find the blank line, resuming at the last undecided '\n'
+        std::size_t end = 0;
+        for (std::size_t i = scanned_;;) {
+            const std::size_t nl = simd::find_char(p + i, n - i, '\n');
+            if (nl == simd::npos) {
+                scanned_ = n;
+                return parse_status::partial;
+            }
+            i += nl;
+            if (i + 1 < n && p[i + 1] == '\n') { end = i + 2; break; }
+            if (i + 2 < n && p[i + 1] == '\r' && p[i + 2] == '\n') { end = i + 3; break; }
+            if (i + 1 >= n || (i + 2 >= n && p[i + 1] == '\r')) {
+                scanned_ = i;
+                return parse_status::partial;
+            }
+            ++i;
+        }
+        scanned_ = 0;
+        return parse_head(p + start, end - start, start, out);
+    }
+
+    void reset() noexcept { scanned_ = 0; }
+
+private:
+    // Consumes a line end at p[i]; false if none is there
+    static constexpr bool eol(const char* p, std::size_t n, std::size_t& i) noexcept {
+        if (i < n && p[i] == '\n') { ++i; return true; }
+        if (i + 1 < n && p[i] == '\r' && p[i + 1] == '\n') { i += 2; return true; }
+        return false;
+    }
+
+    template <std::size_t MaxHeaders>
+    static parse_status parse_head(const char* p, std::size_t n, std::size_t offset,
+                                   request<MaxHeaders>& out) noexcept {
+        // Request line: method SP target SP HTTP/1.x
+        std::size_t i = detail::token_length(p, n);
+        if (i == 0 || i == n || p[i] != ' ') return parse_status::invalid;
+        out.method = {p, i};
+
+        const std::size_t t = ++i;
+        constexpr char vis_lo[] = {'!'};
+        constexpr char vis_hi[] = {'~'};
+        i += simd::span_ranges(p + i, n - i, vis_lo, vis_hi, 1);
+        if (i == t || i == n || p[i] != ' ') return parse_status::invalid;
+        out.target = {p + t, i - t};
+
+        constexpr std::string_view http1 = "HTTP/1.";
+        ++i;
+        if (n - i < http1.size() + 1 || std::string_view{p + i, http1.size()} != http1) return parse_status::invalid;
+        i += http1.size();
+        if (p[i] < '0' || p[i] > '9') return parse_status::invalid;
+        out.minor_version = p[i++] - '0';
+        if (!eol(p, n, i)) return parse_status::invalid;
+
+        // Header lines until the blank one
+        out.field_count = 0;
+        while (!eol(p, n, i)) {
+            const std::size_t colon = simd::find_char(p + i, n - i, ':');
+            if (colon == simd::npos || colon == 0 || detail::token_length(p + i, colon) != colon) {
+                return parse_status::invalid;   // also rejects folded lines and stray line ends
+            }
+            const std::string_view name{p + i, colon};
+            i += colon + 1;
+            while (i < n && (p[i] == ' ' || p[i] == '\t')) ++i;
+
+            const std::size_t v = i;
+            i += detail::value_length(p + i, n - i);
+            std::size_t ve = i;
+            while (ve > v && (p[ve - 1] == ' ' || p[ve - 1] == '\t')) --ve;
+            if (!eol(p, n, i)) return parse_status::invalid;
+
+            if (out.field_count == MaxHeaders) return parse_status::too_many_headers;
+            out.fields[out.field_count++] = {lookup_field(name), name, {p + v, ve - v}};
+        }
+        out.head_size = offset + i;
+        return parse_status::complete;
+    }
+
+    std::size_t scanned_ = 0;
+};
+
+} // namespace zuu::http
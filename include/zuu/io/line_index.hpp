@@ -0,0 +1,257 @@
+#pragma once
+
+/**
+ * @file zuu/io/line_index.hpp
+ * @brief Parallel newline index for random line access into large buffers
+ * @version 3.0.0
+ *
+ * Usage:
+ *   std::string_view log = mapped_file();            // e.g. an mmap
+ *   auto idx = zuu::io::line_index::build(log);       // every line start
+ *   std::string_view l = idx.line(123456);            // O(1)
+ *   zuu::fstring<256> copy(l);                        // own it on demand
+ *
+ *   // Every 64th line only: 64x smaller, line(i) scans < 64 lines
+ *   auto sparse = zuu::io::line_index::build(log, {.stride = 64});
+ *
+ *   idx.save("app.log.idx");
+ *   auto again = zuu::io::line_index::load("app.log.idx", log);  // optional
+ *
+ * The buffer is cut into chunks that count their newlines in parallel
+ * with the SIMD kernels; a prefix sum over the counts gives each chunk
+ * its first line number, and a second parallel pass writes the line
+ * starts straight into the final array from 64-byte newline bitmaps.
+ *
+ * Lines end at '\n' (a preceding '\r' is dropped from the view); a
+ * trailing newline does not start an empty last line. The index stores
+ * a view of the buffer, which must outlive it.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include "../core/parallel.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace zuu::io {
+
+struct line_index_options {
+    std::size_t stride = 1;              // keep the start of every stride-th line
+    std::size_t threads = 0;             // 0 = all hardware threads
+    std::size_t min_chunk = 1u << 20;    // bytes per task, lower bound
+};
+
+namespace detail {
+
+inline constexpr char line_index_magic[4] = {'Z', 'L', 'I', 'X'};
+inline constexpr std::uint32_t line_index_version = 1;
+inline constexpr std::size_t fingerprint_span = 4096;
+
+// Size plus the first and last 4 KiB: catches the usual stale-index cases
+// (file appended to, rotated or rewritten) without reading the whole file
+[[nodiscard]] inline std::uint64_t fingerprint(std::string_view buf) noexcept {
+    const std::size_t k = std::min(buf.size(), fingerprint_span);
+    const std::uint64_t head = hash_chars(buf.data(), k, buf.size());
+    return hash_chars(buf.data() + buf.size() - k, k, head);
+}
+
+} // namespace detail
+
+// ==================== Line Index ====================
+
+/**
+ * @brief Start offsets of every stride-th line of a buffer
+ * Offset is the stored integer type: std::uint32_t halves the index of
+ * buffers below 4 GiB; longer buffers are indexed up to what it can
+ * address, like every other fixed-capacity truncation.
+ */
+template <std::unsigned_integral Offset = std::uint64_t>
+class basic_line_index {
+public:
+    using offset_type = Offset;
+
+    basic_line_index() = default;
+
+    static basic_line_index build(std::string_view buf, const line_index_options& opt = {}) {
+        basic_line_index idx;
+        if (buf.size() > std::numeric_limits<Offset>::max()) buf = buf.substr(0, std::numeric_limits<Offset>::max());
+        idx.buf_ = buf;
+        idx.stride_ = std::clamp<std::size_t>(opt.stride, 1, 0xffffffffu);
+        const std::size_t n = buf.size();
+        if (n == 0) return idx;
+
+        // Chunk bounds are 64-byte aligned so bitmaps never straddle two tasks
+        const std::size_t chunk = (std::max<std::size_t>(opt.min_chunk, 64) + 63) & ~std::size_t{63};
+        const std::size_t tasks = (n + chunk - 1) / chunk;
+
+        std::vector<std::size_t> newlines(tasks + 1, 0);
+        par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) {
+            const std::size_t b = t * chunk;
+            newlines[t + 1] = simd::count_char(buf.data() + b, std::min(chunk, n - b), '\n');
+        });
+        for (std::size_t t = 0; t < tasks; ++t) newlines[t + 1] += newlines[t];
+
+        idx.lines_ = newlines[tasks] + (buf.back() != '\n');
+        idx.offsets_.resize((idx.lines_ + idx.stride_ - 1) / idx.stride_);
+        idx.offsets_[0] = 0;
+
+        par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) {
+            idx.fill(t * chunk, std::min(n, (t + 1) * chunk), newlines[t]);
+        });
+        return idx;
+    }
+
+    // ==================== Access ====================
+
+    /// Number of lines
+    [[nodiscard]] std::size_t size() const noexcept { return lines_; }
+    [[nodiscard]] bool empty() const noexcept { return lines_ == 0; }
+    [[nodiscard]] std::size_t stride() const noexcept { return stride_; }
+    [[nodiscard]] std::string_view buffer() const noexcept { return buf_; }
+
+    /// Stored offsets: sample k is the start of line k * stride()
+    [[nodiscard]] std::span<const Offset> samples() const noexcept { return offsets_; }
+
+    /// Byte offset where line i starts
+    [[nodiscard]] std::size_t offset(std::size_t i) const noexcept {
+        std::size_t at = offsets_[i / stride_];
+        for (std::size_t k = i % stride_; k > 0; --k) at += simd::find_char(buf_.data() + at, buf_.size() - at, '\n') + 1;
+        return at;
+    }
+
+    /// Line i without its line ending; a view into the buffer
+    [[nodiscard]] std::string_view line(std::size_t i) const noexcept {
+        const std::size_t b = offset(i);
+        std::size_t e;
+        if (stride_ == 1 && i + 1 < lines_) {
+            e = offsets_[i + 1] - 1;
+        } else {
+            const std::size_t nl = simd::find_char(buf_.data() + b, buf_.size() - b, '\n');
+            e = nl == simd::npos ? buf_.size() : b + nl;
+        }
+        if (e > b && buf_[e - 1] == '\r') --e;
+        return buf_.substr(b, e - b);
+    }
+
+    [[nodiscard]] std::string_view operator[](std::size_t i) const noexcept { return line(i); }
+
+    // ==================== Persistence ====================
+
+    /**
+     * @brief Writes the index to `path`
+     * Layout (little-endian): "ZLIX", u32 version, u32 offset width,
+     * u32 stride, u64 buffer size, u64 fingerprint, u64 lines, then the
+     * offsets.
+     */
+    bool save(const char* path) const {
+        std::FILE* f = std::fopen(path, "wb");
+        if (!f) return false;
+        unsigned char head[4 + 3 * 4 + 3 * 8];
+        std::copy_n(detail::line_index_magic, 4, head);
+        put(head + 4, detail::line_index_version, 4);
+        put(head + 8, sizeof(Offset), 4);
+        put(head + 12, stride_, 4);
+        put(head + 16, buf_.size(), 8);
+        put(head + 24, detail::fingerprint(buf_), 8);
+        put(head + 32, lines_, 8);
+
+        bool ok = std::fwrite(head, 1, sizeof(head), f) == sizeof(head);
+        unsigned char block[8 * 512];
+        for (std::size_t i = 0; ok && i < offsets_.size();) {
+            const std::size_t k = std::min<std::size_t>(512, offsets_.size() - i);
+            for (std::size_t j = 0; j < k; ++j) put(block + j * sizeof(Offset), offsets_[i + j], sizeof(Offset));
+            ok = std::fwrite(block, sizeof(Offset), k, f) == k;
+            i += k;
+        }
+        return std::fclose(f) == 0 && ok;
+    }
+
+    /**
+     * @brief Reads an index saved for `buf`
+     * Empty if the file is missing, malformed, of another Offset width,
+     * or was built for a buffer of different size or fingerprint.
+     */
+    static std::optional<basic_line_index> load(const char* path, std::string_view buf) {
+        std::FILE* f = std::fopen(path, "rb");
+        if (!f) return std::nullopt;
+        std::optional<basic_line_index> result = read(f, buf);
+        std::fclose(f);
+        return result;
+    }
+
+private:
+    void fill(std::size_t b, std::size_t e, std::size_t line) noexcept {
+        const std::size_t n = buf_.size();
+        std::size_t countdown = stride_ - line % stride_;
+        for (std::size_t base = b; base < e; base += 64) {
+            for (std::uint64_t m = simd::match_mask(buf_.data() + base, e - base, '\n'); m; m &= m - 1) {
+                ++line;
+                if (--countdown == 0) {
+                    countdown = stride_;
+                    const std::size_t start = base + static_cast<std::size_t>(std::countr_zero(m)) + 1;
+                    if (start < n) offsets_[line / stride_] = static_cast<Offset>(start);
+                }
+            }
+        }
+    }
+
+    static void put(unsigned char* p, std::uint64_t v, std::size_t width) noexcept {
+        for (std::size_t k = 0; k < width; ++k) p[k] = static_cast<unsigned char>(v >> (8 * k));
+    }
+
+    static std::uint64_t get(const unsigned char* p, std::size_t width) noexcept {
+        std::uint64_t v = 0;
+        for (std::size_t k = 0; k < width; ++k) v |= std::uint64_t(p[k]) << (8 * k);
+        return v;
+    }
+
+    static std::optional<basic_line_index> read(std::FILE* f, std::string_view buf) {
+        if (buf.size() > std::numeric_limits<Offset>::max()) buf = buf.substr(0, std::numeric_limits<Offset>::max());
+        unsigned char head[4 + 3 * 4 + 3 * 8];
+        if (std::fread(head, 1, sizeof(head), f) != sizeof(head) ||
+            !std::equal(head, head + 4, detail::line_index_magic) ||
+            get(head + 4, 4) != detail::line_index_version || get(head + 8, 4) != sizeof(Offset) ||
+            get(head + 16, 8) != buf.size() || get(head + 24, 8) != detail::fingerprint(buf)) {
+            return std::nullopt;
+        }
+        basic_line_index idx;
+        idx.buf_ = buf;
+        idx.stride_ = static_cast<std::size_t>(get(head + 12, 4));
+        idx.lines_ = static_cast<std::size_t>(get(head + 32, 8));
+        if (idx.stride_ == 0 || idx.lines_ > buf.size()) return std::nullopt;
+        idx.offsets_.resize((idx.lines_ + idx.stride_ - 1) / idx.stride_);
+
+        // Offsets must rise within the buffer, each right after a newline
+        unsigned char block[8 * 512];
+        for (std::size_t i = 0; i < idx.offsets_.size();) {
+            const std::size_t k = std::min<std::size_t>(512, idx.offsets_.size() - i);
+            if (std::fread(block, sizeof(Offset), k, f) != k) return std::nullopt;
+            for (std::size_t j = 0; j < k; ++j, ++i) {
+                const std::uint64_t v = get(block + j * sizeof(Offset), sizeof(Offset));
+                if (i == 0 ? v != 0 : (v <= idx.offsets_[i - 1] || v >= buf.size() || buf[v - 1] != '\n')) {
+                    return std::nullopt;
+                }
+                idx.offsets_[i] = static_cast<Offset>(v);
+            }
+        }
+        if (std::fgetc(f) != EOF) return std::nullopt;
+        return idx;
+    }
+
+    std::string_view buf_;
+    std::vector<Offset> offsets_;
+    std::size_t stride_ = 1;
+    std::size_t lines_ = 0;
+};
+
+using line_index = basic_line_index<std::uint64_t>;
+using line_index32 = basic_line_index<std::uint32_t>;
+
+} // namespace zuu::io
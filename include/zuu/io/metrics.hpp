@@ -0,0 +1,616 @@
+#pragma once
+
+/**
+ * @file zuu/io/metrics.hpp
+ * @brief Influx line protocol and StatsD encoders and zero-copy decoders
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::fstring<8192> batch;
+ *   using zuu::metrics::tag, zuu::metrics::field;
+ *   zuu::metrics::encode_influx(batch, "cpu", {{"region", "eu"}, {"host", "a"}},
+ *                               {{"usage", 0.5}, {"cores", 8}}, ts_ns);
+ *   // cpu,host=a,region=eu usage=0.5,cores=8i 1700000000000000000\n
+ *   zuu::metrics::encode_statsd(batch, "api.requests", 1, zuu::metrics::statsd_type::counter,
+ *                               {{"route", "/users"}});
+ *   // api.requests:1|c|#route:/users\n
+ *   if (!encode_influx(batch, ...)) { send(batch); batch.clear(); ... }   // full: flush, retry
+ *
+ *   // Aggregator side: every string is a view into the received datagram
+ *   zuu::metrics::decode_influx_batch(datagram, [&](const auto& point) {
+ *       for (const field& f : point.fields()) ...
+ *   });
+ *
+ * Encoders append one complete line per call or nothing: when the line
+ * does not fit, the buffer is left as it was and false is returned, so
+ * many points batch into one fstring without torn lines. Tags are
+ * written sorted by key, giving every series one canonical spelling.
+ * Special characters are found with the SIMD set kernels and escaped
+ * (Influx) or replaced by '_' (StatsD, which has no escaping). Integers
+ * and timestamps use fmt::formatter; floats use the shortest form that
+ * reads back exactly.
+ *
+ * Decoded names, tags and string values are views of the escaped wire
+ * text (unescape() copies one out when needed).
+ */
+
+#include "../core/core.hpp"
+#include "../core/simd.hpp"
+#include "../fmt/core.hpp"
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <concepts>
+#include <cstdint>
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <utility>
+
+namespace zuu::metrics {
+
+// ==================== Points ====================
+
+struct tag {
+    std::string_view key;
+    std::string_view value;
+};
+
+enum class value_kind : std::uint8_t { f64, i64, u64, boolean, string };
+
+struct field {
+    std::string_view key;
+    value_kind kind = value_kind::f64;
+    double f64 = 0;
+    std::int64_t i64 = 0;
+    std::uint64_t u64 = 0;
+    bool boolean = false;
+    std::string_view string;
+
+    constexpr field() noexcept = default;
+    constexpr field(std::string_view k, double v) noexcept : key(k), kind(value_kind::f64), f64(v) {}
+    constexpr field(std::string_view k, bool v) noexcept : key(k), kind(value_kind::boolean), boolean(v) {}
+    constexpr field(std::string_view k, std::string_view v) noexcept : key(k), kind(value_kind::string), string(v) {}
+    constexpr field(std::string_view k, const char* v) noexcept : field(k, std::string_view{v}) {}
+
+    template <std::signed_integral T>
+    constexpr field(std::string_view k, T v) noexcept : key(k), kind(value_kind::i64), i64(v) {}
+
+    template <std::unsigned_integral T>
+        requires (!std::same_as<T, bool>)
+    constexpr field(std::string_view k, T v) noexcept : key(k), kind(value_kind::u64), u64(v) {}
+};
+
+enum class statsd_type : std::uint8_t { counter, gauge, timing, histogram, set, distribution };
+
+/// Wire code of each statsd_type, indexed by its value
+inline constexpr std::array<std::string_view, 6> statsd_codes = {"c", "g", "ms", "h", "s", "d"};
+
+/// Nanoseconds since the Unix epoch, the default Influx timestamp precision
+[[nodiscard]] inline std::int64_t unix_nanos(std::chrono::system_clock::time_point t) noexcept {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+}
+
+namespace detail {
+
+inline constexpr std::size_t max_sorted_tags = 64;
+
+// Characters escaped per Influx element; a newline can never be written.
+// Backslashes are escaped too, so a key ending in one reads back intact.
+inline constexpr std::string_view measurement_specials = "\n, \\";
+inline constexpr std::string_view key_specials = "\n,= \\";
+inline constexpr std::string_view string_specials = "\n\"\\";
+
+// StatsD has no escaping: these become '_'
+inline constexpr std::string_view statsd_name_specials = "\n:|@";
+inline constexpr std::string_view statsd_key_specials = "\n:,|";
+inline constexpr std::string_view statsd_tag_specials = "\n,|";
+
+/// Appends to `out` only if the whole line fits
+template <std::size_t Cap>
+class line_writer {
+public:
+    explicit constexpr line_writer(basic_fstring<char, Cap>& out) noexcept : out_(out), start_(out.size()) {}
+
+    constexpr void put(const char* p, std::size_t n) noexcept {
+        if (n > out_.available()) {
+            ok_ = false;
+        } else {
+            out_.append(p, n);
+        }
+    }
+
+    constexpr void put(std::string_view s) noexcept { put(s.data(), s.size()); }
+    constexpr void put(char c) noexcept { put(&c, 1); }
+
+    /// Backslash before each special; a newline fails the line
+    constexpr void put_escaped(std::string_view s, std::string_view specials) noexcept {
+        put_filtered(s, specials, '\\');
+    }
+
+    /// Each special (including a newline) replaced by '_'
+    constexpr void put_replaced(std::string_view s, std::string_view specials) noexcept {
+        put_filtered(s, specials, '_');
+    }
+
+    template <std::integral T>
+    constexpr void put_int(T v) noexcept {
+        const auto digits = fmt::formatter<T>::format(v);
+        put(digits.data(), digits.size());
+    }
+
+    // Shortest text that reads back to the same double; non-finite fails
+    void put_float(double v) noexcept {
+        if (!std::isfinite(v)) {
+            ok_ = false;
+            return;
+        }
+        char buf[32];
+        const auto r = std::to_chars(buf, buf + sizeof(buf), v);
+        put(buf, static_cast<std::size_t>(r.ptr - buf));
+    }
+
+    constexpr void fail() noexcept { ok_ = false; }
+
+    /// Ends the line, or rolls the buffer back if anything failed
+    constexpr bool finish() noexcept {
+        put('\n');
+        if (!ok_) out_.resize(start_);
+        return ok_;
+    }
+
+private:
+    constexpr void put_filtered(std::string_view s, std::string_view specials, char mark) noexcept {
+        while (!s.empty()) {
+            const std::size_t at = simd::find_first_of(s.data(), s.size(), specials.data(), specials.size());
+            if (at == simd::npos) {
+                put(s);
+                return;
+            }
+            put(s.data(), at);
+            if (mark == '\\') {
+                if (s[at] == '\n') ok_ = false;
+                put('\\');
+                put(s[at]);
+            } else {
+                put('_');
+            }
+            s.remove_prefix(at + 1);
+        }
+    }
+
+    basic_fstring<char, Cap>& out_;
+    std::size_t start_;
+    bool ok_ = true;
+};
+
+// Tags ordered by key (byte-wise, as Influx canonicalizes them)
+struct sorted_tags {
+    std::array<tag, max_sorted_tags> slots{};
+    std::size_t count = 0;
+
+    explicit sorted_tags(std::span<const tag> tags) noexcept {
+        if (tags.size() > slots.size()) return;
+        count = tags.size();
+        std::copy(tags.begin(), tags.end(), slots.begin());
+        std::sort(slots.begin(), slots.begin() + count,
+                  [](const tag& a, const tag& b) { return a.key < b.key; });
+    }
+};
+
+} // namespace detail
+
+// ==================== Influx Encoder ====================
+
+/**
+ * @brief Appends `measurement,tags fields [timestamp]\n` to `out`
+ * False (and `out` unchanged) if the line does not fit or cannot be
+ * written: no fields, an empty measurement or key, a newline anywhere,
+ * a non-finite float, or more than 64 tags. Tags with empty values are
+ * left out, as Influx does not store them.
+ */
+template <std::size_t Cap>
+bool encode_influx(
+    basic_fstring<char, Cap>& out,
+    std::string_view measurement,
+    std::span<const tag> tags,
+    std::span<const field> fields,
+    std::optional<std::int64_t> timestamp = std::nullopt
+) noexcept {
+    detail::line_writer<Cap> w(out);
+    const detail::sorted_tags sorted(tags);
+    if (measurement.empty() || fields.empty() || sorted.count != tags.size()) w.fail();
+
+    w.put_escaped(measurement, detail::measurement_specials);
+    for (std::size_t i = 0; i < sorted.count; ++i) {
+        const tag& t = sorted.slots[i];
+        if (t.value.empty()) continue;
+        if (t.key.empty()) w.fail();
+        w.put(',');
+        w.put_escaped(t.key, detail::key_specials);
+        w.put('=');
+        w.put_escaped(t.value, detail::key_specials);
+    }
+
+    char sep = ' ';
+    for (const field& f : fields) {
+        if (f.key.empty()) w.fail();
+        w.put(sep);
+        sep = ',';
+        w.put_escaped(f.key, detail::key_specials);
+        w.put('=');
+        switch (f.kind) {
+        case value_kind::f64: w.put_float(f.f64); break;
+        case value_kind::i64: w.put_int(f.i64); w.put('i'); break;
+        case value_kind::u64: w.put_int(f.u64); w.put('u'); break;
+        case value_kind::boolean: w.put(f.boolean ? std::string_view{"true"} : std::string_view{"false"}); break;
+        case value_kind::string:
+            w.put('"');
+            w.put_escaped(f.string, detail::string_specials);
+            w.put('"');
+            break;
+        }
+    }
+
+    if (timestamp) {
+        w.put(' ');
+        w.put_int(*timestamp);
+    }
+    return w.finish();
+}
+
+template <std::size_t Cap>
+bool encode_influx(
+    basic_fstring<char, Cap>& out,
+    std::string_view measurement,
+    std::initializer_list<tag> tags,
+    std::initializer_list<field> fields,
+    std::optional<std::int64_t> timestamp = std::nullopt
+) noexcept {
+    return encode_influx(out, measurement, std::span<const tag>{tags.begin(), tags.size()},
+                         std::span<const field>{fields.begin(), fields.size()}, timestamp);
+}
+
+// ==================== StatsD Encoder ====================
+
+/**
+ * @brief Appends `name:value|type[|@rate][|#k:v,...]\n` to `out`
+ * Tags use the DogStatsD extension and are sorted by key. Characters
+ * StatsD cannot carry become '_'. False (and `out` unchanged) if the
+ * line does not fit, the name is empty, or the value is not finite.
+ */
+template <std::size_t Cap, typename T>
+    requires std::is_arithmetic_v<T> && (!std::same_as<T, bool>)
+bool encode_statsd(
+    basic_fstring<char, Cap>& out,
+    std::string_view name,
+    T value,
+    statsd_type type,
+    std::span<const tag> tags = {},
+    double rate = 1.0
+) noexcept {
+    detail::line_writer<Cap> w(out);
+    const detail::sorted_tags sorted(tags);
+    if (name.empty() || sorted.count != tags.size()) w.fail();
+
+    w.put_replaced(name, detail::statsd_name_specials);
+    w.put(':');
+    if constexpr (std::is_integral_v<T>) {
+        w.put_int(value);
+    } else {
+        w.put_float(static_cast<double>(value));
+    }
+    w.put('|');
+    w.put(statsd_codes[static_cast<std::size_t>(type)]);
+
+    if (rate < 1.0) {
+        w.put("|@");
+        w.put_float(rate);
+    }
+    for (std::size_t i = 0; i < sorted.count; ++i) {
+        const tag& t = sorted.slots[i];
+        w.put(i == 0 ? std::string_view{"|#"} : std::string_view{","});
+        w.put_replaced(t.key, detail::statsd_key_specials);
+        if (!t.value.empty()) {
+            w.put(':');
+            w.put_replaced(t.value, detail::statsd_tag_specials);
+        }
+    }
+    return w.finish();
+}
+
+template <std::size_t Cap, typename T>
+    requires std::is_arithmetic_v<T> && (!std::same_as<T, bool>)
+bool encode_statsd(
+    basic_fstring<char, Cap>& out,
+    std::string_view name,
+    T value,
+    statsd_type type,
+    std::initializer_list<tag> tags,
+    double rate = 1.0
+) noexcept {
+    return encode_statsd(out, name, value, type, std::span<const tag>{tags.begin(), tags.size()}, rate);
+}
+
+// ==================== Decoded Lines ====================
+
+enum class decode_status {
+    ok,
+    invalid,       // malformed line
+    too_many       // more tags or fields than the point holds
+};
+
+template <std::size_t MaxTags = 32, std::size_t MaxFields = 32>
+struct influx_point {
+    std::string_view measurement;
+    std::array<tag, MaxTags> tag_slots{};
+    std::size_t tag_count = 0;
+    std::array<field, MaxFields> field_slots{};
+    std::size_t field_count = 0;
+    std::optional<std::int64_t> timestamp;
+
+    [[nodiscard]] std::span<const tag> tags() const noexcept { return {tag_slots.data(), tag_count}; }
+    [[nodiscard]] std::span<const field> fields() const noexcept { return {field_slots.data(), field_count}; }
+
+    /// Value of the first tag with this (escaped) key
+    [[nodiscard]] std::optional<std::string_view> get_tag(std::string_view key) const noexcept {
+        for (const tag& t : tags()) {
+            if (t.key == key) return t.value;
+        }
+        return std::nullopt;
+    }
+
+    [[nodiscard]] const field* get_field(std::string_view key) const noexcept {
+        for (const field& f : fields()) {
+            if (f.key == key) return &f;
+        }
+        return nullptr;
+    }
+};
+
+template <std::size_t MaxTags = 16>
+struct statsd_metric {
+    std::string_view name;
+    std::string_view value;        // as sent (set members need not be numbers)
+    double number = 0;             // value as a number; 0 if it is not one
+    statsd_type type = statsd_type::counter;
+    double rate = 1.0;
+    std::array<tag, MaxTags> tag_slots{};
+    std::size_t tag_count = 0;
+
+    [[nodiscard]] std::span<const tag> tags() const noexcept { return {tag_slots.data(), tag_count}; }
+};
+
+namespace detail {
+
+/// First of `stops` at or after i not preceded by a backslash, or n
+[[nodiscard]] constexpr std::size_t scan_unescaped(
+    const char* p, std::size_t n, std::size_t i, std::string_view stops
+) noexcept {
+    char set[4] = {'\\'};
+    const std::size_t k = std::min<std::size_t>(stops.size(), 3);
+    std::copy_n(stops.data(), k, set + 1);
+    while (i < n) {
+        const std::size_t at = simd::find_first_of(p + i, n - i, set, k + 1);
+        if (at == simd::npos) return n;
+        i += at;
+        if (p[i] != '\\') return i;
+        i += 2;
+    }
+    return n;
+}
+
+template <typename T>
+[[nodiscard]] bool parse_number(std::string_view s, T& out) noexcept {
+    if (s.empty()) return false;
+    const auto r = std::from_chars(s.data(), s.data() + s.size(), out);
+    return r.ec == std::errc{} && r.ptr == s.data() + s.size();
+}
+
+[[nodiscard]] inline bool parse_field_value(std::string_view s, field& f) noexcept {
+    if (s.empty()) return false;
+    if (s == "t" || s == "T" || s == "true" || s == "True" || s == "TRUE") {
+        f.kind = value_kind::boolean;
+        f.boolean = true;
+        return true;
+    }
+    if (s == "f" || s == "F" || s == "false" || s == "False" || s == "FALSE") {
+        f.kind = value_kind::boolean;
+        f.boolean = false;
+        return true;
+    }
+    if (s.back() == 'i') {
+        f.kind = value_kind::i64;
+        return parse_number(s.substr(0, s.size() - 1), f.i64);
+    }
+    if (s.back() == 'u') {
+        f.kind = value_kind::u64;
+        return parse_number(s.substr(0, s.size() - 1), f.u64);
+    }
+    f.kind = value_kind::f64;
+    return parse_number(s, f.f64) && std::isfinite(f.f64);
+}
+
+// Calls fn(line) for each line that is not blank or a '#' comment
+template <typename Fn>
+void for_each_line(std::string_view batch, Fn&& fn) {
+    while (!batch.empty()) {
+        const std::size_t nl = simd::find_char(batch.data(), batch.size(), '\n');
+        std::string_view line = batch.substr(0, nl);
+        batch.remove_prefix(nl == simd::npos ? batch.size() : nl + 1);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        if (!line.empty() && line.front() != '#') fn(line);
+    }
+}
+
+} // namespace detail
+
+// ==================== Influx Decoder ====================
+
+/**
+ * @brief Parses one line (without its '\n') into `out`
+ * Keys, tag values and string field values stay escaped; quotes around
+ * string values are removed.
+ */
+template <std::size_t MaxTags, std::size_t MaxFields>
+decode_status decode_influx(std::string_view line, influx_point<MaxTags, MaxFields>& out) noexcept {
+    const char* p = line.data();
+    const std::size_t n = line.size();
+    out.tag_count = 0;
+    out.field_count = 0;
+    out.timestamp.reset();
+
+    std::size_t i = detail::scan_unescaped(p, n, 0, ", ");
+    if (i == 0 || i == n) return decode_status::invalid;
+    out.measurement = {p, i};
+
+    while (p[i] == ',') {
+        const std::size_t k = i + 1;
+        const std::size_t eq = detail::scan_unescaped(p, n, k, "=, ");
+        if (eq == k || eq == n || p[eq] != '=') return decode_status::invalid;
+        const std::size_t v = eq + 1;
+        i = detail::scan_unescaped(p, n, v, ", ");
+        if (i == v || i == n) return decode_status::invalid;
+        if (out.tag_count == MaxTags) return decode_status::too_many;
+        out.tag_slots[out.tag_count++] = {{p + k, eq - k}, {p + v, i - v}};
+    }
+
+    // p[i] is ' ' before the first field, ',' before the others
+    for (;;) {
+        const std::size_t k = i + 1;
+        const std::size_t eq = detail::scan_unescaped(p, n, k, "=, ");
+        if (eq == k || eq == n || p[eq] != '=') return decode_status::invalid;
+        if (out.field_count == MaxFields) return decode_status::too_many;
+        field& f = out.field_slots[out.field_count++];
+        f = field{};
+        f.key = {p + k, eq - k};
+
+        const std::size_t v = eq + 1;
+        if (v < n && p[v] == '"') {
+            const std::size_t q = detail::scan_unescaped(p, n, v + 1, "\"");
+            if (q == n) return decode_status::invalid;
+            f.kind = value_kind::string;
+            f.string = {p + v + 1, q - v - 1};
+            i = q + 1;
+        } else {
+            constexpr char ends[] = {',', ' '};
+            const std::size_t len = simd::find_first_of(p + v, n - v, ends, 2);
+            i = len == simd::npos ? n : v + len;
+            if (!detail::parse_field_value({p + v, i - v}, f)) return decode_status::invalid;
+        }
+        if (i == n) return decode_status::ok;
+        if (p[i] == ' ') break;
+        if (p[i] != ',') return decode_status::invalid;
+    }
+
+    std::int64_t ts = 0;
+    if (!detail::parse_number(line.substr(i + 1), ts)) return decode_status::invalid;
+    out.timestamp = ts;
+    return decode_status::ok;
+}
+
+/**
+ * @brief Decodes every line of a batch, calling fn(point) for each valid one
+ * Blank lines and '#' comments are skipped. Returns the number of lines
+ * rejected.
+ */
+template <std::size_t MaxTags = 32, std::size_t MaxFields = 32, typename Fn>
+std::size_t decode_influx_batch(std::string_view batch, Fn&& fn) {
+    influx_point<MaxTags, MaxFields> point;
+    std::size_t rejected = 0;
+    detail::for_each_line(batch, [&](std::string_view line) {
+        if (decode_influx(line, point) == decode_status::ok) {
+            fn(std::as_const(point));
+        } else {
+            ++rejected;
+        }
+    });
+    return rejected;
+}
+
+// ==================== StatsD Decoder ====================
+
+template <std::size_t MaxTags>
+decode_status decode_statsd(std::string_view line, statsd_metric<MaxTags>& out) noexcept {
+    out.tag_count = 0;
+    out.rate = 1.0;
+    out.number = 0;
+
+    const std::size_t colon = line.find(':');
+    if (colon == 0 || colon == line.npos) return decode_status::invalid;
+    out.name = line.substr(0, colon);
+
+    std::string_view rest = line.substr(colon + 1);
+    const std::size_t bar = rest.find('|');
+    if (bar == 0 || bar == rest.npos) return decode_status::invalid;
+    out.value = rest.substr(0, bar);
+    rest.remove_prefix(bar + 1);
+
+    const std::string_view code = rest.substr(0, rest.find('|'));
+    const auto* hit = std::find(statsd_codes.begin(), statsd_codes.end(), code);
+    if (hit == statsd_codes.end()) return decode_status::invalid;
+    out.type = static_cast<statsd_type>(hit - statsd_codes.begin());
+    rest.remove_prefix(code.size());
+
+    const std::string_view num = out.value.front() == '+' ? out.value.substr(1) : out.value;
+    if (!detail::parse_number(num, out.number)) {
+        if (out.type != statsd_type::set) return decode_status::invalid;
+        out.number = 0;
+    }
+
+    // Optional sections, each introduced by '|'
+    while (!rest.empty()) {
+        if (rest.front() != '|') return decode_status::invalid;
+        rest.remove_prefix(1);
+        const std::string_view section = rest.substr(0, rest.find('|'));
+        rest.remove_prefix(section.size());
+        if (section.empty()) return decode_status::invalid;
+
+        if (section.front() == '@') {
+            if (!detail::parse_number(section.substr(1), out.rate) || !(out.rate > 0.0)) return decode_status::invalid;
+        } else if (section.front() == '#') {
+            std::string_view tags = section.substr(1);
+            while (!tags.empty()) {
+                const std::string_view t = tags.substr(0, tags.find(','));
+                tags.remove_prefix(std::min(tags.size(), t.size() + 1));
+                if (t.empty()) continue;
+                if (out.tag_count == MaxTags) return decode_status::too_many;
+                const std::size_t c = t.find(':');
+                out.tag_slots[out.tag_count++] = c == t.npos ? tag{t, {}} : tag{t.substr(0, c), t.substr(c + 1)};
+            }
+        }
+        // Other extensions (timestamps, container ids, ...) are skipped
+    }
+    return decode_status::ok;
+}
+
+template <std::size_t MaxTags = 16, typename Fn>
+std::size_t decode_statsd_batch(std::string_view batch, Fn&& fn) {
+    statsd_metric<MaxTags> metric;
+    std::size_t rejected = 0;
+    detail::for_each_line(batch, [&](std::string_view line) {
+        if (decode_statsd(line, metric) == decode_status::ok) {
+            fn(std::as_const(metric));
+        } else {
+            ++rejected;
+        }
+    });
+    return rejected;
+}
+
+// ==================== Unescaping ====================
+
+/// Copies a decoded Influx string with escaping backslashes removed
+template <std::size_t Cap>
+constexpr void unescape(std::string_view s, basic_fstring<char, Cap>& out) noexcept {
+    out.clear();
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        if (s[i] == '\\' && i + 1 < s.size() && std::string_view{",= \"\\"}.find(s[i + 1]) != std::string_view::npos) ++i;
+        out.push_back(s[i]);
+    }
+}
+
+} // namespace zuu::metrics
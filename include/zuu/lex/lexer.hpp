@@ -0,0 +1,590 @@
+#pragma once
+
+/**
+ * @file zuu/lex/lexer.hpp
+ * @brief Compile-time lexer generator: token rules -> DFA transition table
+ * @version 3.0.0
+ *
+ * Usage:
+ *   enum class tok { select, ident, number, string, comma, eq };
+ *
+ *   static constexpr auto sql = zuu::lex::make_lexer(
+ *       zuu::lex::literal(tok::select, "SELECT"),
+ *       zuu::lex::literal(tok::eq, "="),
+ *       zuu::lex::literal(tok::comma, ","),
+ *       zuu::lex::run(tok::ident, zuu::lex::alpha | "_", zuu::lex::alnum | "_"),
+ *       zuu::lex::number(tok::number),
+ *       zuu::lex::quoted(tok::string, '\''));
+ *
+ *   for (auto t : sql.tokenize(query)) {
+ *       if (t.is(tok::ident)) ... t.text ...
+ *   }
+ *
+ * Rules are unioned into one NFA and determinized at compile time over
+ * byte equivalence classes. Matching is longest-match; on equal length
+ * the earlier rule wins, so list keywords before identifiers.
+ *
+ * ASCII whitespace between tokens is skipped with the SIMD kernels, and
+ * so are self-looping states (identifier tails, string bodies): those
+ * runs are consumed a block at a time instead of one transition per
+ * character. Code units above 0xFF only match complemented sets, such
+ * as the body of a quoted string.
+ */
+
+#include "../core/core.hpp"
+#include "../core/simd.hpp"
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+
+namespace zuu::lex {
+
+// ==================== Limits ====================
+
+inline constexpr std::size_t max_rules = 32;
+inline constexpr std::size_t max_literal = 32;
+inline constexpr std::size_t max_nfa_states = 128;
+inline constexpr std::size_t max_edges = 256;
+inline constexpr std::size_t max_dfa_states = 128;
+inline constexpr std::size_t max_classes = 64;
+
+// Token kinds reserved by the lexer
+inline constexpr int error = -1;   // one code unit no rule accepts
+inline constexpr int end = -2;     // input exhausted
+
+// ==================== Character Sets ====================
+
+/**
+ * @brief Set over bytes 0..255 plus one symbol for wider code units
+ */
+struct charset {
+    std::uint64_t bits[4]{};
+    bool high = false;
+
+    constexpr charset() noexcept = default;
+
+    // Every character of a literal: `alpha | "_$"`
+    constexpr charset(const char* chars) noexcept {
+        for (; *chars; ++chars) add(static_cast<unsigned char>(*chars));
+    }
+
+    [[nodiscard]] static constexpr charset range(unsigned char lo, unsigned char hi) noexcept {
+        charset s;
+        for (unsigned c = lo; c <= hi; ++c) s.add(c);
+        return s;
+    }
+
+    [[nodiscard]] static constexpr charset any() noexcept {
+        return ~charset{};
+    }
+
+    constexpr void add(unsigned sym) noexcept {
+        if (sym > 0xff) high = true;
+        else bits[sym >> 6] |= std::uint64_t{1} << (sym & 63);
+    }
+
+    // `sym` is a byte, or 256 for any wider code unit
+    [[nodiscard]] constexpr bool contains(unsigned sym) const noexcept {
+        return sym > 0xff ? high : ((bits[sym >> 6] >> (sym & 63)) & 1) != 0;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        return !high && !(bits[0] | bits[1] | bits[2] | bits[3]);
+    }
+
+    [[nodiscard]] friend constexpr charset operator|(const charset& a, const charset& b) noexcept {
+        charset s;
+        for (std::size_t i = 0; i < 4; ++i) s.bits[i] = a.bits[i] | b.bits[i];
+        s.high = a.high || b.high;
+        return s;
+    }
+
+    [[nodiscard]] friend constexpr charset operator~(const charset& a) noexcept {
+        charset s;
+        for (std::size_t i = 0; i < 4; ++i) s.bits[i] = ~a.bits[i];
+        s.high = !a.high;
+        return s;
+    }
+};
+
+inline constexpr charset digit = charset::range('0', '9');
+inline constexpr charset lower = charset::range('a', 'z');
+inline constexpr charset upper = charset::range('A', 'Z');
+inline constexpr charset alpha = lower | upper;
+inline constexpr charset alnum = alpha | digit;
+inline constexpr charset xdigit = digit | charset::range('a', 'f') | charset::range('A', 'F');
+
+// ==================== Rules ====================
+
+enum class rule_kind : std::uint8_t { literal, run, number, quoted };
+
+struct rule {
+    rule_kind kind{};
+    int token = 0;
+    char text[max_literal]{};
+    std::size_t length = 0;
+    charset first{};
+    charset rest{};
+    char quote = '"';
+};
+
+// Exact text, e.g. a keyword or operator
+template <typename Kind>
+[[nodiscard]] constexpr rule literal(Kind token, std::string_view text) {
+    if (text.empty() || text.size() > max_literal) {
+        throw std::length_error("zuu::lex::literal: text must be 1..32 characters");
+    }
+    rule r{.kind = rule_kind::literal, .token = static_cast<int>(token)};
+    for (std::size_t i = 0; i < text.size(); ++i) r.text[i] = text[i];
+    r.length = text.size();
+    return r;
+}
+
+// One character of `first`, then any number of `rest`
+template <typename Kind>
+[[nodiscard]] constexpr rule run(Kind token, charset first, charset rest) noexcept {
+    return {.kind = rule_kind::run, .token = static_cast<int>(token), .first = first, .rest = rest};
+}
+
+template <typename Kind>
+[[nodiscard]] constexpr rule run(Kind token, charset chars) noexcept {
+    return run(token, chars, chars);
+}
+
+// Unsigned decimal: 12, 3.25, 6e-3, 1.5E+10
+template <typename Kind>
+[[nodiscard]] constexpr rule number(Kind token) noexcept {
+    return {.kind = rule_kind::number, .token = static_cast<int>(token)};
+}
+
+// Delimited by `quote`; a backslash escapes the next code unit
+template <typename Kind>
+[[nodiscard]] constexpr rule quoted(Kind token, char quote = '"') noexcept {
+    return {.kind = rule_kind::quoted, .token = static_cast<int>(token), .quote = quote};
+}
+
+// ==================== Tokens ====================
+
+template <meta::character CharT>
+struct token {
+    int kind = end;
+    std::basic_string_view<CharT> text;
+
+    template <typename Kind>
+    [[nodiscard]] constexpr bool is(Kind k) const noexcept {
+        return kind == static_cast<int>(k);
+    }
+
+    [[nodiscard]] constexpr explicit operator bool() const noexcept {
+        return kind != end;
+    }
+};
+
+namespace detail {
+
+// ==================== NFA ====================
+
+struct state_set {
+    std::uint64_t w[max_nfa_states / 64]{};
+
+    constexpr void add(std::size_t s) noexcept { w[s >> 6] |= std::uint64_t{1} << (s & 63); }
+    [[nodiscard]] constexpr bool has(std::size_t s) const noexcept { return (w[s >> 6] >> (s & 63)) & 1; }
+    [[nodiscard]] constexpr bool empty() const noexcept {
+        for (auto x : w) if (x) return false;
+        return true;
+    }
+    [[nodiscard]] constexpr bool operator==(const state_set&) const noexcept = default;
+};
+
+struct nfa {
+    struct edge {
+        std::size_t from = 0;
+        std::size_t to = 0;
+        charset set;
+    };
+
+    edge edges[max_edges]{};
+    std::size_t edge_count = 0;
+    int accept[max_nfa_states]{};   // rule index, or -1
+    std::size_t state_count = 0;
+    state_set start;
+
+    constexpr std::size_t state(int accepts = -1) {
+        if (state_count == max_nfa_states) {
+            throw std::length_error("zuu::lex: rules need more than 128 NFA states");
+        }
+        accept[state_count] = accepts;
+        return state_count++;
+    }
+
+    constexpr void link(std::size_t from, std::size_t to, const charset& set) {
+        if (edge_count == max_edges) {
+            throw std::length_error("zuu::lex: rules need more than 256 NFA edges");
+        }
+        edges[edge_count++] = {from, to, set};
+    }
+
+    constexpr void add_rule(const rule& r, int index) {
+        const std::size_t s0 = state();
+        start.add(s0);
+
+        switch (r.kind) {
+        case rule_kind::literal: {
+            std::size_t at = s0;
+            for (std::size_t i = 0; i < r.length; ++i) {
+                const std::size_t next = state(i + 1 == r.length ? index : -1);
+                charset c;
+                c.add(static_cast<unsigned char>(r.text[i]));
+                link(at, next, c);
+                at = next;
+            }
+            break;
+        }
+        case rule_kind::run: {
+            const std::size_t body = state(index);
+            link(s0, body, r.first);
+            link(body, body, r.rest);
+            break;
+        }
+        case rule_kind::number: {
+            const std::size_t whole = state(index);
+            const std::size_t dot = state();
+            const std::size_t frac = state(index);
+            const std::size_t exp = state();
+            const std::size_t sign = state();
+            const std::size_t pow = state(index);
+            link(s0, whole, digit);
+            link(whole, whole, digit);
+            link(whole, dot, ".");
+            link(dot, frac, digit);
+            link(frac, frac, digit);
+            link(whole, exp, "eE");
+            link(frac, exp, "eE");
+            link(exp, sign, "+-");
+            link(exp, pow, digit);
+            link(sign, pow, digit);
+            link(pow, pow, digit);
+            break;
+        }
+        case rule_kind::quoted: {
+            const std::size_t body = state();
+            const std::size_t escape = state();
+            const std::size_t close = state(index);
+            const char delims[] = {r.quote, '\\', '\0'};
+            charset q;
+            q.add(static_cast<unsigned char>(r.quote));
+            link(s0, body, q);
+            link(body, body, ~charset(delims));
+            link(body, escape, "\\");
+            link(escape, body, charset::any());
+            link(body, close, q);
+            break;
+        }
+        }
+    }
+};
+
+} // namespace detail
+
+// ==================== Lexer ====================
+
+class lexer {
+public:
+    template <meta::character CharT>
+    class token_range;
+
+    // Next token at or after `pos`; advances `pos` past it
+    template <meta::character CharT>
+    [[nodiscard]] constexpr token<CharT> next(
+        std::basic_string_view<CharT> in, std::size_t& pos
+    ) const noexcept {
+        const std::size_t n = in.size();
+        const CharT* p = in.data();
+
+        // Separators are usually one or two characters: step those and
+        // hand longer runs (indentation, blank lines) to the SIMD kernel
+        for (std::size_t k = 0; pos < n && simd::detail::scalar_space(p[pos]); ++pos) {
+            if (++k == scalar_steps) {
+                const std::size_t at = simd::find_first_not_space(p + pos, n - pos);
+                pos = at == simd::npos ? n : pos + at;
+                break;
+            }
+        }
+        if (pos >= n) return {end, {}};
+
+        std::size_t state = 1;
+        std::size_t i = pos;
+        int matched = -1;
+        std::size_t matched_end = pos;
+
+        while (i < n) {
+            const std::size_t next_state = next_[state][class_of(p[i])];
+            if (next_state == 0) break;
+            state = next_state;
+            ++i;
+            // Consumes the whole self-loop run, so this fires once per run
+            if (skip_[state].mode != skip_mode::none) i += span(state, p + i, n - i);
+            if (accept_[state] >= 0) {
+                matched = accept_[state];
+                matched_end = i;
+            }
+        }
+
+        const std::size_t start = pos;
+        if (matched < 0) {
+            pos = start + 1;
+            return {error, {p + start, 1}};
+        }
+        pos = matched_end;
+        return {tokens_[matched], {p + start, matched_end - start}};
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr token_range<CharT> tokenize(std::basic_string_view<CharT> in) const noexcept {
+        return {this, in};
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr token_range<CharT> tokenize(const basic_fstring<CharT, Cap>& in) const noexcept {
+        return {this, std::basic_string_view<CharT>(in)};
+    }
+
+    // Token views would dangle
+    template <meta::character CharT, std::size_t Cap>
+    void tokenize(const basic_fstring<CharT, Cap>&&) const = delete;
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr token_range<CharT> tokenize(const CharT* in) const noexcept {
+        return {this, std::basic_string_view<CharT>(in)};
+    }
+
+    [[nodiscard]] constexpr std::size_t state_count() const noexcept { return states_; }
+    [[nodiscard]] constexpr std::size_t class_count() const noexcept { return classes_; }
+
+    template <typename... Rules>
+    friend constexpr lexer make_lexer(const Rules&... rules);
+
+private:
+    enum class skip_mode : std::uint8_t { none, stops, ranges };
+
+    // Whitespace stepped one at a time before the SIMD kernel takes over
+    static constexpr std::size_t scalar_steps = 8;
+
+    // How a self-looping state consumes its run in bulk
+    struct skip_info {
+        skip_mode mode = skip_mode::none;
+        std::uint8_t count = 0;
+        unsigned char a[4]{};   // stop characters, or range lows
+        unsigned char b[4]{};   // range highs
+    };
+
+    std::uint8_t class_of_[257]{};
+    std::uint8_t next_[max_dfa_states][max_classes]{};
+    std::int16_t accept_[max_dfa_states]{};
+    skip_info skip_[max_dfa_states]{};
+    int tokens_[max_rules]{};
+    std::size_t states_ = 0;
+    std::size_t classes_ = 0;
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::size_t class_of(CharT ch) const noexcept {
+        using unit_t = std::make_unsigned_t<CharT>;
+        const auto u = static_cast<unit_t>(ch);
+        return class_of_[u > 0xff ? 256 : u];
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::size_t span(std::size_t state, const CharT* p, std::size_t n) const noexcept {
+        const skip_info& s = skip_[state];
+        CharT a[4]{}, b[4]{};
+        for (std::size_t j = 0; j < s.count; ++j) {
+            a[j] = static_cast<CharT>(s.a[j]);
+            b[j] = static_cast<CharT>(s.b[j]);
+        }
+        if (s.mode == skip_mode::ranges) return simd::span_ranges(p, n, a, b, s.count);
+        if (s.count == 0) return n;
+        const std::size_t at = simd::find_first_of(p, n, a, s.count);
+        return at == simd::npos ? n : at;
+    }
+
+    // Pick the bulk-skip strategy for a state from the set it loops on
+    constexpr void plan_skip(std::size_t state) noexcept {
+        bool loops[257]{};
+        std::size_t loop_count = 0;
+        for (unsigned sym = 0; sym <= 256; ++sym) {
+            loops[sym] = next_[state][class_of_[sym]] == state;
+            loop_count += loops[sym];
+        }
+        if (loop_count == 0) return;
+
+        skip_info info;
+        if (loops[256] && loop_count >= 257 - 4) {
+            info.mode = skip_mode::stops;
+            for (unsigned sym = 0; sym < 256; ++sym) {
+                if (!loops[sym]) info.a[info.count++] = static_cast<unsigned char>(sym);
+            }
+            skip_[state] = info;
+            return;
+        }
+
+        for (unsigned sym = 0x80; sym <= 256; ++sym) {
+            if (loops[sym]) return;   // SIMD ranges are ASCII only
+        }
+        for (unsigned sym = 0; sym < 0x80; ++sym) {
+            if (!loops[sym] || (sym > 0 && loops[sym - 1])) continue;
+            if (info.count == 4) return;
+            unsigned hi = sym;
+            while (hi + 1 < 0x80 && loops[hi + 1]) ++hi;
+            info.a[info.count] = static_cast<unsigned char>(sym);
+            info.b[info.count] = static_cast<unsigned char>(hi);
+            ++info.count;
+        }
+        info.mode = skip_mode::ranges;
+        skip_[state] = info;
+    }
+};
+
+// ==================== Token Range ====================
+
+template <meta::character CharT>
+class lexer::token_range {
+public:
+    class iterator {
+    public:
+        using value_type = token<CharT>;
+        using difference_type = std::ptrdiff_t;
+
+        constexpr iterator() noexcept = default;
+
+        [[nodiscard]] constexpr const token<CharT>& operator*() const noexcept { return current_; }
+        [[nodiscard]] constexpr const token<CharT>* operator->() const noexcept { return &current_; }
+
+        constexpr iterator& operator++() noexcept {
+            current_ = lexer_->next(input_, pos_);
+            return *this;
+        }
+
+        constexpr void operator++(int) noexcept { ++*this; }
+
+        [[nodiscard]] constexpr bool operator==(std::default_sentinel_t) const noexcept {
+            return current_.kind == lex::end;
+        }
+
+        // Offset just past the current token
+        [[nodiscard]] constexpr std::size_t position() const noexcept { return pos_; }
+
+    private:
+        friend class token_range;
+
+        constexpr iterator(const lexer* lx, std::basic_string_view<CharT> in) noexcept
+            : lexer_(lx), input_(in) {
+            ++*this;
+        }
+
+        const lexer* lexer_ = nullptr;
+        std::basic_string_view<CharT> input_;
+        std::size_t pos_ = 0;
+        token<CharT> current_;
+    };
+
+    constexpr token_range(const lexer* lx, std::basic_string_view<CharT> in) noexcept
+        : lexer_(lx), input_(in) {}
+
+    [[nodiscard]] constexpr iterator begin() const noexcept { return {lexer_, input_}; }
+    [[nodiscard]] constexpr std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    const lexer* lexer_;
+    std::basic_string_view<CharT> input_;
+};
+
+// ==================== Generator ====================
+
+/**
+ * @brief Build the DFA for `rules` (use in a constexpr context)
+ *
+ * Exceeding a limit throws std::length_error, which surfaces as a
+ * compile error when evaluated at compile time.
+ */
+template <typename... Rules>
+[[nodiscard]] constexpr lexer make_lexer(const Rules&... rules) {
+    static_assert(sizeof...(Rules) > 0 && sizeof...(Rules) <= max_rules, "zuu::lex: 1..32 rules");
+    const rule list[] = {rules...};
+
+    lexer lx;
+    detail::nfa nfa;
+    for (std::size_t r = 0; r < sizeof...(Rules); ++r) {
+        nfa.add_rule(list[r], static_cast<int>(r));
+        lx.tokens_[r] = list[r].token;
+    }
+
+    // Byte classes: refine the partition by every edge set
+    std::size_t classes = 1;
+    for (std::size_t e = 0; e < nfa.edge_count; ++e) {
+        int remap[2 * max_classes];
+        for (auto& m : remap) m = -1;
+        std::size_t next_classes = 0;
+        for (unsigned sym = 0; sym <= 256; ++sym) {
+            const std::size_t key = lx.class_of_[sym] * 2 + nfa.edges[e].set.contains(sym);
+            if (remap[key] < 0) {
+                if (next_classes == max_classes) {
+                    throw std::length_error("zuu::lex: rules need more than 64 character classes");
+                }
+                remap[key] = static_cast<int>(next_classes++);
+            }
+            lx.class_of_[sym] = static_cast<std::uint8_t>(remap[key]);
+        }
+        classes = next_classes;
+    }
+    lx.classes_ = classes;
+
+    unsigned representative[max_classes]{};
+    for (unsigned sym = 257; sym-- > 0;) representative[lx.class_of_[sym]] = sym;
+
+    // Subset construction; DFA state 0 is dead, 1 is the start
+    detail::state_set sets[max_dfa_states]{};
+    sets[1] = nfa.start;
+    std::size_t count = 2;
+    lx.accept_[0] = -1;
+
+    for (std::size_t d = 1; d < count; ++d) {
+        lx.accept_[d] = -1;
+        for (std::size_t s = 0; s < nfa.state_count; ++s) {
+            if (sets[d].has(s) && nfa.accept[s] >= 0 &&
+                (lx.accept_[d] < 0 || nfa.accept[s] < lx.accept_[d])) {
+                lx.accept_[d] = static_cast<std::int16_t>(nfa.accept[s]);
+            }
+        }
+
+        for (std::size_t c = 0; c < classes; ++c) {
+            detail::state_set target;
+            for (std::size_t e = 0; e < nfa.edge_count; ++e) {
+                const auto& edge = nfa.edges[e];
+                if (sets[d].has(edge.from) && edge.set.contains(representative[c])) {
+                    target.add(edge.to);
+                }
+            }
+            if (target.empty()) continue;
+
+            std::size_t found = 0;
+            for (std::size_t k = 1; k < count && !found; ++k) {
+                if (sets[k] == target) found = k;
+            }
+            if (!found) {
+                if (count == max_dfa_states) {
+                    throw std::length_error("zuu::lex: rules need more than 128 DFA states");
+                }
+                sets[count] = target;
+                found = count++;
+            }
+            lx.next_[d][c] = static_cast<std::uint8_t>(found);
+        }
+    }
+    lx.states_ = count;
+
+    for (std::size_t d = 1; d < count; ++d) lx.plan_skip(d);
+    return lx;
+}
+
+} // namespace zuu::lex
@@ -0,0 +1,650 @@
+#pragma once
+
+/**
+ * @file zuu/lex/subword.hpp
+ * @brief WordPiece and BPE subword tokenizers emitting token ids
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::lex::wordpiece_tokenizer bert({.lowercase = true});
+ *   if (!bert.load(read_file("vocab.txt"))) return error();   // one token per line
+ *
+ *   zuu::fstring<256> query = "Where is the nearest café?";
+ *   auto ids = bert.encode<64>(query);                // token_ids<64>
+ *   for (std::uint32_t id : ids) ...;
+ *
+ *   zuu::lex::bpe_tokenizer bpe;
+ *   bpe.load(read_file("vocab.txt"), read_file("merges.txt"));
+ *   std::size_t n = bpe.encode(title, std::span{buffer});  // into any span
+ *
+ *   // Many texts, on all hardware threads
+ *   std::vector<zuu::lex::token_ids<64>> out(titles.size());
+ *   zuu::lex::encode_batch(bert, titles, std::span{out});
+ *
+ * Pre-tokenization splits on ASCII whitespace and, unless disabled,
+ * makes each ASCII punctuation character a word of its own. Both are
+ * classified 64 characters at a time into bitmaps, so words are found
+ * from bit transitions rather than per-character tests. Text is UTF-8;
+ * non-ASCII characters are word characters and are never folded.
+ *
+ * WordPiece is greedy longest-match-first over a flat byte trie, with
+ * continuation pieces under the "##" node; a word with an unmatchable
+ * remainder becomes the unknown token. BPE starts from the word's
+ * characters and applies ranked merges through a min-heap of adjacent
+ * pairs: each merge costs O(log n), with no rescans of the word.
+ * Vocabularies are flat: token text back to back plus an open-addressed
+ * index, merges in an open-addressed table keyed by the id pair.
+ *
+ * Tokenizers are immutable once loaded; encode() may run on any number
+ * of threads at once.
+ */
+
+#include "../core/core.hpp"
+#include "../core/hash.hpp"
+#include "../core/parallel.hpp"
+#include "../core/simd.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace zuu::lex {
+
+// ==================== Token Id Array ====================
+
+/**
+ * @brief Up to Cap token ids of one text
+ * `truncated` is set when the text had more tokens than fit.
+ */
+template <std::size_t Cap>
+struct token_ids {
+    std::array<std::uint32_t, Cap> ids;
+    std::size_t count = 0;
+    bool truncated = false;
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+    [[nodiscard]] constexpr std::uint32_t operator[](std::size_t i) const noexcept { return ids[i]; }
+    [[nodiscard]] constexpr const std::uint32_t* data() const noexcept { return ids.data(); }
+    [[nodiscard]] constexpr const std::uint32_t* begin() const noexcept { return ids.data(); }
+    [[nodiscard]] constexpr const std::uint32_t* end() const noexcept { return ids.data() + count; }
+    [[nodiscard]] constexpr std::span<const std::uint32_t> span() const noexcept { return {ids.data(), count}; }
+};
+
+// ==================== Options ====================
+
+struct wordpiece_options {
+    bool lowercase = false;                      // fold ASCII letters (uncased vocabularies)
+    bool split_punctuation = true;               // ASCII punctuation: one word per character
+    std::size_t max_word_chars = 100;            // longer words become unk_token (max 256)
+    std::string_view unk_token = "[UNK]";
+    std::string_view continuing_prefix = "##";
+};
+
+struct bpe_options {
+    bool lowercase = false;
+    bool split_punctuation = true;
+    std::string_view unk_token = "<unk>";        // for characters missing from the vocabulary
+};
+
+struct tokenize_options {
+    std::size_t threads = 0;        // 0 = all hardware threads
+    std::size_t min_chunk = 64;     // texts per task, lower bound
+};
+
+namespace detail {
+
+inline constexpr std::uint32_t no_token = 0xffffffffu;
+
+// Longest span handled in one piece: a WordPiece word or a BPE slice
+inline constexpr std::size_t max_span = 256;
+
+// ASCII punctuation, as four ranges: ! - /   : - @   [ - `   { - ~
+inline constexpr char punct_lo[4] = {'!', ':', '[', '{'};
+inline constexpr char punct_hi[4] = {'/', '@', '`', '~'};
+
+/**
+ * @brief Calls fn(begin, end) for every word, in order
+ * Words are runs of characters that are neither whitespace nor (when
+ * split_punct) punctuation; each punctuation character is a word by
+ * itself. Stops early when fn returns false.
+ */
+template <typename Fn>
+constexpr void for_each_word(const char* p, std::size_t n, bool split_punct, Fn&& fn) {
+    std::size_t start = 0;
+    bool open = false;
+    for (std::size_t base = 0; base < n; base += 64) {
+        const std::size_t len = std::min<std::size_t>(64, n - base);
+        const std::uint64_t punct = split_punct ? simd::range_mask(p + base, len, punct_lo, punct_hi, 4) : 0;
+        const std::uint64_t sep = simd::space_mask(p + base, len) | punct;   // bits past len are set
+
+        std::size_t i = 0;
+        while (i < len) {
+            const std::uint64_t from = ~std::uint64_t{0} << i;
+            if (open) {
+                const std::uint64_t ends = sep & from;
+                if (ends == 0) break;
+                const auto e = static_cast<std::size_t>(std::countr_zero(ends));
+                if (!fn(start, base + e)) return;
+                open = false;
+                i = e;
+            } else {
+                const std::uint64_t starts = (~sep | punct) & from;
+                if (starts == 0) break;
+                const auto s = static_cast<std::size_t>(std::countr_zero(starts));
+                if (s >= len) break;
+                if ((punct >> s) & 1) {
+                    if (!fn(base + s, base + s + 1)) return;
+                    i = s + 1;
+                } else {
+                    start = base + s;
+                    open = true;
+                    i = s + 1;
+                }
+            }
+        }
+    }
+    if (open) fn(start, n);
+}
+
+// Bytes of the UTF-8 character starting with `lead` (1 for stray bytes)
+[[nodiscard]] constexpr std::size_t utf8_length(char lead) noexcept {
+    const auto b = static_cast<unsigned char>(lead);
+    return b < 0xC0 ? 1 : b < 0xE0 ? 2 : b < 0xF0 ? 3 : 4;
+}
+
+// ==================== Token Table ====================
+
+/**
+ * @brief Token strings stored back to back, with a text -> id index
+ * Ids are insertion order. A repeated string keeps its first id.
+ */
+class token_table {
+public:
+    [[nodiscard]] std::size_t size() const noexcept { return ends_.size(); }
+
+    [[nodiscard]] std::string_view operator[](std::uint32_t id) const noexcept {
+        const std::uint32_t b = id == 0 ? 0 : ends_[id - 1];
+        return {chars_.data() + b, ends_[id] - b};
+    }
+
+    std::uint32_t add(std::string_view tok) {
+        const auto id = static_cast<std::uint32_t>(ends_.size());
+        chars_.insert(chars_.end(), tok.begin(), tok.end());
+        ends_.push_back(static_cast<std::uint32_t>(chars_.size()));
+        if (ends_.size() * 2 > slots_.size()) {
+            slots_.assign(std::max<std::size_t>(64, slots_.size() * 2), no_token);
+            for (std::uint32_t i = 0; i <= id; ++i) index(i);
+        } else {
+            index(id);
+        }
+        return id;
+    }
+
+    [[nodiscard]] std::uint32_t find(std::string_view tok) const noexcept {
+        if (slots_.empty()) return no_token;
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = hash_chars(tok.data(), tok.size()) & mask;; i = (i + 1) & mask) {
+            const std::uint32_t id = slots_[i];
+            if (id == no_token || (*this)[id] == tok) return id;
+        }
+    }
+
+    void clear() noexcept {
+        chars_.clear();
+        ends_.clear();
+        slots_.clear();
+    }
+
+private:
+    void index(std::uint32_t id) noexcept {
+        const std::string_view tok = (*this)[id];
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = hash_chars(tok.data(), tok.size()) & mask;; i = (i + 1) & mask) {
+            if (slots_[i] == no_token) {
+                slots_[i] = id;
+                return;
+            }
+            if ((*this)[slots_[i]] == tok) return;
+        }
+    }
+
+    std::vector<char> chars_;
+    std::vector<std::uint32_t> ends_;
+    std::vector<std::uint32_t> slots_;   // power of two, at most half full
+};
+
+// ==================== Flat Trie ====================
+
+/**
+ * @brief Byte trie of a token table, children stored contiguously
+ * The root's children are a direct 256-entry table; other nodes' labels
+ * sit in one array, searched with simd::find_char.
+ */
+class flat_trie {
+public:
+    static constexpr std::uint32_t none = no_token;
+
+    void build(const token_table& tokens) {
+        std::vector<std::vector<std::pair<char, std::uint32_t>>> kids(1);
+        id_.assign(1, no_token);
+        for (std::uint32_t t = 0; t < tokens.size(); ++t) {
+            std::uint32_t s = 0;
+            for (const char ch : tokens[t]) {
+                const auto it = std::find_if(kids[s].begin(), kids[s].end(),
+                                             [&](const auto& e) { return e.first == ch; });
+                if (it != kids[s].end()) {
+                    s = it->second;
+                    continue;
+                }
+                const auto next = static_cast<std::uint32_t>(kids.size());
+                kids[s].emplace_back(ch, next);
+                kids.emplace_back();
+                id_.push_back(no_token);
+                s = next;
+            }
+            if (id_[s] == no_token) id_[s] = t;
+        }
+
+        first_.assign(kids.size() + 1, 0);
+        labels_.clear();
+        targets_.clear();
+        for (std::size_t s = 0; s < kids.size(); ++s) {
+            first_[s] = static_cast<std::uint32_t>(labels_.size());
+            for (const auto& [ch, t] : kids[s]) {
+                labels_.push_back(ch);
+                targets_.push_back(t);
+            }
+        }
+        first_[kids.size()] = static_cast<std::uint32_t>(labels_.size());
+
+        root_.fill(none);
+        for (const auto& [ch, t] : kids[0]) root_[static_cast<unsigned char>(ch)] = t;
+    }
+
+    [[nodiscard]] std::uint32_t child(std::uint32_t s, char ch) const noexcept {
+        if (s == 0) return root_[static_cast<unsigned char>(ch)];
+        const std::uint32_t b = first_[s];
+        const auto at = simd::find_char(labels_.data() + b, first_[s + 1] - b, ch);
+        return at == simd::npos ? none : targets_[b + at];
+    }
+
+    /// Token ending at node s, or no_token
+    [[nodiscard]] std::uint32_t id(std::uint32_t s) const noexcept { return id_[s]; }
+
+    /// Node reached by `prefix` from the root
+    [[nodiscard]] std::uint32_t walk(std::string_view prefix) const noexcept {
+        std::uint32_t s = 0;
+        for (const char ch : prefix) {
+            if ((s = child(s, ch)) == none) break;
+        }
+        return s;
+    }
+
+private:
+    std::array<std::uint32_t, 256> root_{};
+    std::vector<std::uint32_t> first_;     // node s: edges [first_[s], first_[s + 1])
+    std::vector<char> labels_;
+    std::vector<std::uint32_t> targets_;
+    std::vector<std::uint32_t> id_;
+};
+
+// ==================== Output ====================
+
+// Appends ids to a span; counts what did not fit
+struct id_sink {
+    std::uint32_t* out;
+    std::size_t cap;
+    std::size_t written = 0;
+    bool truncated = false;
+
+    bool push(std::uint32_t id) noexcept {
+        if (written == cap) {
+            truncated = true;
+            return false;
+        }
+        out[written++] = id;
+        return true;
+    }
+};
+
+// Folds ASCII letters of [p, p + n) into buf when asked; n <= max_span
+[[nodiscard]] inline const char* fold_span(const char* p, std::size_t n, bool lowercase, char* buf) noexcept {
+    if (!lowercase) return p;
+    simd::to_lower(p, buf, n);
+    return buf;
+}
+
+// Lines of a text file, without their "\r\n" / "\n"
+template <typename Fn>
+void for_each_line(std::string_view text, Fn&& fn) {
+    while (!text.empty()) {
+        std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+        fn(line);
+        if (end == std::string_view::npos) break;
+        text.remove_prefix(end + 1);
+    }
+}
+
+} // namespace detail
+
+// ==================== WordPiece ====================
+
+class wordpiece_tokenizer {
+public:
+    explicit wordpiece_tokenizer(wordpiece_options opt = {}) : opt_(opt) {
+        opt_.max_word_chars = std::min(opt_.max_word_chars, detail::max_span);
+    }
+
+    /// One token per line, id = line number; false if unk_token is missing
+    bool load(std::string_view vocab) {
+        vocab_.clear();
+        detail::for_each_line(vocab, [&](std::string_view tok) { vocab_.add(tok); });
+        return finish();
+    }
+
+    /// Adds tokens with consecutive ids; call finish() afterwards
+    std::uint32_t add(std::string_view token) { return vocab_.add(token); }
+
+    /// Builds the trie; false if unk_token is not in the vocabulary
+    bool finish() {
+        trie_.build(vocab_);
+        continuing_ = trie_.walk(opt_.continuing_prefix);
+        unk_ = vocab_.find(opt_.unk_token);
+        return unk_ != detail::no_token;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return vocab_.size(); }
+    [[nodiscard]] std::string_view token(std::uint32_t id) const noexcept { return vocab_[id]; }
+    [[nodiscard]] std::uint32_t id_of(std::string_view token) const noexcept { return vocab_.find(token); }
+    [[nodiscard]] std::uint32_t unk_id() const noexcept { return unk_; }
+
+    /// Writes the ids of `text` to `out`; returns how many were written
+    template <meta::char_range R>
+    requires std::same_as<meta::range_char_t<R>, char>
+    std::size_t encode(const R& text, std::span<std::uint32_t> out, bool* truncated = nullptr) const noexcept {
+        const std::string_view sv = meta::as_view(text);
+        detail::id_sink sink{out.data(), out.size()};
+        detail::for_each_word(sv.data(), sv.size(), opt_.split_punctuation, [&](std::size_t b, std::size_t e) {
+            return encode_word(sv.data() + b, e - b, sink);
+        });
+        if (truncated) *truncated = sink.truncated;
+        return sink.written;
+    }
+
+    template <std::size_t Cap, meta::char_range R>
+    requires std::same_as<meta::range_char_t<R>, char>
+    [[nodiscard]] token_ids<Cap> encode(const R& text) const noexcept {
+        token_ids<Cap> r;
+        r.count = encode(text, std::span<std::uint32_t>{r.ids}, &r.truncated);
+        return r;
+    }
+
+private:
+    // Greedy longest match; an unmatchable remainder turns the word into unk
+    bool encode_word(const char* p, std::size_t n, detail::id_sink& sink) const noexcept {
+        if (n > opt_.max_word_chars) return sink.push(unk_);
+        char buf[detail::max_span];
+        const char* w = detail::fold_span(p, n, opt_.lowercase, buf);
+
+        std::uint32_t pieces[detail::max_span];
+        std::size_t count = 0;
+        for (std::size_t pos = 0; pos < n;) {
+            std::uint32_t s = pos == 0 ? 0 : continuing_;
+            std::uint32_t best = detail::no_token;
+            std::size_t best_end = pos;
+            for (std::size_t i = pos; i < n && s != detail::flat_trie::none; ++i) {
+                s = trie_.child(s, w[i]);
+                if (s != detail::flat_trie::none && trie_.id(s) != detail::no_token) {
+                    best = trie_.id(s);
+                    best_end = i + 1;
+                }
+            }
+            if (best == detail::no_token) return sink.push(unk_);
+            pieces[count++] = best;
+            pos = best_end;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            if (!sink.push(pieces[i])) return false;
+        }
+        return true;
+    }
+
+    wordpiece_options opt_;
+    detail::token_table vocab_;
+    detail::flat_trie trie_;
+    std::uint32_t continuing_ = detail::flat_trie::none;
+    std::uint32_t unk_ = detail::no_token;
+};
+
+// ==================== BPE ====================
+
+class bpe_tokenizer {
+public:
+    explicit bpe_tokenizer(bpe_options opt = {}) : opt_(opt) {}
+
+    /**
+     * @brief Vocabulary (one token per line, id = line number) and merges
+     * Merge lines are "left right", highest priority first; lines starting
+     * with '#' and merges whose parts or result are not tokens are skipped.
+     */
+    bool load(std::string_view vocab, std::string_view merges) {
+        vocab_.clear();
+        merges_.clear();
+        merge_slots_.clear();
+        detail::for_each_line(vocab, [&](std::string_view tok) { vocab_.add(tok); });
+        detail::for_each_line(merges, [&](std::string_view line) {
+            if (line.empty() || line[0] == '#') return;
+            const std::size_t sp = line.find(' ');
+            if (sp != std::string_view::npos) add_merge(line.substr(0, sp), line.substr(sp + 1));
+        });
+        return finish();
+    }
+
+    std::uint32_t add(std::string_view token) { return vocab_.add(token); }
+
+    /// Next merge by priority; false when a part or the result is not a token
+    bool add_merge(std::string_view left, std::string_view right) {
+        const std::uint32_t a = vocab_.find(left);
+        const std::uint32_t b = vocab_.find(right);
+        if (a == detail::no_token || b == detail::no_token || left.size() + right.size() > detail::max_span) return false;
+        char joined[2 * detail::max_span];
+        std::copy(left.begin(), left.end(), joined);
+        std::copy(right.begin(), right.end(), joined + left.size());
+        const std::uint32_t merged = vocab_.find(std::string_view{joined, left.size() + right.size()});
+        if (merged == detail::no_token) return false;
+
+        if ((merges_.size() + 1) * 2 > merge_slots_.size()) {
+            merge_slots_.assign(std::max<std::size_t>(64, merge_slots_.size() * 2), detail::no_token);
+            for (std::uint32_t r = 0; r < merges_.size(); ++r) index_merge(r);
+        }
+        const auto rank = static_cast<std::uint32_t>(merges_.size());
+        merges_.push_back({pair_key(a, b), merged});
+        index_merge(rank);
+        return true;
+    }
+
+    /// Resolves the per-byte ids; false if unk_token is not in the vocabulary
+    bool finish() {
+        for (std::size_t c = 0; c < 256; ++c) {
+            const char ch = static_cast<char>(c);
+            byte_ids_[c] = vocab_.find(std::string_view{&ch, 1});
+        }
+        unk_ = vocab_.find(opt_.unk_token);
+        return unk_ != detail::no_token;
+    }
+
+    [[nodiscard]] std::size_t size() const noexcept { return vocab_.size(); }
+    [[nodiscard]] std::size_t merges() const noexcept { return merges_.size(); }
+    [[nodiscard]] std::string_view token(std::uint32_t id) const noexcept { return vocab_[id]; }
+    [[nodiscard]] std::uint32_t id_of(std::string_view token) const noexcept { return vocab_.find(token); }
+    [[nodiscard]] std::uint32_t unk_id() const noexcept { return unk_; }
+
+    template <meta::char_range R>
+    requires std::same_as<meta::range_char_t<R>, char>
+    std::size_t encode(const R& text, std::span<std::uint32_t> out, bool* truncated = nullptr) const noexcept {
+        const std::string_view sv = meta::as_view(text);
+        detail::id_sink sink{out.data(), out.size()};
+        detail::for_each_word(sv.data(), sv.size(), opt_.split_punctuation, [&](std::size_t b, std::size_t e) {
+            // Words longer than a slice are merged slice by slice, cut between characters
+            while (e - b > detail::max_span) {
+                std::size_t cut = b + detail::max_span;
+                while (cut > b + 1 && (static_cast<unsigned char>(sv[cut]) & 0xC0) == 0x80) --cut;
+                if (!encode_span(sv.data() + b, cut - b, sink)) return false;
+                b = cut;
+            }
+            return encode_span(sv.data() + b, e - b, sink);
+        });
+        if (truncated) *truncated = sink.truncated;
+        return sink.written;
+    }
+
+    template <std::size_t Cap, meta::char_range R>
+    requires std::same_as<meta::range_char_t<R>, char>
+    [[nodiscard]] token_ids<Cap> encode(const R& text) const noexcept {
+        token_ids<Cap> r;
+        r.count = encode(text, std::span<std::uint32_t>{r.ids}, &r.truncated);
+        return r;
+    }
+
+private:
+    struct merge {
+        std::uint64_t key;
+        std::uint32_t merged;
+    };
+
+    // A candidate merge of the symbol at `pos` with its right neighbour
+    struct candidate {
+        std::uint32_t rank;
+        std::uint16_t pos;
+        std::uint32_t left;
+        std::uint32_t right;
+
+        // Heap order: lowest rank first, then leftmost
+        bool operator<(const candidate& o) const noexcept {
+            return rank != o.rank ? rank > o.rank : pos > o.pos;
+        }
+    };
+
+    [[nodiscard]] static constexpr std::uint64_t pair_key(std::uint32_t a, std::uint32_t b) noexcept {
+        return (std::uint64_t{a} << 32) | b;
+    }
+
+    void index_merge(std::uint32_t rank) noexcept {
+        const std::size_t mask = merge_slots_.size() - 1;
+        const std::uint64_t key = merges_[rank].key;
+        for (std::size_t i = zuu::detail::hash_mix(key, zuu::detail::hash_k1) & mask;; i = (i + 1) & mask) {
+            if (merge_slots_[i] == detail::no_token) {
+                merge_slots_[i] = rank;
+                return;
+            }
+            if (merges_[merge_slots_[i]].key == key) return;   // keeps the higher priority
+        }
+    }
+
+    // Rank of merging a then b, or no_token
+    [[nodiscard]] std::uint32_t rank_of(std::uint32_t a, std::uint32_t b) const noexcept {
+        if (merge_slots_.empty() || a == unk_ || b == unk_) return detail::no_token;
+        const std::size_t mask = merge_slots_.size() - 1;
+        const std::uint64_t key = pair_key(a, b);
+        for (std::size_t i = zuu::detail::hash_mix(key, zuu::detail::hash_k1) & mask;; i = (i + 1) & mask) {
+            const std::uint32_t r = merge_slots_[i];
+            if (r == detail::no_token || merges_[r].key == key) return r;
+        }
+    }
+
+    // Merges one span of at most max_span bytes and emits its tokens
+    bool encode_span(const char* p, std::size_t n, detail::id_sink& sink) const noexcept {
+        char buf[detail::max_span];
+        const char* w = detail::fold_span(p, n, opt_.lowercase, buf);
+
+        constexpr std::uint16_t end = 0xffff;
+        std::uint32_t id[detail::max_span];
+        std::uint16_t prev[detail::max_span];
+        std::uint16_t next[detail::max_span];
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < n; ++count) {
+            const std::size_t len = std::min(detail::utf8_length(w[i]), n - i);
+            const std::uint32_t t = len == 1 ? byte_ids_[static_cast<unsigned char>(w[i])]
+                                             : vocab_.find(std::string_view{w + i, len});
+            id[count] = t == detail::no_token ? unk_ : t;
+            prev[count] = count == 0 ? end : static_cast<std::uint16_t>(count - 1);
+            next[count] = static_cast<std::uint16_t>(count + 1);
+            i += len;
+        }
+        if (count == 0) return true;
+        next[count - 1] = end;
+
+        // At most count - 1 initial pairs plus two per merge
+        candidate heap[3 * detail::max_span];
+        std::size_t heap_size = 0;
+        const auto offer = [&](std::uint16_t pos) {
+            if (pos == end || next[pos] == end) return;
+            const std::uint32_t r = rank_of(id[pos], id[next[pos]]);
+            if (r == detail::no_token) return;
+            heap[heap_size++] = {r, pos, id[pos], id[next[pos]]};
+            std::push_heap(heap, heap + heap_size);
+        };
+        for (std::size_t i = 0; i + 1 < count; ++i) offer(static_cast<std::uint16_t>(i));
+
+        while (heap_size > 0) {
+            std::pop_heap(heap, heap + heap_size);
+            const candidate c = heap[--heap_size];
+            // Stale when either side has merged since it was offered
+            const std::uint16_t r = next[c.pos];
+            if (id[c.pos] != c.left || r == end || id[r] != c.right) continue;
+
+            id[c.pos] = merges_[c.rank].merged;
+            next[c.pos] = next[r];
+            if (next[r] != end) prev[next[r]] = c.pos;
+            id[r] = detail::no_token;
+            offer(prev[c.pos]);
+            offer(c.pos);
+        }
+
+        for (std::uint16_t s = 0; s != end; s = next[s]) {
+            if (!sink.push(id[s])) return false;
+        }
+        return true;
+    }
+
+    bpe_options opt_;
+    detail::token_table vocab_;
+    std::vector<merge> merges_;               // by rank
+    std::vector<std::uint32_t> merge_slots_;  // open-addressed ranks, keyed by id pair
+    std::array<std::uint32_t, 256> byte_ids_{};
+    std::uint32_t unk_ = detail::no_token;
+};
+
+// ==================== Batches ====================
+
+/**
+ * @brief Encodes texts[i] into out[i] for every i < min(sizes)
+ * Texts are split into tasks of at least min_chunk and spread over the
+ * threads; one thread (or a small batch) runs on the caller.
+ */
+template <typename Tokenizer, std::ranges::random_access_range R, std::size_t Cap>
+requires std::ranges::sized_range<R> && meta::char_range<std::ranges::range_value_t<R>>
+void encode_batch(const Tokenizer& tok, const R& texts, std::span<token_ids<Cap>> out, const tokenize_options& opt = {}) {
+    const std::size_t n = std::min<std::size_t>(std::ranges::size(texts), out.size());
+    const std::size_t threads = par::thread_count(opt.threads);
+    const std::size_t chunk = std::max(std::max<std::size_t>(opt.min_chunk, 1), n / (threads * 8) + 1);
+    const std::size_t tasks = (n + chunk - 1) / chunk;
+
+    auto first = std::ranges::begin(texts);
+    par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) {
+        const std::size_t e = std::min(n, (t + 1) * chunk);
+        for (std::size_t i = t * chunk; i < e; ++i) {
+            token_ids<Cap>& r = out[i];
+            r.count = tok.encode(first[static_cast<std::ptrdiff_t>(i)], std::span<std::uint32_t>{r.ids}, &r.truncated);
+        }
+    });
+}
+
+} // namespace zuu::lex
@@ -7,7 +7,9 @@
  */
 
 #include <concepts>
+#include <ranges>
 #include <string_view>
+#include <type_traits>
 
 namespace zuu::meta {
 
@@ -25,18 +27,20 @@ concept character =
 
 template <typename T>
 concept has_data_and_size = requires(T t) {
-    { t.data() } -> std::convertible_to<const typename T::value_type*>;
+    { t.data() } -> std::convertible_to<const typename std::remove_cvref_t<T>::value_type*>;
     { t.size() } -> std::convertible_to<std::size_t>;
 };
 
 template <typename T>
 concept has_c_str = requires(T t) {
-    { t.c_str() } -> std::convertible_to<const typename T::value_type*>;
+    { t.c_str() } -> std::convertible_to<const typename std::remove_cvref_t<T>::value_type*>;
 };
 
 template <typename T>
 concept convertible_to_string_view = requires(T t) {
-    { std::basic_string_view{t} } -> std::same_as<std::basic_string_view<typename T::value_type>>;
+    // Checked first so CTAD never instantiates basic_string_view<non-char>
+    requires character<typename std::remove_cvref_t<T>::value_type>;
+    { std::basic_string_view{t} } -> std::same_as<std::basic_string_view<typename std::remove_cvref_t<T>::value_type>>;
 };
 
 // Main StringLike concept
@@ -57,6 +61,27 @@ concept fixed_string =
     string_like<T> && 
     has_static_capacity<T>;
 
+// ==================== Contiguous Character Ranges ====================
+
+// fstrings, std::strings, string_views, std::array<char, N>, vectors, spans...
+// Built-in arrays are excluded: a literal's terminator would count as data
+template <typename T>
+concept char_range =
+    !std::is_array_v<std::remove_cvref_t<T>> &&
+    std::ranges::contiguous_range<const std::remove_cvref_t<T>> &&
+    std::ranges::sized_range<const std::remove_cvref_t<T>> &&
+    character<std::ranges::range_value_t<std::remove_cvref_t<T>>>;
+
+// basic_fstring, fstring_ref: text edited in place, truncating at capacity
+template <typename T>
+concept editable_string =
+    char_range<T> &&
+    requires(T& s, std::ranges::range_value_t<T> ch, std::size_t n) {
+        s.resize(n);
+        s.append(ch);
+        { s.available() } -> std::convertible_to<std::size_t>;
+    };
+
 // ==================== Algorithm Composability ====================
 
 // Detect if type supports piping (has operator|)
@@ -7,7 +7,9 @@
  */
 
 #include "concepts.hpp"
+#include <ranges>
 #include <span>
+#include <string_view>
 
 namespace zuu::meta {
 
@@ -57,6 +59,17 @@ struct char_type_of<const Char*> {
 template <typename T>
 using char_type_of_t = typename char_type_of<std::remove_cvref_t<T>>::type;
 
+// ==================== Contiguous Range Access ====================
+
+template <char_range R>
+using range_char_t = std::ranges::range_value_t<std::remove_cvref_t<R>>;
+
+// Borrowed view of any contiguous character range
+template <char_range R>
+[[nodiscard]] constexpr std::basic_string_view<range_char_t<R>> as_view(const R& r) noexcept {
+    return {std::ranges::data(r), std::ranges::size(r)};
+}
+
 // ==================== Compatibility Checking ====================
 
 template <typename T1, typename T2>
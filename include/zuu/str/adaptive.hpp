@@ -0,0 +1,696 @@
+#pragma once
+
+/**
+ * @file zuu/str/adaptive.hpp
+ * @brief Searchers that choose their scanning strategy from observed input
+ * @version 3.0.0
+ *
+ * Usage:
+ *   zuu::str::adaptive_searcher<char> s{"needle"};
+ *   for (auto line : lines) {
+ *       if (s.find(line) != s.npos) ...;           // strategy follows the data
+ *   }
+ *   std::size_t n = s.count(buffer);
+ *
+ *   zuu::str::adaptive_multi_searcher<char> any;
+ *   any.add("WARN"); any.add("ERROR");
+ *   auto m = any.find(buffer);                     // as multi_searcher::find
+ *
+ *   // Instrumentation: every decision, switched or not
+ *   zuu::str::adaptive_options opt{
+ *       .on_decision = [](const zuu::str::search_decision& d, void*) {
+ *           if (d.switched()) log(strategy_name(d.from), strategy_name(d.to));
+ *       }};
+ *   zuu::str::adaptive_searcher<char> traced{"needle", opt};
+ *
+ * Single-pattern strategies:
+ *   filter           SIMD filter on the first and last character (simd::find)
+ *   rare_char        memchr-style scan for the rarest needle character
+ *   two_way          Crochemore-Perrin Two-Way: linear worst case, no filter
+ * Multi-pattern strategies:
+ *   first_char_scan  scan for the set of first characters (multi_searcher)
+ *   aho_corasick     byte-class automaton, one table step per character
+ *
+ * The first call of a window and one in sample_every after it are
+ * followed by a probe over (at most 64K of) the characters they scanned:
+ * vectorized counts of the characters each strategy stops at (at most
+ * four passes), and for up to 64 first-character hits, whether the
+ * filter would stop there and how far it would verify. A window closes
+ * after `window` calls or 4M scanned characters; if enough characters
+ * were probed, those figures pick the strategy for the next window and
+ * the hook sees the decision. Unsampled calls only bump counters.
+ *
+ * Results never depend on the strategy. A searcher keeps views of its
+ * patterns and its statistics are not synchronized: use one per thread.
+ */
+
+#include "../core/core.hpp"
+#include "../core/simd.hpp"
+#include "search.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace zuu::str {
+
+// ==================== Decisions & Hooks ====================
+
+enum class search_strategy : std::uint8_t {
+    filter,
+    rare_char,
+    two_way,
+    first_char_scan,
+    aho_corasick,
+};
+
+[[nodiscard]] constexpr std::string_view strategy_name(search_strategy s) noexcept {
+    switch (s) {
+        case search_strategy::filter:          return "filter";
+        case search_strategy::rare_char:       return "rare_char";
+        case search_strategy::two_way:         return "two_way";
+        case search_strategy::first_char_scan: return "first_char_scan";
+        case search_strategy::aho_corasick:    return "aho_corasick";
+    }
+    return "unknown";
+}
+
+/// What a searcher saw in one window and what it chose for the next
+struct search_decision {
+    search_strategy from;
+    search_strategy to;
+    std::size_t calls;          // calls in the window
+    std::size_t scanned;        // characters those calls scanned
+    std::size_t probed;         // characters the probe counted over
+    double filter_hits;         // positions per character the filter stops at
+    double rare_hits;           // hits per character of the rarest needle character
+    double verify_length;       // characters matched per filter stop (single pattern)
+
+    [[nodiscard]] constexpr bool switched() const noexcept { return from != to; }
+};
+
+using search_hook = void (*)(const search_decision& decision, void* context);
+
+struct adaptive_options {
+    std::size_t window = 64;            // calls per decision
+    std::size_t sample_every = 32;      // probe one call in N
+    bool adapt = true;                  // false: keep the current strategy
+    search_hook on_decision = nullptr;  // called once per decision
+    void* context = nullptr;            // passed to on_decision
+};
+
+/// Totals since construction
+struct search_stats {
+    std::size_t calls = 0;
+    std::size_t scanned = 0;
+    std::size_t probed = 0;
+    std::size_t decisions = 0;
+    std::size_t switches = 0;
+};
+
+namespace detail {
+
+// Fewer probed characters than this are too noisy to act on
+inline constexpr std::size_t min_probe = 4096;
+
+// Characters one probe counts over at most, from the start of the call's range
+inline constexpr std::size_t max_probe = 64u << 10;
+
+// A window also closes after this many scanned characters, however few calls
+inline constexpr std::size_t window_chars = 4u << 20;
+
+// First-character hits per probe checked for filter candidates
+inline constexpr std::size_t probe_candidates = 64;
+
+// Characters the filter verifies per haystack character above which Two-Way wins
+inline constexpr double two_way_work = 4.0;
+
+// Filter stops per character above which a 4x rarer character is worth a scan
+inline constexpr double rare_char_hits = 1.0 / 256;
+
+// First-character hits per character above which the automaton wins
+inline constexpr double aho_corasick_hits = 1.0 / 16;
+inline constexpr double aho_corasick_hits_wide_set = 1.0 / 64;   // > 4 first characters
+
+/**
+ * @brief Prior frequency of a character in text and logs, 0..255
+ * Only seeds the rare-character choice; the probe replaces it with
+ * measured counts.
+ */
+template <meta::character CharT>
+[[nodiscard]] constexpr int char_rank(CharT ch) noexcept {
+    constexpr std::string_view letters = "etaoinshrdlcumwfgypbvkjxqz";
+    constexpr std::string_view common = "\n\t.,-/:=\"_";
+    const auto c = static_cast<std::uint32_t>(static_cast<std::make_unsigned_t<CharT>>(ch));
+    if (c == ' ') return 255;
+    if (c >= 'a' && c <= 'z') return 250 - static_cast<int>(letters.find(static_cast<char>(c)));
+    if (c >= '0' && c <= '9') return 190;
+    if (c < 128 && common.find(static_cast<char>(c)) != std::string_view::npos) return 180;
+    if (c >= 'A' && c <= 'Z') return 170 - static_cast<int>(letters.find(static_cast<char>(c - 'A' + 'a')));
+    if (c > ' ' && c < 127) return 100;
+    return 50;
+}
+
+// ==================== Two-Way ====================
+
+// Critical factorization: needle = needle[0, split) + needle[split, m)
+struct two_way_plan {
+    std::size_t split = 0;
+    std::size_t period = 1;
+    bool periodic = false;
+};
+
+// Start of the maximal suffix under < (or > when `flip`), minus one
+template <meta::character CharT>
+constexpr std::ptrdiff_t maximal_suffix(
+    const CharT* x, std::ptrdiff_t m, bool flip, std::ptrdiff_t& period
+) noexcept {
+    std::ptrdiff_t ip = -1;
+    std::ptrdiff_t jp = 0;
+    std::ptrdiff_t k = 1;
+    std::ptrdiff_t p = 1;
+    while (jp + k < m) {
+        const CharT a = x[ip + k];
+        const CharT b = x[jp + k];
+        if (a == b) {
+            if (k == p) {
+                jp += p;
+                k = 1;
+            } else {
+                ++k;
+            }
+        } else if (flip ? a < b : a > b) {
+            jp += k;
+            k = 1;
+            p = jp - ip;
+        } else {
+            ip = jp++;
+            k = p = 1;
+        }
+    }
+    period = p;
+    return ip;
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr two_way_plan plan_two_way(const CharT* x, std::size_t len) noexcept {
+    const auto m = static_cast<std::ptrdiff_t>(len);
+    std::ptrdiff_t p = 1;
+    std::ptrdiff_t q = 1;
+    std::ptrdiff_t ms = maximal_suffix(x, m, false, p);
+    const std::ptrdiff_t ms2 = maximal_suffix(x, m, true, q);
+    if (ms2 > ms) {
+        ms = ms2;
+        p = q;
+    }
+
+    two_way_plan plan;
+    plan.split = static_cast<std::size_t>(ms + 1);
+    plan.periodic = simd::equal(x, x + p, plan.split);
+    plan.period = plan.periodic ? static_cast<std::size_t>(p)
+                                : static_cast<std::size_t>(std::max(ms, m - ms - 1) + 1);
+    return plan;
+}
+
+// Leftmost occurrence in O(n + m) comparisons whatever the input
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t two_way_find(
+    const CharT* hay, std::size_t n,
+    const CharT* needle, std::size_t m,
+    const two_way_plan& plan
+) noexcept {
+    if (m == 0) return 0;
+    const std::size_t split = plan.split;
+    const std::size_t mem0 = plan.periodic ? m - plan.period : 0;
+    std::size_t mem = 0;
+    for (std::size_t h = 0; h + m <= n;) {
+        // Right part, left to right
+        std::size_t k = std::max(split, mem);
+        while (k < m && needle[k] == hay[h + k]) ++k;
+        if (k < m) {
+            h += k - split + 1;
+            mem = 0;
+            continue;
+        }
+        // Left part, right to left
+        for (k = split; k > mem && needle[k - 1] == hay[h + k - 1]; --k) {}
+        if (k <= mem) return h;
+        h += plan.period;
+        mem = mem0;
+    }
+    return simd::npos;
+}
+
+// Scans for needle[rare] only, verifying the whole needle around each hit
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t rare_char_find(
+    const CharT* hay, std::size_t n,
+    const CharT* needle, std::size_t m,
+    std::size_t rare
+) noexcept {
+    if (m > n) return simd::npos;
+    const std::size_t last = n - m + rare;     // last position the rare character may sit at
+    for (std::size_t i = rare; i <= last;) {
+        const auto at = simd::find_char(hay + i, last + 1 - i, needle[rare]);
+        if (at == simd::npos) break;
+        const std::size_t start = i + at - rare;
+        if (simd::equal(hay + start, needle, m)) return start;
+        i += at + 1;
+    }
+    return simd::npos;
+}
+
+// ==================== Aho-Corasick ====================
+
+/**
+ * @brief Leftmost-first automaton over up to 64 one-byte patterns
+ * Bytes are folded into classes (those in no pattern share class 0),
+ * so the table is states x classes rather than states x 256. Entries
+ * hold the target row's offset, flagged when patterns end there.
+ */
+template <meta::character CharT>
+class aho_corasick {
+public:
+    using view_type = std::basic_string_view<CharT>;
+
+    struct hit {
+        std::size_t pos = simd::npos;
+        std::size_t pattern = simd::npos;
+    };
+
+    void build(const view_type* patterns, std::size_t count) {
+        class_.fill(0);
+        classes_ = 1;
+        for (std::size_t p = 0; p < count; ++p) {
+            for (const CharT ch : patterns[p]) {
+                auto& c = class_[static_cast<unsigned char>(ch)];
+                if (c == 0) c = static_cast<std::uint16_t>(classes_++);
+            }
+        }
+
+        // Trie over state numbers; 0 doubles as "no edge" since nothing leads back to the root
+        next_.assign(classes_, 0);
+        out_.assign(1, 0);
+        depth_.assign(1, 0);
+        for (std::size_t p = 0; p < count; ++p) {
+            std::uint32_t s = 0;
+            for (const CharT ch : patterns[p]) {
+                const std::size_t e = s * classes_ + class_of(ch);
+                if (next_[e] == 0) {
+                    next_[e] = static_cast<std::uint32_t>(out_.size());
+                    next_.resize(next_.size() + classes_, 0);
+                    out_.push_back(0);
+                    depth_.push_back(depth_[s] + 1);
+                }
+                s = next_[e];
+            }
+            out_[s] |= std::uint64_t{1} << p;
+        }
+
+        // Breadth first: fill missing edges through failure links
+        std::vector<std::uint32_t> fail(out_.size(), 0);
+        std::vector<std::uint32_t> queue;
+        queue.reserve(out_.size());
+        for (std::size_t c = 0; c < classes_; ++c) {
+            if (const std::uint32_t t = next_[c]) queue.push_back(t);
+        }
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const std::uint32_t s = queue[head];
+            out_[s] |= out_[fail[s]];
+            for (std::size_t c = 0; c < classes_; ++c) {
+                std::uint32_t& edge = next_[s * classes_ + c];
+                const std::uint32_t via_fail = next_[fail[s] * classes_ + c];
+                if (edge != 0) {
+                    fail[edge] = via_fail;
+                    queue.push_back(edge);
+                } else {
+                    edge = via_fail;
+                }
+            }
+        }
+
+        for (std::uint32_t& edge : next_) {
+            edge = static_cast<std::uint32_t>(edge * classes_) | (out_[edge] != 0 ? match_flag : 0);
+        }
+    }
+
+    /// Leftmost match in hay[pos, n); ties at one position go to the lowest index
+    [[nodiscard]] hit find(view_type hay, std::size_t pos, const view_type* patterns) const noexcept {
+        hit best;
+        std::uint32_t row = 0;
+        for (std::size_t i = pos; i < hay.size(); ++i) {
+            const std::uint32_t edge = next_[row + class_of(hay[i])];
+            row = edge & ~match_flag;
+            if (!(edge & match_flag)) {
+                if (best.pos == simd::npos) continue;
+            } else {
+                for (std::uint64_t out = out_[row / classes_]; out != 0; out &= out - 1) {
+                    const auto p = static_cast<std::size_t>(std::countr_zero(out));
+                    const std::size_t start = i + 1 - patterns[p].size();
+                    if (start < best.pos || (start == best.pos && p < best.pattern)) best = {start, p};
+                }
+            }
+            // Later matches start at i + 1 - depth or after
+            if (best.pos < i + 1 - depth_[row / classes_]) break;
+        }
+        return best;
+    }
+
+private:
+    static constexpr std::uint32_t match_flag = std::uint32_t{1} << 31;
+
+    [[nodiscard]] std::size_t class_of(CharT ch) const noexcept {
+        return class_[static_cast<unsigned char>(ch)];
+    }
+
+    std::array<std::uint16_t, 256> class_{};
+    std::size_t classes_ = 1;
+    std::vector<std::uint32_t> next_;    // states x classes
+    std::vector<std::uint64_t> out_;     // patterns ending in each state
+    std::vector<std::uint32_t> depth_;
+};
+
+// ==================== Probe Window ====================
+
+// Counters of the current decision window
+struct probe_window {
+    std::size_t calls = 0;
+    std::size_t scanned = 0;
+    std::size_t probed = 0;
+    std::size_t hits[4]{};       // per probed character
+    std::size_t firsts = 0;      // first-character hits checked
+    std::size_t pairs = 0;       // of those, filter candidates
+    std::size_t verified = 0;    // characters the candidates matched
+    std::size_t since_probe = 0;
+
+    // Counts a call; returns how many of its characters to probe (0: none)
+    [[nodiscard]] std::size_t record(std::size_t n, std::size_t sample_every) noexcept {
+        ++calls;
+        scanned += n;
+        // The first call of every window is probed
+        if (probed != 0 && ++since_probe < sample_every) return 0;
+        since_probe = 0;
+        n = std::min(n, max_probe);
+        probed += n;
+        return n;
+    }
+
+    [[nodiscard]] bool ready(std::size_t window) const noexcept {
+        return probed >= min_probe && (calls >= window || scanned >= window_chars);
+    }
+};
+
+} // namespace detail
+
+// ==================== Adaptive Single-Pattern Searcher ====================
+
+template <meta::character CharT>
+class adaptive_searcher {
+public:
+    using view_type = std::basic_string_view<CharT>;
+
+    static constexpr std::size_t npos = simd::npos;
+
+    explicit adaptive_searcher(view_type needle, adaptive_options opt = {}) noexcept
+        : needle_{needle}, opt_{opt} {
+        opt_.window = std::max<std::size_t>(opt_.window, 1);
+        opt_.sample_every = std::max<std::size_t>(opt_.sample_every, 1);
+        // One- and zero-character needles have a single sensible scan
+        if (needle_.size() < 2) opt_.adapt = false;
+        if (needle_.empty()) return;
+
+        plan_ = detail::plan_two_way(needle_.data(), needle_.size());
+
+        // Probe the first and last characters and the two rarest by prior
+        const std::size_t m = needle_.size();
+        add_probe(0);
+        add_probe(m - 1);
+        std::size_t order[2] = {npos, npos};
+        for (std::size_t i = 0; i < m; ++i) {
+            const int r = detail::char_rank(needle_[i]);
+            if (order[0] == npos || r < detail::char_rank(needle_[order[0]])) {
+                order[1] = order[0];
+                order[0] = i;
+            } else if (order[1] == npos || r < detail::char_rank(needle_[order[1]])) {
+                order[1] = i;
+            }
+        }
+        rare_ = order[0];
+        for (const std::size_t i : order) {
+            if (i != npos) add_probe(i);
+        }
+    }
+
+    explicit adaptive_searcher(const CharT* needle, adaptive_options opt = {}) noexcept
+        : adaptive_searcher(view_type{needle}, opt) {}
+
+    [[nodiscard]] view_type needle() const noexcept { return needle_; }
+    [[nodiscard]] std::size_t size() const noexcept { return needle_.size(); }
+    [[nodiscard]] search_strategy strategy() const noexcept { return strategy_; }
+    [[nodiscard]] const search_stats& stats() const noexcept { return stats_; }
+
+    /// Switches strategy now; multi-pattern strategies are ignored
+    void use(search_strategy s) noexcept {
+        if (s == search_strategy::filter || s == search_strategy::rare_char || s == search_strategy::two_way) {
+            strategy_ = s;
+        }
+    }
+
+    [[nodiscard]] std::size_t find(view_type hay, std::size_t pos = 0) noexcept {
+        if (pos > hay.size()) return npos;
+        const CharT* p = hay.data() + pos;
+        const std::size_t n = hay.size() - pos;
+        const std::size_t at = run(p, n);
+        observe(p, at == npos ? n : std::min(n, at + needle_.size()));
+        return at == npos ? npos : pos + at;
+    }
+
+    [[nodiscard]] bool contains(view_type hay) noexcept { return find(hay) != npos; }
+
+    /// Non-overlapping occurrences, like str::count
+    [[nodiscard]] std::size_t count(view_type hay) noexcept {
+        const std::size_t m = needle_.size();
+        if (m == 0) return 0;
+        std::size_t cnt = 0;
+        if (m == 1) {
+            cnt = simd::count_char(hay.data(), hay.size(), needle_[0]);
+        } else {
+            for (std::size_t pos = 0; pos < hay.size(); ++cnt) {
+                const std::size_t at = run(hay.data() + pos, hay.size() - pos);
+                if (at == npos) break;
+                pos += at + m;
+            }
+        }
+        observe(hay.data(), hay.size());
+        return cnt;
+    }
+
+private:
+    void add_probe(std::size_t i) noexcept {
+        for (std::size_t k = 0; k < probes_; ++k) {
+            if (needle_[probe_at_[k]] == needle_[i]) return;
+        }
+        probe_at_[probes_++] = i;
+    }
+
+    [[nodiscard]] std::size_t run(const CharT* p, std::size_t n) const noexcept {
+        const std::size_t m = needle_.size();
+        switch (strategy_) {
+            case search_strategy::rare_char: return detail::rare_char_find(p, n, needle_.data(), m, rare_);
+            case search_strategy::two_way:   return detail::two_way_find(p, n, needle_.data(), m, plan_);
+            default:                         return simd::find(p, n, needle_.data(), m);
+        }
+    }
+
+    void observe(const CharT* p, std::size_t scanned) noexcept {
+        ++stats_.calls;
+        stats_.scanned += scanned;
+        if (!opt_.adapt) return;
+        if (const std::size_t n = win_.record(scanned, opt_.sample_every)) {
+            stats_.probed += n;
+            probe(p, n);
+        }
+        if (win_.ready(opt_.window)) decide();
+    }
+
+    void probe(const CharT* p, std::size_t n) noexcept {
+        for (std::size_t k = 0; k < probes_; ++k) {
+            win_.hits[k] += simd::count_char(p, n, needle_[probe_at_[k]]);
+        }
+
+        // Where the filter stops among the first few first-character hits
+        const std::size_t m = needle_.size();
+        std::size_t seen = 0;
+        for (std::size_t i = 0; seen < detail::probe_candidates && i + m <= n; ++seen, ++i) {
+            const auto at = simd::find_char(p + i, n - m + 1 - i, needle_[0]);
+            if (at == npos) break;
+            i += at;
+            if (p[i + m - 1] == needle_[m - 1]) {
+                ++win_.pairs;
+                win_.verified += simd::mismatch(p + i, needle_.data(), m);
+            }
+        }
+        win_.firsts += seen;
+    }
+
+    void decide() noexcept {
+        const double per_char = 1.0 / static_cast<double>(win_.probed);
+        std::size_t rarest = 0;
+        for (std::size_t k = 1; k < probes_; ++k) {
+            if (win_.hits[k] < win_.hits[rarest]) rarest = k;
+        }
+        const double first = static_cast<double>(win_.hits[0]) * per_char;
+        const double filter = win_.firsts == 0 ? 0.0 : first * static_cast<double>(win_.pairs) / static_cast<double>(win_.firsts);
+        const double verify = win_.pairs == 0 ? 0.0 : static_cast<double>(win_.verified) / static_cast<double>(win_.pairs);
+        const double rare = static_cast<double>(win_.hits[rarest]) * per_char;
+
+        // A rarer character beats the filter; with none, long verifications favour Two-Way
+        search_strategy next = search_strategy::filter;
+        if (filter >= detail::rare_char_hits && rare * 4 <= filter) {
+            next = search_strategy::rare_char;
+            rare_ = probe_at_[rarest];
+        } else if (filter * verify >= detail::two_way_work) {
+            next = search_strategy::two_way;
+        }
+
+        const search_decision d{strategy_, next, win_.calls, win_.scanned, win_.probed, filter, rare, verify};
+        ++stats_.decisions;
+        if (d.switched()) ++stats_.switches;
+        strategy_ = next;
+        win_ = {};
+        if (opt_.on_decision) opt_.on_decision(d, opt_.context);
+    }
+
+    view_type needle_;
+    adaptive_options opt_;
+    search_strategy strategy_ = search_strategy::filter;
+    detail::two_way_plan plan_{};
+    std::size_t rare_ = 0;
+    std::size_t probe_at_[4]{};
+    std::size_t probes_ = 0;
+    detail::probe_window win_{};
+    search_stats stats_{};
+};
+
+// ==================== Adaptive Multi-Pattern Searcher ====================
+
+/**
+ * @brief multi_searcher that moves to Aho-Corasick when first characters are dense
+ * The automaton is built on the first switch to it and again after add().
+ * Wide characters always use the first-character scan.
+ */
+template <meta::character CharT, std::size_t MaxPatterns = 16>
+class adaptive_multi_searcher {
+    static_assert(MaxPatterns <= 64, "pattern sets are 64-bit masks");
+
+public:
+    using view_type = std::basic_string_view<CharT>;
+    using scanner_type = multi_searcher<CharT, MaxPatterns>;
+    using match = typename scanner_type::match;
+
+    static constexpr std::size_t npos = simd::npos;
+    static constexpr std::size_t max_patterns = MaxPatterns;
+
+    explicit adaptive_multi_searcher(adaptive_options opt = {}) noexcept : opt_{opt} {
+        opt_.window = std::max<std::size_t>(opt_.window, 1);
+        opt_.sample_every = std::max<std::size_t>(opt_.sample_every, 1);
+        if constexpr (sizeof(CharT) != 1) opt_.adapt = false;
+    }
+
+    // Returns false when the searcher is full
+    bool add(view_type pattern) noexcept {
+        if (!scan_.add(pattern)) return false;
+        patterns_[scan_.size() - 1] = pattern;
+        if (pattern.empty()) {
+            has_empty_ = true;
+        } else if (std::find(firsts_, firsts_ + first_count_, pattern[0]) == firsts_ + first_count_) {
+            firsts_[first_count_++] = pattern[0];
+        }
+        built_ = false;
+        return true;
+    }
+
+    bool add(const CharT* pattern) noexcept { return add(view_type{pattern}); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return scan_.size(); }
+    [[nodiscard]] bool empty() const noexcept { return scan_.empty(); }
+    [[nodiscard]] view_type operator[](std::size_t idx) const noexcept { return scan_[idx]; }
+    [[nodiscard]] search_strategy strategy() const noexcept { return strategy_; }
+    [[nodiscard]] const search_stats& stats() const noexcept { return stats_; }
+
+    /// Switches strategy now; the automaton needs one-byte characters
+    void use(search_strategy s) {
+        if (s == search_strategy::first_char_scan) strategy_ = s;
+        if constexpr (sizeof(CharT) == 1) {
+            if (s == search_strategy::aho_corasick) strategy_ = s;
+        }
+    }
+
+    [[nodiscard]] match find(view_type hay, std::size_t pos = 0) {
+        if (scan_.empty() || pos > hay.size()) return {};
+        match m;
+        if (strategy_ == search_strategy::aho_corasick && !has_empty_) {
+            if (!built_) {
+                automaton_.build(patterns_, scan_.size());
+                built_ = true;
+            }
+            const auto h = automaton_.find(hay, pos, patterns_);
+            if (h.pos != npos) m = {h.pos, h.pattern, patterns_[h.pattern].size()};
+        } else {
+            m = scan_.find(hay, pos);
+        }
+        observe(hay.data() + pos, m ? m.pos + m.length - pos : hay.size() - pos);
+        return m;
+    }
+
+    [[nodiscard]] bool contains(view_type hay) { return static_cast<bool>(find(hay)); }
+
+private:
+    void observe(const CharT* p, std::size_t scanned) noexcept {
+        ++stats_.calls;
+        stats_.scanned += scanned;
+        if (!opt_.adapt) return;
+        if (const std::size_t n = win_.record(scanned, opt_.sample_every)) {
+            stats_.probed += n;
+            if (first_count_ <= 4) {
+                for (std::size_t k = 0; k < first_count_; ++k) win_.hits[0] += simd::count_char(p, n, firsts_[k]);
+            } else {
+                bool table[256]{};
+                for (std::size_t k = 0; k < first_count_; ++k) table[static_cast<unsigned char>(firsts_[k])] = true;
+                for (std::size_t i = 0; i < n; ++i) win_.hits[0] += table[static_cast<unsigned char>(p[i])];
+            }
+        }
+        if (win_.ready(opt_.window)) decide();
+    }
+
+    void decide() noexcept {
+        const double hits = static_cast<double>(win_.hits[0]) / static_cast<double>(win_.probed);
+        // Past four first characters the scan loses its vector path
+        const double limit = first_count_ <= 4 ? detail::aho_corasick_hits : detail::aho_corasick_hits_wide_set;
+        const search_strategy next = hits >= limit ? search_strategy::aho_corasick : search_strategy::first_char_scan;
+
+        const search_decision d{strategy_, next, win_.calls, win_.scanned, win_.probed, hits, hits, 0.0};
+        ++stats_.decisions;
+        if (d.switched()) ++stats_.switches;
+        strategy_ = next;
+        win_ = {};
+        if (opt_.on_decision) opt_.on_decision(d, opt_.context);
+    }
+
+    scanner_type scan_;
+    view_type patterns_[MaxPatterns]{};
+    CharT firsts_[MaxPatterns]{};
+    std::size_t first_count_ = 0;
+    bool has_empty_ = false;
+    bool built_ = false;
+    detail::aho_corasick<CharT> automaton_;
+    adaptive_options opt_;
+    search_strategy strategy_ = search_strategy::first_char_scan;
+    detail::probe_window win_{};
+    search_stats stats_{};
+};
+
+} // namespace zuu::str
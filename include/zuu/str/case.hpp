@@ -50,12 +50,8 @@ constexpr bool is_whitespace(CharT ch) noexcept {
 struct to_lower_fn : pipe_adaptor<to_lower_fn> {
     template <meta::character CharT, std::size_t Cap>
     constexpr auto apply(const basic_fstring<CharT, Cap>& str) const noexcept {
-        basic_fstring<CharT, Cap> result;
-        
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            result.push_back(char_to_lower(str[i]));
-        }
-        
+        basic_fstring<CharT, Cap> result = str;
+        simd::to_lower(result.data(), result.data(), result.size());
         return result;
     }
 
@@ -64,11 +60,8 @@ struct to_lower_fn : pipe_adaptor<to_lower_fn> {
     constexpr auto apply(std::basic_string_view<CharT> sv) const noexcept {
         constexpr std::size_t default_cap = 256;
         basic_fstring<CharT, default_cap> result;
-        
-        for (std::size_t i = 0; i < sv.size() && !result.full(); ++i) {
-            result.push_back(char_to_lower(sv[i]));
-        }
-        
+        result.append(sv.data(), sv.size());
+        simd::to_lower(result.data(), result.data(), result.size());
         return result;
     }
 };
@@ -80,12 +73,8 @@ inline constexpr to_lower_fn to_lower;
 struct to_upper_fn : pipe_adaptor<to_upper_fn> {
     template <meta::character CharT, std::size_t Cap>
     constexpr auto apply(const basic_fstring<CharT, Cap>& str) const noexcept {
-        basic_fstring<CharT, Cap> result;
-        
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            result.push_back(char_to_upper(str[i]));
-        }
-        
+        basic_fstring<CharT, Cap> result = str;
+        simd::to_upper(result.data(), result.data(), result.size());
         return result;
     }
 
@@ -93,11 +82,8 @@ struct to_upper_fn : pipe_adaptor<to_upper_fn> {
     constexpr auto apply(std::basic_string_view<CharT> sv) const noexcept {
         constexpr std::size_t default_cap = 256;
         basic_fstring<CharT, default_cap> result;
-        
-        for (std::size_t i = 0; i < sv.size() && !result.full(); ++i) {
-            result.push_back(char_to_upper(sv[i]));
-        }
-        
+        result.append(sv.data(), sv.size());
+        simd::to_upper(result.data(), result.data(), result.size());
         return result;
     }
 };
@@ -177,6 +163,12 @@ struct toggle_case_fn : pipe_adaptor<toggle_case_fn> {
         
         return result;
     }
+
+    template <meta::character CharT>
+    constexpr auto apply(std::basic_string_view<CharT> sv) const noexcept {
+        constexpr std::size_t default_cap = 256;
+        return apply(basic_fstring<CharT, default_cap>(sv.data(), sv.size()));
+    }
 };
 
 inline constexpr toggle_case_fn toggle_case;
@@ -189,15 +181,18 @@ struct equals_ignore_case_fn {
         const basic_fstring<CharT, Cap1>& lhs,
         const basic_fstring<CharT, Cap2>& rhs
     ) const noexcept {
-        if (lhs.size() != rhs.size()) return false;
-        
-        for (std::size_t i = 0; i < lhs.size(); ++i) {
-            if (char_to_lower(lhs[i]) != char_to_lower(rhs[i])) {
-                return false;
-            }
-        }
-        
-        return true;
+        return lhs.size() == rhs.size() &&
+               simd::equal_ignore_case(lhs.data(), rhs.data(), lhs.size());
+    }
+
+    // Any contiguous range against anything viewable as the same characters
+    template <meta::char_range R>
+    constexpr bool operator()(
+        const R& lhs,
+        std::type_identity_t<std::basic_string_view<meta::range_char_t<R>>> rhs
+    ) const noexcept {
+        const auto a = meta::as_view(lhs);
+        return a.size() == rhs.size() && simd::equal_ignore_case(a.data(), rhs.data(), a.size());
     }
 };
 
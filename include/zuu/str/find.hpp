@@ -4,29 +4,70 @@
  * @file zuu/str/find.hpp
  * @brief Search and find operations with pipe support
  * @version 3.0.0
- * 
+ *
  * Usage:
  *   bool has = contains(str, 'x');
  *   bool has = str | contains('x');
  *   bool starts = starts_with(str, "prefix");
+ *   std::string_view tail = subview(packet, 4);    // no copy
+ *
+ * The searched string may be any contiguous character range: fstrings,
+ * std::strings, string_views into a receive buffer, std::array<char, N>.
+ * Needles may be characters, C strings or such ranges as well.
  */
 
 #include "../core/core.hpp"
 #include "pipe.hpp"
+#include <algorithm>
+#include <string_view>
 
 namespace zuu::str {
 
+namespace detail {
+
+// A search argument that views as a CharT string: a range or a C string
+template <typename N, typename CharT>
+concept needle_of =
+    (meta::char_range<N> && std::same_as<meta::range_char_t<N>, CharT>) ||
+    std::convertible_to<const N&, const CharT*>;
+
+// A null C string behaves as an empty one
+template <meta::character CharT, typename N>
+[[nodiscard]] constexpr std::basic_string_view<CharT> needle_view(const N& needle) noexcept {
+    if constexpr (meta::char_range<N>) {
+        return meta::as_view(needle);
+    } else {
+        const CharT* s = needle;
+        return s ? std::basic_string_view<CharT>{s} : std::basic_string_view<CharT>{};
+    }
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t find_in(
+    std::basic_string_view<CharT> str,
+    std::basic_string_view<CharT> needle,
+    std::size_t pos
+) noexcept {
+    if (needle.empty()) return pos;
+    if (pos > str.size() || needle.size() > str.size() - pos) return simd::npos;
+    const auto at = simd::find(str.data() + pos, str.size() - pos, needle.data(), needle.size());
+    return at == simd::npos ? simd::npos : pos + at;
+}
+
+} // namespace detail
+
 // ==================== Contains (Character) ====================
 
 struct contains_char_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str, 
-        CharT ch
+        const R& str,
+        meta::range_char_t<R> ch
     ) const noexcept {
-        return str.find(ch) != basic_fstring<CharT, Cap>::npos;
+        const auto sv = meta::as_view(str);
+        return simd::find_char(sv.data(), sv.size(), ch) != simd::npos;
     }
-    
+
     // Factory for piping: str | contains('x')
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch) const noexcept {
@@ -39,32 +80,18 @@ struct contains_char_fn {
 // ==================== Contains (String) ====================
 
 struct contains_str_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* substr
+        const R& str,
+        const N& substr
     ) const noexcept {
-        return str.find(substr) != basic_fstring<CharT, Cap>::npos;
+        return detail::find_in(meta::as_view(str), detail::needle_view<meta::range_char_t<R>>(substr), 0) != simd::npos;
     }
-    
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
-    [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& substr
-    ) const noexcept {
-        return str.find(substr.data()) != basic_fstring<CharT, Cap1>::npos;
-    }
-    
+
     // Factory for piping
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* substr) const noexcept {
-        return [substr, this](const auto& str) {
-            return (*this)(str, substr);
-        };
-    }
-    
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& substr) const noexcept {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& substr) const noexcept {
         return [substr, this](const auto& str) {
             return (*this)(str, substr);
         };
@@ -74,31 +101,23 @@ struct contains_str_fn {
 // Combined contains function
 struct contains_fn {
     // Character overload
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch
+        const R& str,
+        meta::range_char_t<R> ch
     ) const noexcept {
         return contains_char_fn{}(str, ch);
     }
-    
+
     // String overload
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* substr
+        const R& str,
+        const N& substr
     ) const noexcept {
         return contains_str_fn{}(str, substr);
     }
-    
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
-    [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& substr
-    ) const noexcept {
-        return contains_str_fn{}(str, substr);
-    }
-    
+
     // Factory for piping (character)
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch) const noexcept {
@@ -106,12 +125,12 @@ struct contains_fn {
             return (*this)(str, ch);
         };
     }
-    
+
     // Factory for piping (string)
-    template <typename T>
-    requires (!std::same_as<T, typename std::decay_t<T>::value_type>)
-    [[nodiscard]] constexpr auto operator()(T&& substr) const noexcept {
-        return [substr = std::forward<T>(substr), this](const auto& str) {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& substr) const noexcept {
+        return [substr, this](const auto& str) {
             return (*this)(str, substr);
         };
     }
@@ -122,45 +141,34 @@ inline constexpr contains_fn contains;
 // ==================== Starts With ====================
 
 struct starts_with_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* prefix
+        const R& str,
+        const N& prefix
     ) const noexcept {
-        return str.starts_with(prefix);
+        const auto sv = meta::as_view(str);
+        const auto p = detail::needle_view<meta::range_char_t<R>>(prefix);
+        return p.size() <= sv.size() && simd::equal(sv.data(), p.data(), p.size());
     }
-    
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
-    [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& prefix
-    ) const noexcept {
-        return str.starts_with(prefix.data());
-    }
-    
-    template <meta::character CharT, std::size_t Cap>
+
+    template <meta::char_range R>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch
+        const R& str,
+        meta::range_char_t<R> ch
     ) const noexcept {
-        return str.starts_with(ch);
+        const auto sv = meta::as_view(str);
+        return !sv.empty() && sv.front() == ch;
     }
-    
+
     // Factory for piping
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* prefix) const noexcept {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& prefix) const noexcept {
         return [prefix, this](const auto& str) {
             return (*this)(str, prefix);
         };
     }
-    
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& prefix) const noexcept {
-        return [prefix, this](const auto& str) {
-            return (*this)(str, prefix);
-        };
-    }
-    
+
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch) const noexcept {
         return [ch, this](const auto& str) {
@@ -174,45 +182,34 @@ inline constexpr starts_with_fn starts_with;
 // ==================== Ends With ====================
 
 struct ends_with_fn {
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* suffix
-    ) const noexcept {
-        return str.ends_with(suffix);
-    }
-    
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& suffix
+        const R& str,
+        const N& suffix
     ) const noexcept {
-        return str.ends_with(suffix.data());
+        const auto sv = meta::as_view(str);
+        const auto s = detail::needle_view<meta::range_char_t<R>>(suffix);
+        return s.size() <= sv.size() && simd::equal(sv.data() + sv.size() - s.size(), s.data(), s.size());
     }
-    
-    template <meta::character CharT, std::size_t Cap>
+
+    template <meta::char_range R>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch
+        const R& str,
+        meta::range_char_t<R> ch
     ) const noexcept {
-        return str.ends_with(ch);
+        const auto sv = meta::as_view(str);
+        return !sv.empty() && sv.back() == ch;
     }
-    
+
     // Factory for piping
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* suffix) const noexcept {
-        return [suffix, this](const auto& str) {
-            return (*this)(str, suffix);
-        };
-    }
-    
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& suffix) const noexcept {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& suffix) const noexcept {
         return [suffix, this](const auto& str) {
             return (*this)(str, suffix);
         };
     }
-    
+
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch) const noexcept {
         return [ch, this](const auto& str) {
@@ -226,24 +223,27 @@ inline constexpr ends_with_fn ends_with;
 // ==================== Find (Return Position) ====================
 
 struct find_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch,
+        const R& str,
+        meta::range_char_t<R> ch,
         std::size_t pos = 0
     ) const noexcept {
-        return str.find(ch, pos);
+        const auto sv = meta::as_view(str);
+        if (pos >= sv.size()) return simd::npos;
+        const auto at = simd::find_char(sv.data() + pos, sv.size() - pos, ch);
+        return at == simd::npos ? simd::npos : pos + at;
     }
-    
-    template <meta::character CharT, std::size_t Cap>
+
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* substr,
+        const R& str,
+        const N& substr,
         std::size_t pos = 0
     ) const noexcept {
-        return str.find(substr, pos);
+        return detail::find_in(meta::as_view(str), detail::needle_view<meta::range_char_t<R>>(substr), pos);
     }
-    
+
     // Factory for piping
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch, std::size_t pos = 0) const noexcept {
@@ -251,9 +251,10 @@ struct find_fn {
             return (*this)(str, ch, pos);
         };
     }
-    
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* substr, std::size_t pos = 0) const noexcept {
+
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& substr, std::size_t pos = 0) const noexcept {
         return [substr, pos, this](const auto& str) {
             return (*this)(str, substr, pos);
         };
@@ -265,19 +266,22 @@ inline constexpr find_fn find;
 // ==================== Reverse Find ====================
 
 struct rfind_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch,
-        std::size_t pos = basic_fstring<CharT, Cap>::npos
+        const R& str,
+        meta::range_char_t<R> ch,
+        std::size_t pos = simd::npos
     ) const noexcept {
-        return str.rfind(ch, pos);
+        const auto sv = meta::as_view(str);
+        if (sv.empty()) return simd::npos;
+        const std::size_t search_end = (pos >= sv.size()) ? sv.size() - 1 : pos;
+        return simd::rfind_char(sv.data(), search_end + 1, ch);
     }
-    
+
     // Factory for piping
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(
-        CharT ch, 
+        CharT ch,
         std::size_t pos = std::size_t(-1)
     ) const noexcept {
         return [ch, pos, this](const auto& str) {
@@ -291,43 +295,25 @@ inline constexpr rfind_fn rfind;
 // ==================== Count Occurrences ====================
 
 struct count_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT ch
+        const R& str,
+        meta::range_char_t<R> ch
     ) const noexcept {
-        std::size_t cnt = 0;
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            if (str[i] == ch) ++cnt;
-        }
-        return cnt;
+        const auto sv = meta::as_view(str);
+        return simd::count_char(sv.data(), sv.size(), ch);
     }
-    
-    template <meta::character CharT, std::size_t Cap>
+
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* substr
+        const R& str,
+        const N& substr
     ) const noexcept {
-        if (substr == nullptr) return 0;
-        
-        std::size_t substr_len = 0;
-        while (substr[substr_len] != CharT{}) ++substr_len;
-        
-        if (substr_len == 0) return 0;
-        
-        std::size_t cnt = 0;
-        std::size_t pos = 0;
-        
-        while (pos < str.size()) {
-            std::size_t found = str.find(substr, pos);
-            if (found == basic_fstring<CharT, Cap>::npos) break;
-            ++cnt;
-            pos = found + substr_len;
-        }
-        
-        return cnt;
+        const auto sv = meta::as_view(str);
+        const auto needle = detail::needle_view<meta::range_char_t<R>>(substr);
+        return simd::count(sv.data(), sv.size(), needle.data(), needle.size());
     }
-    
+
     // Factory for piping
     template <meta::character CharT>
     [[nodiscard]] constexpr auto operator()(CharT ch) const noexcept {
@@ -335,9 +321,10 @@ struct count_fn {
             return (*this)(str, ch);
         };
     }
-    
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* substr) const noexcept {
+
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& substr) const noexcept {
         return [substr, this](const auto& str) {
             return (*this)(str, substr);
         };
@@ -349,48 +336,20 @@ inline constexpr count_fn count;
 // ==================== Find First Of (any character from set) ====================
 
 struct find_first_of_fn {
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& charset
+        const R& str,
+        const N& charset
     ) const noexcept {
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            for (std::size_t j = 0; j < charset.size(); ++j) {
-                if (str[i] == charset[j]) {
-                    return i;
-                }
-            }
-        }
-        return basic_fstring<CharT, Cap1>::npos;
-    }
-    
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* charset
-    ) const noexcept {
-        if (charset == nullptr) return basic_fstring<CharT, Cap>::npos;
-        
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            for (std::size_t j = 0; charset[j] != CharT{}; ++j) {
-                if (str[i] == charset[j]) {
-                    return i;
-                }
-            }
-        }
-        return basic_fstring<CharT, Cap>::npos;
+        const auto sv = meta::as_view(str);
+        const auto set = detail::needle_view<meta::range_char_t<R>>(charset);
+        return simd::find_first_of(sv.data(), sv.size(), set.data(), set.size());
     }
-    
+
     // Factory for piping
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& charset) const noexcept {
-        return [charset, this](const auto& str) {
-            return (*this)(str, charset);
-        };
-    }
-    
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* charset) const noexcept {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& charset) const noexcept {
         return [charset, this](const auto& str) {
             return (*this)(str, charset);
         };
@@ -402,41 +361,25 @@ inline constexpr find_first_of_fn find_first_of;
 // ==================== Find Last Of ====================
 
 struct find_last_of_fn {
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& charset
+        const R& str,
+        const N& charset
     ) const noexcept {
-        for (std::size_t i = str.size(); i > 0; --i) {
-            for (std::size_t j = 0; j < charset.size(); ++j) {
-                if (str[i - 1] == charset[j]) {
-                    return i - 1;
-                }
+        const auto sv = meta::as_view(str);
+        const auto set = detail::needle_view<meta::range_char_t<R>>(charset);
+        for (std::size_t i = sv.size(); i > 0; --i) {
+            if (set.find(sv[i - 1]) != set.npos) {
+                return i - 1;
             }
         }
-        return basic_fstring<CharT, Cap1>::npos;
+        return simd::npos;
     }
-    
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* charset
-    ) const noexcept {
-        if (charset == nullptr) return basic_fstring<CharT, Cap>::npos;
-        
-        for (std::size_t i = str.size(); i > 0; --i) {
-            for (std::size_t j = 0; charset[j] != CharT{}; ++j) {
-                if (str[i - 1] == charset[j]) {
-                    return i - 1;
-                }
-            }
-        }
-        return basic_fstring<CharT, Cap>::npos;
-    }
-    
+
     // Factory for piping
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& charset) const noexcept {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& charset) const noexcept {
         return [charset, this](const auto& str) {
             return (*this)(str, charset);
         };
@@ -448,22 +391,26 @@ inline constexpr find_last_of_fn find_last_of;
 // ==================== Find First Not Of ====================
 
 struct find_first_not_of_fn {
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr std::size_t operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& charset
+        const R& str,
+        const N& charset
     ) const noexcept {
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            bool found = false;
-            for (std::size_t j = 0; j < charset.size(); ++j) {
-                if (str[i] == charset[j]) {
-                    found = true;
-                    break;
-                }
-            }
-            if (!found) return i;
+        const auto sv = meta::as_view(str);
+        const auto set = detail::needle_view<meta::range_char_t<R>>(charset);
+        for (std::size_t i = 0; i < sv.size(); ++i) {
+            if (set.find(sv[i]) == set.npos) return i;
         }
-        return basic_fstring<CharT, Cap1>::npos;
+        return simd::npos;
+    }
+
+    // Factory for piping
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& charset) const noexcept {
+        return [charset, this](const auto& str) {
+            return (*this)(str, charset);
+        };
     }
 };
 
@@ -472,26 +419,19 @@ inline constexpr find_first_not_of_fn find_first_not_of;
 // ==================== Contains Any (Check if any char from set exists) ====================
 
 struct contains_any_fn {
-    template <meta::character CharT, std::size_t Cap>
-    [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const CharT* charset
-    ) const noexcept {
-        return find_first_of_fn{}(str, charset) != basic_fstring<CharT, Cap>::npos;
-    }
-    
-    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
     [[nodiscard]] constexpr bool operator()(
-        const basic_fstring<CharT, Cap1>& str,
-        const basic_fstring<CharT, Cap2>& charset
+        const R& str,
+        const N& charset
     ) const noexcept {
-        return find_first_of_fn{}(str, charset) != basic_fstring<CharT, Cap1>::npos;
+        return find_first_of_fn{}(str, charset) != simd::npos;
     }
-    
+
     // Factory for piping
-    template <typename T>
-    [[nodiscard]] constexpr auto operator()(T&& charset) const noexcept {
-        return [charset = std::forward<T>(charset), this](const auto& str) {
+    template <typename N>
+    requires (!meta::character<N>)
+    [[nodiscard]] constexpr auto operator()(const N& charset) const noexcept {
+        return [charset, this](const auto& str) {
             return (*this)(str, charset);
         };
     }
@@ -499,4 +439,32 @@ struct contains_any_fn {
 
 inline constexpr contains_any_fn contains_any;
 
-} // namespace zuu::str
\ No newline at end of file
+// ==================== Substring View ====================
+
+/**
+ * @brief substr without the copy: [pos, pos + count) clamped to the string
+ * The view borrows from `str`, so `str` must outlive it (pipe named
+ * strings, not temporaries).
+ */
+struct subview_fn {
+    template <meta::char_range R>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        std::size_t pos,
+        std::size_t count = simd::npos
+    ) const noexcept {
+        const auto sv = meta::as_view(str);
+        return sv.substr(std::min(pos, sv.size()), count);
+    }
+
+    // Factory for piping: str | subview(4)
+    [[nodiscard]] constexpr auto operator()(std::size_t pos, std::size_t count = simd::npos) const noexcept {
+        return [pos, count, this](const auto& str) {
+            return (*this)(str, pos, count);
+        };
+    }
+};
+
+inline constexpr subview_fn subview;
+
+} // namespace zuu::str
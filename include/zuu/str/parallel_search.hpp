@@ -0,0 +1,269 @@
+#pragma once
+
+/**
+ * @file zuu/str/parallel_search.hpp
+ * @brief Multi-threaded find, count and find_all over one large buffer
+ * @version 3.0.0
+ *
+ * Usage:
+ *   std::string_view dump = mapped_file();                    // e.g. 800 MB
+ *   std::size_t at = zuu::str::parallel_find(dump, "ERROR");  // first match
+ *   std::size_t n  = zuu::str::parallel_count(dump, '\n');
+ *   std::vector<std::size_t> hits = zuu::str::parallel_find_all(dump, "GET /");
+ *
+ *   // Fewer threads, smaller tasks
+ *   n = zuu::str::parallel_count(dump, "\r\n", {.threads = 4, .min_chunk = 1 << 18});
+ *
+ * The buffer is cut into 64-aligned chunks that workers claim in order
+ * and scan with the SIMD kernels. A chunk owns the matches that start in
+ * it; its search window runs needle length - 1 characters into the next
+ * chunk, so boundary matches are neither lost nor found twice.
+ *
+ * Results equal the single-threaded ones: parallel_find returns the
+ * leftmost match (chunks past an already found match are skipped), and
+ * count / find_all report the same non-overlapping leftmost matches as
+ * str::count. A match running over a chunk boundary shifts where the
+ * next chunk's matches may start; only such chunks are rescanned.
+ */
+
+#include "../core/core.hpp"
+#include "../core/parallel.hpp"
+#include "find.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string_view>
+#include <vector>
+
+namespace zuu::str {
+
+struct parallel_search_options {
+    std::size_t threads = 0;             // 0 = all hardware threads
+    std::size_t min_chunk = 1u << 20;    // characters per task, lower bound
+};
+
+namespace detail {
+
+[[nodiscard]] inline std::size_t search_chunk(const parallel_search_options& opt) noexcept {
+    return (std::max<std::size_t>(opt.min_chunk, 64) + 63) & ~std::size_t{63};
+}
+
+/**
+ * @brief Leftmost non-overlapping matches starting in [from, e)
+ * Returns where the next chunk's scan starts: e, or later when the last
+ * match runs over the boundary.
+ */
+template <meta::character CharT, typename Sink>
+std::size_t scan_matches(
+    std::basic_string_view<CharT> hay,
+    std::basic_string_view<CharT> needle,
+    std::size_t from, std::size_t e,
+    Sink&& sink
+) {
+    const std::size_t m = needle.size();
+    const std::size_t limit = std::min(hay.size(), e + m - 1);
+    std::size_t pos = from;
+    while (pos < e) {
+        const auto at = simd::find(hay.data() + pos, limit - pos, needle.data(), m);
+        if (at == simd::npos) break;
+        sink(pos + at);
+        pos += at + m;
+    }
+    return std::max(pos, e);
+}
+
+struct count_chunk {
+    std::size_t count = 0;
+    std::size_t resume = 0;
+    void add(std::size_t) noexcept { ++count; }
+};
+
+struct list_chunk {
+    std::vector<std::size_t> positions;
+    std::size_t resume = 0;
+    void add(std::size_t p) { positions.push_back(p); }
+};
+
+// Scans every chunk in parallel, then fixes up chunks entered past their start
+template <typename Chunk, meta::character CharT>
+std::vector<Chunk> match_chunks(
+    std::basic_string_view<CharT> hay,
+    std::basic_string_view<CharT> needle,
+    const parallel_search_options& opt
+) {
+    const std::size_t n = hay.size();
+    const std::size_t chunk = search_chunk(opt);
+    const std::size_t tasks = (n + chunk - 1) / chunk;
+    std::vector<Chunk> chunks(tasks);
+
+    const auto scan = [&](std::size_t t, std::size_t from) {
+        chunks[t] = Chunk{};
+        chunks[t].resume = scan_matches(hay, needle, from, std::min(n, (t + 1) * chunk),
+                                        [&](std::size_t p) { chunks[t].add(p); });
+    };
+    par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) { scan(t, t * chunk); });
+
+    for (std::size_t t = 1; t < tasks; ++t) {
+        if (chunks[t - 1].resume > t * chunk) scan(t, chunks[t - 1].resume);
+    }
+    return chunks;
+}
+
+} // namespace detail
+
+// ==================== Parallel Find ====================
+
+/**
+ * @brief Position of the first occurrence, or npos
+ * An empty needle matches at 0, as with find.
+ */
+struct parallel_find_fn {
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
+    [[nodiscard]] std::size_t operator()(
+        const R& hay,
+        const N& needle,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), detail::needle_view<meta::range_char_t<R>>(needle), opt);
+    }
+
+    template <meta::char_range R>
+    [[nodiscard]] std::size_t operator()(
+        const R& hay,
+        meta::range_char_t<R> ch,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), std::basic_string_view<meta::range_char_t<R>>{&ch, 1}, opt);
+    }
+
+private:
+    template <meta::character CharT>
+    static std::size_t run(
+        std::basic_string_view<CharT> hay,
+        std::basic_string_view<CharT> needle,
+        const parallel_search_options& opt
+    ) {
+        const std::size_t n = hay.size();
+        const std::size_t m = needle.size();
+        if (m == 0) return 0;
+        if (m > n) return simd::npos;
+
+        const std::size_t chunk = detail::search_chunk(opt);
+        const std::size_t tasks = (n + chunk - 1) / chunk;
+        std::atomic<std::size_t> first{simd::npos};
+
+        par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) {
+            const std::size_t b = t * chunk;
+            if (b >= first.load(std::memory_order_relaxed)) return;
+            const std::size_t limit = std::min(n, b + chunk + m - 1);
+            const auto at = simd::find(hay.data() + b, limit - b, needle.data(), m);
+            if (at == simd::npos) return;
+
+            std::size_t best = first.load(std::memory_order_relaxed);
+            while (b + at < best && !first.compare_exchange_weak(best, b + at, std::memory_order_relaxed)) {}
+        });
+        return first.load();
+    }
+};
+
+inline constexpr parallel_find_fn parallel_find;
+
+// ==================== Parallel Count ====================
+
+/**
+ * @brief Number of non-overlapping occurrences, as str::count
+ */
+struct parallel_count_fn {
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
+    [[nodiscard]] std::size_t operator()(
+        const R& hay,
+        const N& needle,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), detail::needle_view<meta::range_char_t<R>>(needle), opt);
+    }
+
+    template <meta::char_range R>
+    [[nodiscard]] std::size_t operator()(
+        const R& hay,
+        meta::range_char_t<R> ch,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), std::basic_string_view<meta::range_char_t<R>>{&ch, 1}, opt);
+    }
+
+private:
+    template <meta::character CharT>
+    static std::size_t run(
+        std::basic_string_view<CharT> hay,
+        std::basic_string_view<CharT> needle,
+        const parallel_search_options& opt
+    ) {
+        if (needle.empty() || needle.size() > hay.size()) return 0;
+
+        if (needle.size() == 1) {
+            const std::size_t chunk = detail::search_chunk(opt);
+            const std::size_t tasks = (hay.size() + chunk - 1) / chunk;
+            std::vector<std::size_t> counts(tasks);
+            par::for_each_task(tasks, opt.threads, [&](std::size_t t, std::size_t) {
+                const std::size_t b = t * chunk;
+                counts[t] = simd::count_char(hay.data() + b, std::min(chunk, hay.size() - b), needle[0]);
+            });
+            std::size_t total = 0;
+            for (std::size_t c : counts) total += c;
+            return total;
+        }
+
+        std::size_t total = 0;
+        for (const auto& c : detail::match_chunks<detail::count_chunk>(hay, needle, opt)) total += c.count;
+        return total;
+    }
+};
+
+inline constexpr parallel_count_fn parallel_count;
+
+// ==================== Parallel Find All ====================
+
+/**
+ * @brief Ascending positions of the matches parallel_count counts
+ */
+struct parallel_find_all_fn {
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> N>
+    [[nodiscard]] std::vector<std::size_t> operator()(
+        const R& hay,
+        const N& needle,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), detail::needle_view<meta::range_char_t<R>>(needle), opt);
+    }
+
+    template <meta::char_range R>
+    [[nodiscard]] std::vector<std::size_t> operator()(
+        const R& hay,
+        meta::range_char_t<R> ch,
+        const parallel_search_options& opt = {}
+    ) const {
+        return run(meta::as_view(hay), std::basic_string_view<meta::range_char_t<R>>{&ch, 1}, opt);
+    }
+
+private:
+    template <meta::character CharT>
+    static std::vector<std::size_t> run(
+        std::basic_string_view<CharT> hay,
+        std::basic_string_view<CharT> needle,
+        const parallel_search_options& opt
+    ) {
+        std::vector<std::size_t> all;
+        if (needle.empty() || needle.size() > hay.size()) return all;
+
+        auto chunks = detail::match_chunks<detail::list_chunk>(hay, needle, opt);
+        std::size_t total = 0;
+        for (const auto& c : chunks) total += c.positions.size();
+        all.reserve(total);
+        for (const auto& c : chunks) all.insert(all.end(), c.positions.begin(), c.positions.end());
+        return all;
+    }
+};
+
+inline constexpr parallel_find_all_fn parallel_find_all;
+
+} // namespace zuu::str
@@ -0,0 +1,373 @@
+#pragma once
+
+/**
+ * @file zuu/str/path.hpp
+ * @brief Allocation-free, constexpr path manipulation on fstrings
+ * @version 3.0.0
+ *
+ * Usage:
+ *   types::path_str p = "/srv/www/../static/./img//logo.png";
+ *   path::normalize_in_place(p);          // "/srv/static/img/logo.png"
+ *   path::filename(p);                    // "logo.png"   (view into p)
+ *   path::stem(p);                        // "logo"
+ *   path::extension(p);                   // ".png"
+ *   path::parent(p);                      // "/srv/static/img"
+ *   auto q = path::join(p | path::parent, "icon.svg");
+ *   auto r = path::relative_to(p, "/srv");   // "static/img/logo.png"
+ *   auto n = raw | path::normalize;       // piped, same capacity
+ *
+ * Separators are '/'. Query functions return views into their argument;
+ * builders return basic_fstring of the argument's capacity (260, the
+ * path_str capacity, for plain views) and truncate like every fstring
+ * operation. Everything is purely lexical: no filesystem access.
+ */
+
+#include "../core/core.hpp"
+#include "pipe.hpp"
+#include <string_view>
+#include <type_traits>
+
+namespace zuu::path {
+
+/// Capacity of results built from plain views (matches types::path_str)
+inline constexpr std::size_t default_capacity = 260;
+
+namespace detail {
+
+template <meta::character CharT>
+[[nodiscard]] constexpr bool is_dot(std::basic_string_view<CharT> seg) noexcept {
+    return seg.size() == 1 && seg[0] == CharT('.');
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr bool is_dot_dot(std::basic_string_view<CharT> seg) noexcept {
+    return seg.size() == 2 && seg[0] == CharT('.') && seg[1] == CharT('.');
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t next_separator(std::basic_string_view<CharT> sv, std::size_t from) noexcept {
+    const std::size_t at = simd::find_char(sv.data() + from, sv.size() - from, CharT('/'));
+    return at == simd::npos ? sv.size() : from + at;
+}
+
+/**
+ * @brief One-pass normalization of src into out, returning the length
+ * `out` may alias `src`: the write position never passes the read one.
+ */
+template <meta::character CharT>
+constexpr std::size_t normalize_into(std::basic_string_view<CharT> src, CharT* out) noexcept {
+    const std::size_t n = src.size();
+    const bool absolute = n > 0 && src[0] == CharT('/');
+    std::size_t w = 0;
+    if (absolute) out[w++] = CharT('/');
+    std::size_t floor = w;   // out[0, floor) is the root or leading ".." segments
+
+    for (std::size_t i = 0; i < n;) {
+        while (i < n && src[i] == CharT('/')) ++i;
+        if (i == n) break;
+        const std::size_t j = next_separator(src, i);
+        const std::basic_string_view<CharT> seg = src.substr(i, j - i);
+        const bool up = is_dot_dot(seg);   // classify before the copy overwrites seg
+
+        if (is_dot(seg)) {
+            // drop
+        } else if (up && w > floor) {
+            std::size_t k = w;
+            while (k > floor && out[k - 1] != CharT('/')) --k;
+            w = k > floor ? k - 1 : floor;
+        } else if (!(up && absolute)) {   // "/.." is "/"
+            if (w > 0 && out[w - 1] != CharT('/')) out[w++] = CharT('/');
+            for (std::size_t k = 0; k < seg.size(); ++k) out[w++] = src[i + k];
+            if (up) floor = w;
+        }
+        i = j;
+    }
+    if (w == 0) out[w++] = CharT('.');
+    return w;
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::basic_string_view<CharT> filename_of(std::basic_string_view<CharT> sv) noexcept {
+    const std::size_t sep = simd::rfind_char(sv.data(), sv.size(), CharT('/'));
+    return sep == simd::npos ? sv : sv.substr(sep + 1);
+}
+
+template <meta::character CharT>
+[[nodiscard]] constexpr std::size_t extension_at(std::basic_string_view<CharT> name) noexcept {
+    if (is_dot(name) || is_dot_dot(name)) return name.size();
+    const std::size_t dot = simd::rfind_char(name.data(), name.size(), CharT('.'));
+    return (dot == simd::npos || dot == 0) ? name.size() : dot;
+}
+
+} // namespace detail
+
+// ==================== Queries (views) ====================
+
+/**
+ * @brief Final component; empty when the path ends in '/'
+ */
+struct filename_fn : str::view_pipe<filename_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> apply(std::basic_string_view<CharT> sv) const noexcept {
+        return detail::filename_of(sv);
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        return apply(std::basic_string_view<CharT>{p.data(), p.size()});
+    }
+};
+
+inline constexpr filename_fn filename;
+
+/**
+ * @brief Everything before the final component ("/" for "/a", "" for "a")
+ */
+struct parent_fn : str::view_pipe<parent_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> apply(std::basic_string_view<CharT> sv) const noexcept {
+        std::size_t end = simd::rfind_char(sv.data(), sv.size(), CharT('/'));
+        if (end == simd::npos) return sv.substr(0, 0);
+        while (end > 0 && sv[end - 1] == CharT('/')) --end;
+        return sv.substr(0, end == 0 ? 1 : end);
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        return apply(std::basic_string_view<CharT>{p.data(), p.size()});
+    }
+};
+
+inline constexpr parent_fn parent;
+
+/**
+ * @brief Filename suffix from the last '.', including it
+ * Empty for "name", ".hidden", "." and "..".
+ */
+struct extension_fn : str::view_pipe<extension_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> apply(std::basic_string_view<CharT> sv) const noexcept {
+        const auto name = detail::filename_of(sv);
+        return name.substr(detail::extension_at(name));
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        return apply(std::basic_string_view<CharT>{p.data(), p.size()});
+    }
+};
+
+inline constexpr extension_fn extension;
+
+/**
+ * @brief Filename without its extension
+ */
+struct stem_fn : str::view_pipe<stem_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> apply(std::basic_string_view<CharT> sv) const noexcept {
+        const auto name = detail::filename_of(sv);
+        return name.substr(0, detail::extension_at(name));
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        return apply(std::basic_string_view<CharT>{p.data(), p.size()});
+    }
+};
+
+inline constexpr stem_fn stem;
+
+struct is_absolute_fn : str::view_pipe<is_absolute_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr bool apply(std::basic_string_view<CharT> sv) const noexcept {
+        return !sv.empty() && sv[0] == CharT('/');
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        return apply(std::basic_string_view<CharT>{p.data(), p.size()});
+    }
+};
+
+inline constexpr is_absolute_fn is_absolute;
+
+// ==================== Normalize ====================
+
+/**
+ * @brief Collapse ".", ".." and repeated '/' in place, in one pass
+ * ".." never climbs above the root of an absolute path, is kept when it
+ * leads a relative one, and a trailing '/' is dropped. An empty result
+ * becomes ".".
+ */
+template <meta::editable_string S>
+constexpr S& normalize_in_place(S& p) noexcept {
+    using CharT = meta::range_char_t<S>;
+    if (p.empty()) return p.append(CharT('.'));
+    const std::basic_string_view<CharT> src{p.data(), p.size()};
+    p.resize(detail::normalize_into(src, p.data()));
+    return p;
+}
+
+struct normalize_fn : str::view_pipe<normalize_fn> {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr auto apply(std::basic_string_view<CharT> sv) const noexcept {
+        basic_fstring<CharT, default_capacity> result(sv.data(), sv.size());
+        return normalize_in_place(result);
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& p) const noexcept {
+        basic_fstring<CharT, Cap> result = p;
+        return normalize_in_place(result);
+    }
+};
+
+inline constexpr normalize_fn normalize;
+
+// ==================== Join ====================
+
+/**
+ * @brief Append `rel` as a new component; an absolute `rel` replaces `p`
+ */
+template <meta::editable_string S>
+constexpr S& append(S& p, std::basic_string_view<meta::range_char_t<S>> rel) noexcept {
+    using CharT = meta::range_char_t<S>;
+    if (!rel.empty() && rel[0] == CharT('/')) {
+        p.clear();
+    } else if (!p.empty() && !rel.empty() && p.back() != CharT('/')) {
+        p.append(CharT('/'));
+    }
+    p.append(rel.data(), rel.size());
+    return p;
+}
+
+struct join_fn {
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr basic_fstring<CharT, Cap> operator()(
+        const basic_fstring<CharT, Cap>& base, std::type_identity_t<std::basic_string_view<CharT>> rel
+    ) const noexcept {
+        basic_fstring<CharT, Cap> result = base;
+        return append(result, rel);
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr basic_fstring<CharT, default_capacity> operator()(
+        std::basic_string_view<CharT> base, std::type_identity_t<std::basic_string_view<CharT>> rel
+    ) const noexcept {
+        basic_fstring<CharT, default_capacity> result(base.data(), base.size());
+        return append(result, rel);
+    }
+
+    // Other contiguous ranges (std::string, fstring_ref, ...)
+    template <meta::char_range R>
+    [[nodiscard]] constexpr auto operator()(
+        const R& base, std::type_identity_t<std::basic_string_view<meta::range_char_t<R>>> rel
+    ) const noexcept {
+        return (*this)(meta::as_view(base), rel);
+    }
+
+    // Factory for piping: p | path::join("file.txt")
+    template <meta::character CharT>
+    [[nodiscard]] constexpr auto operator()(const CharT* rel) const noexcept {
+        return str::make_closure(*this, std::basic_string_view<CharT>{rel});
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& rel) const noexcept {
+        return str::make_closure(*this, rel);
+    }
+};
+
+inline constexpr join_fn join;
+
+// ==================== Relative ====================
+
+/**
+ * @brief Lexical path from `base` to `p` (both normalized first)
+ * "." when they are equal; empty when one is absolute and the other
+ * not, or when `base` has ".." components left that cannot be undone.
+ */
+struct relative_to_fn {
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr basic_fstring<CharT, Cap> operator()(
+        const basic_fstring<CharT, Cap>& p, std::type_identity_t<std::basic_string_view<CharT>> base
+    ) const noexcept {
+        return relative<Cap>(std::basic_string_view<CharT>{p}, base);
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr basic_fstring<CharT, default_capacity> operator()(
+        std::basic_string_view<CharT> p, std::type_identity_t<std::basic_string_view<CharT>> base
+    ) const noexcept {
+        return relative<default_capacity>(p, base);
+    }
+
+    template <meta::char_range R>
+    [[nodiscard]] constexpr auto operator()(
+        const R& p, std::type_identity_t<std::basic_string_view<meta::range_char_t<R>>> base
+    ) const noexcept {
+        return relative<default_capacity>(meta::as_view(p), base);
+    }
+
+    // Factory for piping: p | path::relative_to("/srv")
+    template <meta::character CharT>
+    [[nodiscard]] constexpr auto operator()(const CharT* base) const noexcept {
+        return str::make_closure(*this, std::basic_string_view<CharT>{base});
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, Cap>& base) const noexcept {
+        return str::make_closure(*this, base);
+    }
+
+private:
+    template <std::size_t Cap, meta::character CharT>
+    static constexpr basic_fstring<CharT, Cap> relative(
+        std::basic_string_view<CharT> p_raw, std::basic_string_view<CharT> base_raw
+    ) noexcept {
+        basic_fstring<CharT, Cap> result;
+        basic_fstring<CharT, Cap> p(p_raw.data(), p_raw.size());
+        basic_fstring<CharT, Cap> base(base_raw.data(), base_raw.size());
+        normalize_in_place(p);
+        normalize_in_place(base);
+        const std::basic_string_view<CharT> a{p}, b{base};
+        if (is_absolute(a) != is_absolute(b)) return result;
+
+        // Next component at i, or empty at the end ("." only survives
+        // normalization as the whole path and counts as no component)
+        const auto next = [](std::basic_string_view<CharT> s, std::size_t& i) {
+            while (i < s.size() && s[i] == CharT('/')) ++i;
+            const std::size_t j = detail::next_separator(s, i);
+            const auto seg = s.substr(i, j - i);
+            i = j;
+            return detail::is_dot(seg) ? s.substr(0, 0) : seg;
+        };
+        std::size_t i = 0, k = 0;
+        for (;;) {
+            std::size_t i2 = i, k2 = k;
+            const auto sa = next(a, i2);
+            const auto sb = next(b, k2);
+            if (sa.empty() || sb.empty() || sa != sb) break;
+            i = i2;
+            k = k2;
+        }
+
+        // One ".." per base component left over
+        constexpr CharT up[] = {CharT('.'), CharT('.')};
+        for (std::size_t k2 = k;;) {
+            const auto sb = next(b, k2);
+            if (sb.empty()) break;
+            if (detail::is_dot_dot(sb)) return result;
+            append(result, std::basic_string_view<CharT>{up, 2});
+        }
+        while (i < a.size() && a[i] == CharT('/')) ++i;
+        const auto rest = a.substr(i);
+        if (!detail::is_dot(rest)) append(result, rest);
+        if (result.empty()) result.append(CharT('.'));
+        return result;
+    }
+};
+
+inline constexpr relative_to_fn relative_to;
+
+} // namespace zuu::path
@@ -6,10 +6,12 @@
  * @version 3.0.0
  * 
  * Enables: str | trim | to_upper | split(',')
+ *          line | filter(pred) | trim   // std::optional, short-circuits
  */
 
 #include "../meta/concepts.hpp"
 #include "../meta/traits.hpp"
+#include <optional>
 #include <tuple>
 #include <utility>
 
@@ -37,10 +39,17 @@ struct pipe_adaptor {
     }
 
 private:
-    // Helper function instantiated only when called (Derived is complete by then)
+    // Helper function instantiated only when called (Derived is complete by then).
+    // Contiguous ranges no apply() overload takes (std::string, fstring_ref, ...)
+    // run through the string_view overload.
     template <typename Self, meta::string_like Str>
     static constexpr auto pipe_impl(const Self& self, Str&& str) {
-        return static_cast<const Derived&>(self).apply(std::forward<Str>(str));
+        const auto& derived = static_cast<const Derived&>(self);
+        if constexpr (requires { derived.apply(std::forward<Str>(str)); }) {
+            return derived.apply(std::forward<Str>(str));
+        } else {
+            return derived.apply(meta::as_view(str));
+        }
     }
 
 public:
@@ -118,6 +127,54 @@ private:
     }
 };
 
+// ==================== Stage Detection ====================
+
+template <typename T>
+struct is_optional : std::false_type {};
+
+template <typename T>
+struct is_optional<std::optional<T>> : std::true_type {};
+
+template <typename T>
+inline constexpr bool is_optional_v = is_optional<std::remove_cvref_t<T>>::value;
+
+/**
+ * @brief Anything that can sit on the right of `|` without being a value
+ * 
+ * Strings and optional results are values flowing through a pipeline;
+ * stages are function objects (adaptors, closures, lambdas) or function
+ * pointers. Plain values such as C strings never compose.
+ */
+template <typename T>
+concept pipe_stage = 
+    !meta::string_like<std::remove_cvref_t<T>> &&
+    !is_optional_v<T> &&
+    (std::is_class_v<std::remove_cvref_t<T>> ||
+     std::is_function_v<std::remove_pointer_t<std::decay_t<T>>>);
+
+// ==================== Application Operators ====================
+
+// Application: str | fn (lambdas and other plain callables)
+template <meta::string_like Str, pipe_stage Fn>
+requires std::invocable<const Fn&, Str>
+constexpr auto operator|(Str&& str, const Fn& fn) {
+    return fn(std::forward<Str>(str));
+}
+
+// Propagation: a rejected value skips the stage, an accepted one flows on
+template <typename T, pipe_stage Fn>
+constexpr auto operator|(const std::optional<T>& opt, const Fn& fn) {
+    using stage_t = decltype(*opt | fn);
+    if constexpr (is_optional_v<stage_t>) {
+        if (!opt) return stage_t{};
+        return *opt | fn;
+    } else {
+        using result_t = std::optional<stage_t>;
+        if (!opt) return result_t{};
+        return result_t{*opt | fn};
+    }
+}
+
 // ==================== Compose Multiple Pipes ====================
 
 /**
@@ -136,7 +193,7 @@ struct composed_pipe {
 
     template <meta::string_like Str>
     constexpr auto operator()(Str&& str) const {
-        return second(first(std::forward<Str>(str)));
+        return std::forward<Str>(str) | first | second;
     }
 
     template <meta::string_like Str>
@@ -145,14 +202,152 @@ struct composed_pipe {
     }
 };
 
-// Composition operator for pipes
-template <typename Fn1, typename Fn2>
-requires requires(Fn1 f1, Fn2 f2) {
-    { f1 } -> std::convertible_to<Fn1>;
-    { f2 } -> std::convertible_to<Fn2>;
+// ==================== Short-Circuiting Stages ====================
+
+/**
+ * @brief Tag for predicates that only inspect the raw pipeline input
+ * 
+ * A hoisted filter is moved to the front when composed into a fused
+ * pipeline, so `trim | to_lower | filter(hoist, pred)` checks `pred`
+ * before paying for either transform.
+ */
+struct hoist_t {
+    explicit constexpr hoist_t() = default;
+};
+
+inline constexpr hoist_t hoist{};
+
+/**
+ * @brief Keeps the value when `pred(str)` holds, rejects it otherwise
+ * 
+ * Produces `std::optional`; every later stage is skipped on rejection.
+ */
+template <typename Pred, bool Hoisted = false>
+struct filter_fn {
+    Pred pred;
+
+    constexpr explicit filter_fn(Pred p) : pred{std::move(p)} {}
+
+    template <meta::string_like Str>
+    constexpr auto operator()(Str&& str) const {
+        using result_t = std::optional<std::remove_cvref_t<Str>>;
+        if (!pred(std::as_const(str))) return result_t{};
+        return result_t{std::forward<Str>(str)};
+    }
+
+    template <meta::string_like Str>
+    friend constexpr auto operator|(Str&& str, const filter_fn& f) {
+        return f(std::forward<Str>(str));
+    }
+};
+
+template <typename Pred>
+constexpr auto filter(Pred&& pred) {
+    return filter_fn<std::decay_t<Pred>>{std::forward<Pred>(pred)};
+}
+
+template <typename Pred>
+constexpr auto filter(hoist_t, Pred&& pred) {
+    return filter_fn<std::decay_t<Pred>, true>{std::forward<Pred>(pred)};
 }
+
+/**
+ * @brief Keeps the leading run of characters satisfying `pred`
+ * 
+ * Rejects the value when the run is empty.
+ */
+template <typename Pred>
+struct take_while_fn {
+    Pred pred;
+
+    constexpr explicit take_while_fn(Pred p) : pred{std::move(p)} {}
+
+    template <meta::string_like Str>
+    constexpr auto operator()(Str&& str) const {
+        using value_t = std::remove_cvref_t<Str>;
+        using result_t = std::optional<value_t>;
+        
+        // Borrowed ranges (fstring_ref, spans) yield a view instead:
+        // resizing the copy would shorten the text they refer to
+        if constexpr (std::ranges::borrowed_range<value_t> && meta::char_range<value_t> &&
+                      !std::same_as<value_t, std::basic_string_view<meta::range_char_t<value_t>>>) {
+            return (*this)(meta::as_view(str));
+        } else {
+            std::size_t n = 0;
+            while (n < str.size() && pred(str.data()[n])) ++n;
+            if (n == 0) return result_t{};
+            
+            value_t out = std::forward<Str>(str);
+            if constexpr (requires { out.resize(n); }) {
+                out.resize(n);
+            } else {
+                out.remove_suffix(out.size() - n);
+            }
+            return result_t{std::move(out)};
+        }
+    }
+
+    template <meta::string_like Str>
+    friend constexpr auto operator|(Str&& str, const take_while_fn& t) {
+        return t(std::forward<Str>(str));
+    }
+};
+
+template <typename Pred>
+constexpr auto take_while(Pred&& pred) {
+    return take_while_fn<std::decay_t<Pred>>{std::forward<Pred>(pred)};
+}
+
+/**
+ * @brief Runs `stage` only when `pred(str)` holds, rejects otherwise
+ * 
+ * Equivalent to `filter(pred) | stage` packaged as a single stage.
+ */
+template <typename Pred, typename Stage>
+struct when_fn {
+    Pred pred;
+    Stage stage;
+
+    constexpr when_fn(Pred p, Stage s) 
+        : pred{std::move(p)}, stage{std::move(s)} {}
+
+    template <meta::string_like Str>
+    constexpr auto operator()(Str&& str) const {
+        using stage_t = decltype(std::forward<Str>(str) | stage);
+        if constexpr (is_optional_v<stage_t>) {
+            if (!pred(std::as_const(str))) return stage_t{};
+            return std::forward<Str>(str) | stage;
+        } else {
+            using result_t = std::optional<stage_t>;
+            if (!pred(std::as_const(str))) return result_t{};
+            return result_t{std::forward<Str>(str) | stage};
+        }
+    }
+
+    template <meta::string_like Str>
+    friend constexpr auto operator|(Str&& str, const when_fn& w) {
+        return w(std::forward<Str>(str));
+    }
+};
+
+template <typename Pred, typename Stage>
+constexpr auto when(Pred&& pred, Stage&& stage) {
+    return when_fn<std::decay_t<Pred>, std::decay_t<Stage>>{
+        std::forward<Pred>(pred),
+        std::forward<Stage>(stage)
+    };
+}
+
+// Composition operator for pipes
+template <pipe_stage Fn1, pipe_stage Fn2>
 constexpr auto operator|(Fn1 f1, Fn2 f2) {
     return composed_pipe{std::move(f1), std::move(f2)};
 }
 
+// Hoisting: a raw-input filter runs before everything composed ahead of it
+template <pipe_stage Fn1, typename Pred>
+constexpr auto operator|(Fn1 f1, filter_fn<Pred, true> f2) {
+    return composed_pipe{std::move(f2), std::move(f1)};
+}
+
 } // namespace zuu::str
\ No newline at end of file
@@ -0,0 +1,340 @@
+#pragma once
+
+/**
+ * @file zuu/str/search.hpp
+ * @brief Reusable searchers over string views (single, multi, glob)
+ * @version 3.0.0
+ *
+ * Usage:
+ *   searcher s{"ERROR"};
+ *   auto pos = s.find(line);                  // npos when absent
+ *
+ *   multi_searcher<char> any;
+ *   any.add("WARN"); any.add("ERROR");
+ *   auto m = any.find(buffer);                // {pos, pattern, length}
+ *
+ *   bool ok = glob_match("access.log"_sfs, "*.log");
+ *
+ * Searchers keep views of their patterns; the pattern storage must
+ * outlive the searcher.
+ */
+
+#include "../core/core.hpp"
+#include "../core/simd.hpp"
+#include <algorithm>
+#include <string_view>
+#include <type_traits>
+
+namespace zuu::str {
+
+// ==================== Single-Pattern Searcher ====================
+
+template <meta::character CharT>
+class basic_searcher {
+public:
+    using view_type = std::basic_string_view<CharT>;
+
+    static constexpr std::size_t npos = simd::npos;
+
+private:
+    view_type needle_;
+
+public:
+    constexpr basic_searcher() noexcept = default;
+    constexpr explicit basic_searcher(view_type needle) noexcept : needle_{needle} {}
+    constexpr explicit basic_searcher(const CharT* needle) noexcept : needle_{needle} {}
+
+    [[nodiscard]] constexpr view_type needle() const noexcept { return needle_; }
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return needle_.size(); }
+
+    [[nodiscard]] constexpr std::size_t find(view_type hay, std::size_t pos = 0) const noexcept {
+        if (pos > hay.size()) return npos;
+        const auto at = simd::find(hay.data() + pos, hay.size() - pos, needle_.data(), needle_.size());
+        return at == npos ? npos : pos + at;
+    }
+
+    [[nodiscard]] constexpr bool contains(view_type hay) const noexcept {
+        return find(hay) != npos;
+    }
+
+    [[nodiscard]] constexpr std::size_t count(view_type hay) const noexcept {
+        return simd::count(hay.data(), hay.size(), needle_.data(), needle_.size());
+    }
+};
+
+using searcher = basic_searcher<char>;
+using wsearcher = basic_searcher<wchar_t>;
+
+// ==================== Multi-Pattern Searcher ====================
+
+/**
+ * @brief Leftmost match among up to MaxPatterns literals
+ *
+ * Candidate positions come from a vectorized scan for the set of
+ * distinct first characters; each candidate is verified only against
+ * patterns sharing that first character. Ties at the same position go
+ * to the pattern added first.
+ */
+template <meta::character CharT, std::size_t MaxPatterns = 16>
+class multi_searcher {
+public:
+    using view_type = std::basic_string_view<CharT>;
+
+    static constexpr std::size_t npos = simd::npos;
+    static constexpr std::size_t max_patterns = MaxPatterns;
+
+    struct match {
+        std::size_t pos = npos;
+        std::size_t pattern = npos;
+        std::size_t length = 0;
+
+        [[nodiscard]] constexpr explicit operator bool() const noexcept { return pos != npos; }
+    };
+
+private:
+    view_type patterns_[MaxPatterns]{};
+    CharT firsts_[MaxPatterns]{};
+    std::size_t count_ = 0;
+    std::size_t first_count_ = 0;
+    bool has_empty_ = false;
+
+public:
+    constexpr multi_searcher() noexcept = default;
+
+    // Returns false when the searcher is full
+    constexpr bool add(view_type pattern) noexcept {
+        if (count_ == MaxPatterns) return false;
+        patterns_[count_++] = pattern;
+
+        if (pattern.empty()) {
+            has_empty_ = true;
+        } else if (simd::find_char(firsts_, first_count_, pattern[0]) == npos) {
+            firsts_[first_count_++] = pattern[0];
+        }
+        return true;
+    }
+
+    constexpr bool add(const CharT* pattern) noexcept {
+        return add(view_type{pattern});
+    }
+
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return count_; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return count_ == 0; }
+    [[nodiscard]] constexpr view_type operator[](std::size_t idx) const noexcept { return patterns_[idx]; }
+
+    [[nodiscard]] constexpr match find(view_type hay, std::size_t pos = 0) const noexcept {
+        if (count_ == 0 || pos > hay.size()) return {};
+        if (has_empty_) {
+            // The empty pattern matches at pos; a lower-index pattern matching there wins the tie
+            const auto rest = hay.substr(pos);
+            for (std::size_t p = 0; p < count_; ++p) {
+                const auto pat = patterns_[p];
+                if (pat.size() <= rest.size() && simd::equal(rest.data(), pat.data(), pat.size())) {
+                    return {pos, p, pat.size()};
+                }
+            }
+        }
+
+        while (pos < hay.size()) {
+            const auto at = simd::find_first_of(hay.data() + pos, hay.size() - pos, firsts_, first_count_);
+            if (at == npos) break;
+            pos += at;
+
+            const auto rest = hay.substr(pos);
+            for (std::size_t p = 0; p < count_; ++p) {
+                const auto pat = patterns_[p];
+                if (!pat.empty() && pat[0] == rest[0] && pat.size() <= rest.size() &&
+                    simd::equal(rest.data(), pat.data(), pat.size())) {
+                    return {pos, p, pat.size()};
+                }
+            }
+            ++pos;
+        }
+        return {};
+    }
+
+    [[nodiscard]] constexpr bool contains(view_type hay) const noexcept {
+        return static_cast<bool>(find(hay));
+    }
+};
+
+// ==================== Glob Matching ====================
+
+namespace detail {
+
+// Matches one [...] class at pattern[pi] (just past '['); advances pi past ']'
+template <meta::character CharT>
+constexpr bool glob_class(std::basic_string_view<CharT> pattern, std::size_t& pi, CharT ch) noexcept {
+    bool negate = false;
+    if (pi < pattern.size() && (pattern[pi] == CharT('!') || pattern[pi] == CharT('^'))) {
+        negate = true;
+        ++pi;
+    }
+
+    bool matched = false;
+    bool first = true;
+    while (pi < pattern.size() && (first || pattern[pi] != CharT(']'))) {
+        first = false;
+        CharT lo = pattern[pi++];
+        if (lo == CharT('\\') && pi < pattern.size()) lo = pattern[pi++];
+
+        CharT hi = lo;
+        if (pi + 1 < pattern.size() && pattern[pi] == CharT('-') && pattern[pi + 1] != CharT(']')) {
+            hi = pattern[pi + 1];
+            pi += 2;
+        }
+        if (lo <= ch && ch <= hi) matched = true;
+    }
+    if (pi < pattern.size()) ++pi; // skip ']'
+
+    return matched != negate;
+}
+
+// Index just past the [...] class starting at pattern[pi] (just past '['); parses like glob_class
+template <meta::character CharT>
+constexpr std::size_t glob_class_end(std::basic_string_view<CharT> pattern, std::size_t pi) noexcept {
+    if (pi < pattern.size() && (pattern[pi] == CharT('!') || pattern[pi] == CharT('^'))) ++pi;
+
+    bool first = true;
+    while (pi < pattern.size() && (first || pattern[pi] != CharT(']'))) {
+        first = false;
+        if (pattern[pi++] == CharT('\\') && pi < pattern.size()) ++pi;
+        if (pi + 1 < pattern.size() && pattern[pi] == CharT('-') && pattern[pi + 1] != CharT(']')) pi += 2;
+    }
+    return pi < pattern.size() ? pi + 1 : pi;
+}
+
+} // namespace detail
+
+/**
+ * @brief Shell-style wildcard match over the whole text
+ *
+ * Supports `*`, `?`, `[abc]`, `[a-z]`, `[!x]` and `\` escapes.
+ * Backtracks only to the most recent `*`, so runtime stays linear
+ * in practice.
+ */
+struct glob_match_fn {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr bool operator()(
+        std::basic_string_view<CharT> text,
+        std::type_identity_t<std::basic_string_view<CharT>> pattern
+    ) const noexcept {
+        std::size_t ti = 0, pi = 0;
+        std::size_t star_pi = simd::npos, star_ti = 0;
+
+        while (ti < text.size()) {
+            if (pi < pattern.size()) {
+                const CharT pc = pattern[pi];
+                if (pc == CharT('*')) {
+                    star_pi = ++pi;
+                    star_ti = ti;
+                    continue;
+                }
+                if (pc == CharT('?')) {
+                    ++pi; ++ti;
+                    continue;
+                }
+                if (pc == CharT('[')) {
+                    std::size_t next = pi + 1;
+                    if (detail::glob_class(pattern, next, text[ti])) {
+                        pi = next; ++ti;
+                        continue;
+                    }
+                } else {
+                    std::size_t next = pi;
+                    CharT lit = pc;
+                    if (pc == CharT('\\') && pi + 1 < pattern.size()) lit = pattern[++next];
+                    if (lit == text[ti]) {
+                        pi = next + 1; ++ti;
+                        continue;
+                    }
+                }
+            }
+            if (star_pi == simd::npos) return false;
+            pi = star_pi;
+            ti = ++star_ti;
+        }
+
+        while (pi < pattern.size() && pattern[pi] == CharT('*')) ++pi;
+        return pi == pattern.size();
+    }
+
+    template <meta::character CharT, std::size_t Cap>
+    [[nodiscard]] constexpr bool operator()(
+        const basic_fstring<CharT, Cap>& text,
+        const CharT* pattern
+    ) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text}, std::basic_string_view<CharT>{pattern});
+    }
+
+    template <meta::character CharT, std::size_t Cap1, std::size_t Cap2>
+    [[nodiscard]] constexpr bool operator()(
+        const basic_fstring<CharT, Cap1>& text,
+        const basic_fstring<CharT, Cap2>& pattern
+    ) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{text}, std::basic_string_view<CharT>{pattern});
+    }
+
+    // Other contiguous ranges (std::string, fstring_ref, ...)
+    template <meta::char_range R>
+    [[nodiscard]] constexpr bool operator()(
+        const R& text,
+        std::type_identity_t<std::basic_string_view<meta::range_char_t<R>>> pattern
+    ) const noexcept {
+        return (*this)(meta::as_view(text), pattern);
+    }
+
+    // Factory for piping: name | glob_match("*.log")
+    template <meta::character CharT>
+    [[nodiscard]] constexpr auto operator()(const CharT* pattern) const noexcept {
+        return [pattern, this](const auto& str) {
+            return (*this)(str, pattern);
+        };
+    }
+};
+
+inline constexpr glob_match_fn glob_match;
+
+/**
+ * @brief Longest run of plain pattern characters every glob match contains
+ *
+ * Runs stop at `*`, `?`, escapes and whole `[...]` classes, so the result
+ * is a sound prefilter: a text without it cannot match. Empty when the
+ * pattern has no plain characters.
+ */
+struct glob_required_literal_fn {
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> operator()(
+        std::basic_string_view<CharT> pattern
+    ) const noexcept {
+        std::basic_string_view<CharT> best;
+        std::size_t start = 0;
+        std::size_t i = 0;
+        const auto close = [&](std::size_t end) {
+            if (end - start > best.size()) best = pattern.substr(start, end - start);
+        };
+
+        while (i < pattern.size()) {
+            const CharT pc = pattern[i];
+            if (pc == CharT('*') || pc == CharT('?') || pc == CharT('[') || pc == CharT('\\')) {
+                close(i);
+                if (pc == CharT('[')) i = detail::glob_class_end(pattern, i + 1);
+                else i = std::min(i + (pc == CharT('\\') ? 2 : 1), pattern.size());
+                start = i;
+            } else {
+                ++i;
+            }
+        }
+        close(pattern.size());
+        return best;
+    }
+
+    template <meta::character CharT>
+    [[nodiscard]] constexpr std::basic_string_view<CharT> operator()(const CharT* pattern) const noexcept {
+        return (*this)(std::basic_string_view<CharT>{pattern});
+    }
+};
+
+inline constexpr glob_required_literal_fn glob_required_literal;
+
+} // namespace zuu::str
@@ -9,11 +9,25 @@
  *   auto parts = split("a,b,c"_fs, ',');
  *   auto parts = "a,b,c"_fs | split(',');
  *   auto joined = join(parts, ", ");
+ *   auto exact  = join_as<64>(names, ", ");     // any range, chosen capacity
+ *   join(names, ", ", into(buffer));            // write into an existing string
+ *
+ *   // Zero-copy: parts are views into `line`, which must outlive them
+ *   auto fields = split_view(line, ';');
+ *   auto [key, value, found] = partition_view(header, ": ");
+ *
+ * Inputs may be any contiguous character range. Copying variants return
+ * parts with the capacity of an fstring input, or 256 for other ranges.
  */
 
 #include "../core/core.hpp"
+#include "find.hpp"
 #include "pipe.hpp"
+#include <algorithm>
 #include <array>
+#include <concepts>
+#include <ranges>
+#include <string_view>
 
 namespace zuu::str {
 
@@ -47,36 +61,110 @@ struct split_result {
     }
 };
 
+/**
+ * @brief Split results as views into the source string
+ * 
+ * Same interface as split_result; the source must outlive it.
+ */
+template <meta::character CharT, std::size_t MaxParts = 16>
+struct split_view_result {
+    std::basic_string_view<CharT> parts[MaxParts];
+    std::size_t count = 0;
+    
+    [[nodiscard]] constexpr auto begin() const noexcept { return parts; }
+    [[nodiscard]] constexpr auto end() const noexcept { return parts + count; }
+    
+    [[nodiscard]] constexpr std::size_t size() const noexcept { return count; }
+    [[nodiscard]] constexpr bool empty() const noexcept { return count == 0; }
+    
+    [[nodiscard]] constexpr std::basic_string_view<CharT> operator[](std::size_t idx) const noexcept {
+        return parts[idx];
+    }
+};
+
+namespace detail {
+
+// Parts keep an fstring input's capacity; other ranges get 256, like trim
+template <typename R>
+inline constexpr std::size_t part_capacity_v =
+    meta::capacity_of_v<R> == std::dynamic_extent ? 256 : meta::capacity_of_v<R>;
+
+/**
+ * @brief Calls emit(part) for each non-empty part between delimiters
+ * Left to right, until emit returns false. An empty delimiter yields the
+ * whole string as one part.
+ */
+template <meta::character CharT, typename Emit>
+constexpr void split_parts(
+    std::basic_string_view<CharT> str,
+    std::basic_string_view<CharT> delim,
+    Emit&& emit
+) {
+    if (delim.empty()) {
+        emit(str);
+        return;
+    }
+    std::size_t pos = 0;
+    while (pos < str.size()) {
+        const auto at = simd::find(str.data() + pos, str.size() - pos, delim.data(), delim.size());
+        const std::size_t end = at == simd::npos ? str.size() : pos + at;
+        if (end > pos && !emit(str.substr(pos, end - pos))) return;
+        pos = end + delim.size();
+    }
+}
+
+// Same parts as split_parts with a character delimiter, right to left
+template <meta::character CharT, typename Emit>
+constexpr void rsplit_parts(std::basic_string_view<CharT> str, CharT delim, Emit&& emit) {
+    std::size_t end = str.size();
+    while (end > 0) {
+        const auto at = simd::rfind_char(str.data(), end, delim);
+        const std::size_t begin = at == simd::npos ? 0 : at + 1;
+        if (end > begin && !emit(str.substr(begin, end - begin))) return;
+        if (at == simd::npos) return;
+        end = at;
+    }
+}
+
+template <meta::character CharT, std::size_t Cap, std::size_t MaxParts>
+[[nodiscard]] constexpr auto split_copy(
+    std::basic_string_view<CharT> str,
+    std::basic_string_view<CharT> delim
+) noexcept {
+    split_result<CharT, Cap, MaxParts> result;
+    split_parts(str, delim, [&](std::basic_string_view<CharT> part) {
+        result.parts[result.count++].append(part.data(), part.size());
+        return result.count < MaxParts;
+    });
+    return result;
+}
+
+template <meta::character CharT, std::size_t MaxParts>
+[[nodiscard]] constexpr auto split_borrow(
+    std::basic_string_view<CharT> str,
+    std::basic_string_view<CharT> delim
+) noexcept {
+    split_view_result<CharT, MaxParts> result;
+    split_parts(str, delim, [&](std::basic_string_view<CharT> part) {
+        result.parts[result.count++] = part;
+        return result.count < MaxParts;
+    });
+    return result;
+}
+
+} // namespace detail
+
 // ==================== Split by Character ====================
 
 struct split_char_fn {
-    template <meta::character CharT, std::size_t Cap, std::size_t MaxParts = 16>
+    template <meta::char_range R, std::size_t MaxParts = 16>
     [[nodiscard]] constexpr auto operator()(
-        const basic_fstring<CharT, Cap>& str, 
-        CharT delimiter
+        const R& str, 
+        meta::range_char_t<R> delimiter
     ) const noexcept {
-        split_result<CharT, Cap, MaxParts> result;
-        basic_fstring<CharT, Cap> current;
-        
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            if (str[i] == delimiter) {
-                if (!current.empty() && result.count < MaxParts) {
-                    result.parts[result.count++] = current;
-                    current.clear();
-                }
-            } else {
-                if (!current.full()) {
-                    current.push_back(str[i]);
-                }
-            }
-        }
-        
-        // Add last part if not empty
-        if (!current.empty() && result.count < MaxParts) {
-            result.parts[result.count++] = current;
-        }
-        
-        return result;
+        using CharT = meta::range_char_t<R>;
+        return detail::split_copy<CharT, detail::part_capacity_v<R>, MaxParts>(
+            meta::as_view(str), std::basic_string_view<CharT>{&delimiter, 1});
     }
     
     // Factory for piping: str | split(',')
@@ -93,108 +181,86 @@ inline constexpr split_char_fn split;
 // ==================== Split by String ====================
 
 struct split_str_fn {
-    template <meta::character CharT, std::size_t Cap, std::size_t DelimCap, std::size_t MaxParts = 16>
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> D, std::size_t MaxParts = 16>
     [[nodiscard]] constexpr auto operator()(
-        const basic_fstring<CharT, Cap>& str,
-        const basic_fstring<CharT, DelimCap>& delimiter
+        const R& str,
+        const D& delimiter
     ) const noexcept {
-        split_result<CharT, Cap, MaxParts> result;
-        
-        if (delimiter.empty()) {
-            if (result.count < MaxParts) {
-                result.parts[result.count++] = str;
-            }
-            return result;
-        }
-        
-        std::size_t pos = 0;
-        
-        while (pos < str.size() && result.count < MaxParts) {
-            std::size_t found = str.find(delimiter.data(), pos);
-            
-            if (found == basic_fstring<CharT, Cap>::npos) {
-                // No more delimiters, add remaining string
-                basic_fstring<CharT, Cap> part;
-                for (std::size_t i = pos; i < str.size() && !part.full(); ++i) {
-                    part.push_back(str[i]);
-                }
-                if (!part.empty()) {
-                    result.parts[result.count++] = part;
-                }
-                break;
-            }
-            
-            // Add part before delimiter
-            basic_fstring<CharT, Cap> part;
-            for (std::size_t i = pos; i < found && !part.full(); ++i) {
-                part.push_back(str[i]);
-            }
-            if (!part.empty()) {
-                result.parts[result.count++] = part;
-            }
-            
-            pos = found + delimiter.size();
-        }
-        
-        return result;
+        using CharT = meta::range_char_t<R>;
+        return detail::split_copy<CharT, detail::part_capacity_v<R>, MaxParts>(
+            meta::as_view(str), detail::needle_view<CharT>(delimiter));
     }
     
     // Factory for piping
-    template <meta::character CharT, std::size_t DelimCap>
-    [[nodiscard]] constexpr auto operator()(const basic_fstring<CharT, DelimCap>& delimiter) const noexcept {
+    template <typename D>
+    requires (!meta::character<D>)
+    [[nodiscard]] constexpr auto operator()(const D& delimiter) const noexcept {
         return [delimiter, this](const auto& str) {
             return (*this)(str, delimiter);
         };
     }
+};
+
+inline constexpr split_str_fn split_by;
+
+// ==================== Split Into Views ====================
+
+/**
+ * @brief split / split_by without copies: parts view the source
+ * Takes a character or string delimiter.
+ */
+struct split_view_fn {
+    template <meta::char_range R, std::size_t MaxParts = 16>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        meta::range_char_t<R> delimiter
+    ) const noexcept {
+        return detail::split_borrow<meta::range_char_t<R>, MaxParts>(
+            meta::as_view(str), std::basic_string_view<meta::range_char_t<R>>{&delimiter, 1});
+    }
     
-    // C-string overload
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(const CharT* delimiter) const noexcept {
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> D, std::size_t MaxParts = 16>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        const D& delimiter
+    ) const noexcept {
+        using CharT = meta::range_char_t<R>;
+        return detail::split_borrow<CharT, MaxParts>(meta::as_view(str), detail::needle_view<CharT>(delimiter));
+    }
+    
+    // Factory for piping
+    template <typename D>
+    [[nodiscard]] constexpr auto operator()(const D& delimiter) const noexcept {
         return [delimiter, this](const auto& str) {
-            basic_fstring<CharT, 64> delim(delimiter);
-            return (*this)(str, delim);
+            return (*this)(str, delimiter);
         };
     }
 };
 
-inline constexpr split_str_fn split_by;
+inline constexpr split_view_fn split_view;
 
 // ==================== Split Lines ====================
 
 struct split_lines_fn : pipe_adaptor<split_lines_fn> {
-    template <meta::character CharT, std::size_t Cap, std::size_t MaxParts = 16>
-    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& str) const noexcept {
-        split_result<CharT, Cap, MaxParts> result;
-        basic_fstring<CharT, Cap> current;
+    template <meta::char_range R, std::size_t MaxParts = 16>
+    [[nodiscard]] constexpr auto apply(const R& str) const noexcept {
+        using CharT = meta::range_char_t<R>;
+        const auto sv = meta::as_view(str);
+        split_result<CharT, detail::part_capacity_v<R>, MaxParts> result;
         
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            CharT ch = str[i];
-            
-            // Handle different line endings: \n, \r, \r\n
-            if (ch == CharT('\n')) {
-                if (!current.empty() && result.count < MaxParts) {
-                    result.parts[result.count++] = current;
-                    current.clear();
-                }
-            } else if (ch == CharT('\r')) {
-                // Check for \r\n
-                if (i + 1 < str.size() && str[i + 1] == CharT('\n')) {
-                    ++i; // Skip the \n
-                }
-                if (!current.empty() && result.count < MaxParts) {
-                    result.parts[result.count++] = current;
-                    current.clear();
-                }
-            } else {
-                if (!current.full()) {
-                    current.push_back(ch);
-                }
+        // Handle different line endings: \n, \r, \r\n
+        const CharT breaks[2] = {CharT('\n'), CharT('\r')};
+        std::size_t pos = 0;
+        while (pos < sv.size() && result.count < MaxParts) {
+            const auto at = simd::find_first_of(sv.data() + pos, sv.size() - pos, breaks, 2);
+            const std::size_t end = at == simd::npos ? sv.size() : pos + at;
+            if (end > pos) {
+                result.parts[result.count++].append(sv.data() + pos, end - pos);
+            }
+            pos = end + 1;
+            if (end < sv.size() && sv[end] == CharT('\r') && pos < sv.size() && sv[pos] == CharT('\n')) {
+                ++pos;
             }
-        }
-        
-        // Add last line if not empty
-        if (!current.empty() && result.count < MaxParts) {
-            result.parts[result.count++] = current;
         }
         
         return result;
@@ -206,10 +272,11 @@ inline constexpr split_lines_fn split_lines;
 // ==================== Split Whitespace ====================
 
 struct split_whitespace_fn : pipe_adaptor<split_whitespace_fn> {
-    template <meta::character CharT, std::size_t Cap, std::size_t MaxParts = 16>
-    [[nodiscard]] constexpr auto apply(const basic_fstring<CharT, Cap>& str) const noexcept {
-        split_result<CharT, Cap, MaxParts> result;
-        basic_fstring<CharT, Cap> current;
+    template <meta::char_range R, std::size_t MaxParts = 16>
+    [[nodiscard]] constexpr auto apply(const R& str) const noexcept {
+        using CharT = meta::range_char_t<R>;
+        const auto sv = meta::as_view(str);
+        split_result<CharT, detail::part_capacity_v<R>, MaxParts> result;
         
         auto is_space = [](CharT ch) constexpr {
             return ch == CharT(' ') || ch == CharT('\t') || 
@@ -217,22 +284,15 @@ struct split_whitespace_fn : pipe_adaptor<split_whitespace_fn> {
                    ch == CharT('\f') || ch == CharT('\v');
         };
         
-        for (std::size_t i = 0; i < str.size(); ++i) {
-            if (is_space(str[i])) {
-                if (!current.empty() && result.count < MaxParts) {
-                    result.parts[result.count++] = current;
-                    current.clear();
-                }
-            } else {
-                if (!current.full()) {
-                    current.push_back(str[i]);
-                }
-            }
-        }
-        
-        // Add last part if not empty
-        if (!current.empty() && result.count < MaxParts) {
-            result.parts[result.count++] = current;
+        std::size_t pos = 0;
+        while (result.count < MaxParts) {
+            const auto start = simd::find_first_not_space(sv.data() + pos, sv.size() - pos);
+            if (start == simd::npos) break;
+            pos += start;
+            std::size_t end = pos;
+            while (end < sv.size() && !is_space(sv[end])) ++end;
+            result.parts[result.count++].append(sv.data() + pos, end - pos);
+            pos = end;
         }
         
         return result;
@@ -243,6 +303,77 @@ inline constexpr split_whitespace_fn split_whitespace;
 
 // ==================== Join Operations ====================
 
+namespace detail {
+
+// Character type of a join delimiter: a char, C string, view or fstring
+template <typename D> struct delim_char { using type = typename D::value_type; };
+template <meta::character C> struct delim_char<C> { using type = C; };
+template <meta::character C> struct delim_char<C*> { using type = C; };
+template <meta::character C> struct delim_char<const C*> { using type = C; };
+template <meta::character C, std::size_t N> struct delim_char<C[N]> { using type = C; };
+
+template <typename D>
+using delim_char_t = typename delim_char<std::remove_cvref_t<D>>::type;
+
+template <typename D>
+[[nodiscard]] constexpr std::basic_string_view<delim_char_t<D>> delim_view(const D& d) noexcept {
+    if constexpr (meta::character<D>) {
+        return {&d, 1};
+    } else {
+        return std::basic_string_view<delim_char_t<D>>(d);
+    }
+}
+
+// Any re-iterable range whose elements view as CharT strings
+template <typename R, typename CharT>
+concept joinable_range = std::ranges::forward_range<const R> &&
+    std::convertible_to<std::ranges::range_reference_t<const R>, std::basic_string_view<CharT>>;
+
+template <meta::character CharT, typename R>
+[[nodiscard]] constexpr std::size_t join_length(
+    const R& parts, std::basic_string_view<CharT> delim
+) noexcept {
+    std::size_t total = 0;
+    std::size_t n = 0;
+    for (const auto& part : parts) {
+        total += std::basic_string_view<CharT>(part).size();
+        ++n;
+    }
+    return n == 0 ? 0 : total + (n - 1) * delim.size();
+}
+
+// One bulk append per element; the destination decides truncation
+template <meta::character CharT, typename Dest, typename R>
+constexpr void join_append(
+    Dest& dest, const R& parts, std::basic_string_view<CharT> delim
+) {
+    bool first = true;
+    for (const auto& part : parts) {
+        if (!first) dest.append(delim.data(), delim.size());
+        first = false;
+        const std::basic_string_view<CharT> sv = part;
+        dest.append(sv.data(), sv.size());
+    }
+}
+
+} // namespace detail
+
+/**
+ * @brief Output target for join: `join(parts, ", ", into(dest))`
+ *
+ * `dest` is replaced. basic_fstring destinations truncate silently at
+ * capacity; std::basic_string destinations reserve the exact length.
+ */
+template <typename Dest>
+struct into_t {
+    Dest& dest;
+};
+
+template <typename Dest>
+[[nodiscard]] constexpr into_t<Dest> into(Dest& dest) noexcept {
+    return {dest};
+}
+
 /**
  * @brief Join array of strings with delimiter
  */
@@ -255,16 +386,7 @@ struct join_fn {
     ) const noexcept {
         constexpr std::size_t result_cap = Cap * N + N;
         basic_fstring<CharT, result_cap> result;
-        
-        for (std::size_t i = 0; i < N; ++i) {
-            if (i > 0 && !result.full()) {
-                result.push_back(delimiter);
-            }
-            if (!result.full()) {
-                result.append(parts[i].data(), parts[i].size());
-            }
-        }
-        
+        detail::join_append(result, parts, detail::delim_view(delimiter));
         return result;
     }
     
@@ -276,16 +398,7 @@ struct join_fn {
     ) const noexcept {
         constexpr std::size_t result_cap = Cap * N + DelimCap * N;
         basic_fstring<CharT, result_cap> result;
-        
-        for (std::size_t i = 0; i < N; ++i) {
-            if (i > 0 && !result.full()) {
-                result.append(delimiter.data(), delimiter.size());
-            }
-            if (!result.full()) {
-                result.append(parts[i].data(), parts[i].size());
-            }
-        }
-        
+        detail::join_append(result, parts, detail::delim_view(delimiter));
         return result;
     }
     
@@ -297,16 +410,7 @@ struct join_fn {
     ) const noexcept {
         constexpr std::size_t result_cap = Cap * MaxParts + MaxParts;
         basic_fstring<CharT, result_cap> joined;
-        
-        for (std::size_t i = 0; i < result.count; ++i) {
-            if (i > 0 && !joined.full()) {
-                joined.push_back(delimiter);
-            }
-            if (!joined.full()) {
-                joined.append(result.parts[i].data(), result.parts[i].size());
-            }
-        }
-        
+        detail::join_append(joined, result, detail::delim_view(delimiter));
         return joined;
     }
     
@@ -318,16 +422,7 @@ struct join_fn {
     ) const noexcept {
         constexpr std::size_t result_cap = Cap * MaxParts + DelimCap * MaxParts;
         basic_fstring<CharT, result_cap> joined;
-        
-        for (std::size_t i = 0; i < result.count; ++i) {
-            if (i > 0 && !joined.full()) {
-                joined.append(delimiter.data(), delimiter.size());
-            }
-            if (!joined.full()) {
-                joined.append(result.parts[i].data(), result.parts[i].size());
-            }
-        }
-        
+        detail::join_append(joined, result, detail::delim_view(delimiter));
         return joined;
     }
     
@@ -340,18 +435,105 @@ struct join_fn {
         basic_fstring<CharT, 64> delim(delimiter);
         return (*this)(result, delim);
     }
+    
+    // Join any range into an existing string
+    template <typename R, typename Delim, typename Dest>
+    requires detail::joinable_range<R, detail::delim_char_t<Delim>>
+    constexpr Dest& operator()(
+        const R& parts,
+        const Delim& delimiter,
+        into_t<Dest> out
+    ) const {
+        const auto delim = detail::delim_view(delimiter);
+        out.dest.clear();
+        if constexpr (requires { out.dest.reserve(std::size_t{}); }) {
+            out.dest.reserve(detail::join_length(parts, delim));
+        }
+        detail::join_append(out.dest, parts, delim);
+        return out.dest;
+    }
 };
 
 inline constexpr join_fn join;
 
+// ==================== Exact-Size Join ====================
+
+/**
+ * @brief Joined length of any range of strings, without building it
+ *
+ * Pick a capacity for join_as, or check that a join will fit.
+ */
+struct join_length_fn {
+    template <typename R, typename Delim>
+    requires detail::joinable_range<R, detail::delim_char_t<Delim>>
+    [[nodiscard]] constexpr std::size_t operator()(
+        const R& parts,
+        const Delim& delimiter
+    ) const noexcept {
+        return detail::join_length(parts, detail::delim_view(delimiter));
+    }
+};
+
+inline constexpr join_length_fn join_length;
+
+/**
+ * @brief Join any range of string-likes into a basic_fstring<CharT, Cap>
+ *
+ * Works over vectors of views, fstrings, std::strings or split results.
+ * Output beyond Cap is truncated, as with every other fstring operation.
+ */
+template <std::size_t Cap>
+struct join_as_fn {
+    template <typename R, typename Delim>
+    requires detail::joinable_range<R, detail::delim_char_t<Delim>>
+    [[nodiscard]] constexpr auto operator()(
+        const R& parts,
+        const Delim& delimiter
+    ) const noexcept {
+        basic_fstring<detail::delim_char_t<Delim>, Cap> result;
+        detail::join_append(result, parts, detail::delim_view(delimiter));
+        return result;
+    }
+};
+
+template <std::size_t Cap>
+inline constexpr join_as_fn<Cap> join_as{};
+
 // ==================== Partition (Split into 2 parts) ====================
 
 struct partition_fn {
-    template <meta::character CharT, std::size_t Cap>
+    template <meta::char_range R>
     [[nodiscard]] constexpr auto operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT delimiter
+        const R& str,
+        meta::range_char_t<R> delimiter
+    ) const noexcept {
+        return split_at<detail::part_capacity_v<R>>(
+            meta::as_view(str), std::basic_string_view<meta::range_char_t<R>>{&delimiter, 1});
+    }
+    
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> D>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        const D& delimiter
     ) const noexcept {
+        return split_at<detail::part_capacity_v<R>>(
+            meta::as_view(str), detail::needle_view<meta::range_char_t<R>>(delimiter));
+    }
+    
+    // Factory for piping
+    template <typename D>
+    [[nodiscard]] constexpr auto operator()(const D& delimiter) const noexcept {
+        return [delimiter, this](const auto& str) {
+            return (*this)(str, delimiter);
+        };
+    }
+
+private:
+    template <std::size_t Cap, meta::character CharT>
+    static constexpr auto split_at(
+        std::basic_string_view<CharT> str,
+        std::basic_string_view<CharT> delim
+    ) noexcept {
         struct result_t {
             basic_fstring<CharT, Cap> first;
             basic_fstring<CharT, Cap> second;
@@ -359,77 +541,124 @@ struct partition_fn {
         };
         
         result_t result;
-        std::size_t pos = str.find(delimiter);
+        const std::size_t pos = detail::find_in(str, delim, 0);
         
-        if (pos != basic_fstring<CharT, Cap>::npos) {
+        if (pos != simd::npos) {
             result.found = true;
-            result.first = str.template substr<Cap>(0, pos);
-            if (pos + 1 < str.size()) {
-                result.second = str.template substr<Cap>(pos + 1);
-            }
+            result.first.append(str.data(), pos);
+            const auto rest = str.substr(pos + delim.size());
+            result.second.append(rest.data(), rest.size());
         } else {
-            result.first = str;
+            result.first.append(str.data(), str.size());
         }
         
         return result;
     }
+};
+
+inline constexpr partition_fn partition;
+
+/**
+ * @brief partition without copies: `first` and `second` view the source
+ */
+struct partition_view_fn {
+    template <meta::char_range R>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        meta::range_char_t<R> delimiter
+    ) const noexcept {
+        return split_at(meta::as_view(str), std::basic_string_view<meta::range_char_t<R>>{&delimiter, 1});
+    }
+    
+    template <meta::char_range R, detail::needle_of<meta::range_char_t<R>> D>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        const D& delimiter
+    ) const noexcept {
+        return split_at(meta::as_view(str), detail::needle_view<meta::range_char_t<R>>(delimiter));
+    }
     
     // Factory for piping
-    template <meta::character CharT>
-    [[nodiscard]] constexpr auto operator()(CharT delimiter) const noexcept {
+    template <typename D>
+    [[nodiscard]] constexpr auto operator()(const D& delimiter) const noexcept {
         return [delimiter, this](const auto& str) {
             return (*this)(str, delimiter);
         };
     }
+
+private:
+    template <meta::character CharT>
+    static constexpr auto split_at(
+        std::basic_string_view<CharT> str,
+        std::basic_string_view<CharT> delim
+    ) noexcept {
+        struct result_t {
+            std::basic_string_view<CharT> first;
+            std::basic_string_view<CharT> second;
+            bool found = false;
+        };
+        
+        const std::size_t pos = detail::find_in(str, delim, 0);
+        if (pos == simd::npos) return result_t{str, {}, false};
+        return result_t{str.substr(0, pos), str.substr(pos + delim.size()), true};
+    }
 };
 
-inline constexpr partition_fn partition;
+inline constexpr partition_view_fn partition_view;
 
 // ==================== Reverse Split (from right) ====================
 
+/**
+ * @brief Like split, but keeps the last MaxParts parts when there are more
+ * Parts are stored in source order.
+ */
 struct rsplit_fn {
-    template <meta::character CharT, std::size_t Cap, std::size_t MaxParts = 16>
+    template <meta::char_range R, std::size_t MaxParts = 16>
     [[nodiscard]] constexpr auto operator()(
-        const basic_fstring<CharT, Cap>& str,
-        CharT delimiter
+        const R& str,
+        meta::range_char_t<R> delimiter
     ) const noexcept {
-        split_result<CharT, Cap, MaxParts> result;
-        basic_fstring<CharT, Cap> current;
+        using CharT = meta::range_char_t<R>;
+        split_result<CharT, detail::part_capacity_v<R>, MaxParts> result;
         
-        // Build parts in reverse
-        for (std::size_t i = str.size(); i > 0 && result.count < MaxParts; --i) {
-            CharT ch = str[i - 1];
-            
-            if (ch == delimiter) {
-                if (!current.empty()) {
-                    // Reverse current part before storing
-                    basic_fstring<CharT, Cap> reversed;
-                    for (std::size_t j = current.size(); j > 0; --j) {
-                        reversed.push_back(current[j - 1]);
-                    }
-                    result.parts[result.count++] = reversed;
-                    current.clear();
-                }
-            } else {
-                current.push_back(ch);
-            }
-        }
+        // Collect right to left, then restore source order
+        detail::rsplit_parts(meta::as_view(str), delimiter, [&](std::basic_string_view<CharT> part) {
+            result.parts[result.count++].append(part.data(), part.size());
+            return result.count < MaxParts;
+        });
+        std::reverse(result.parts, result.parts + result.count);
         
-        // Add last part
-        if (!current.empty() && result.count < MaxParts) {
-            basic_fstring<CharT, Cap> reversed;
-            for (std::size_t j = current.size(); j > 0; --j) {
-                reversed.push_back(current[j - 1]);
-            }
-            result.parts[result.count++] = reversed;
-        }
+        return result;
+    }
+    
+    // Factory for piping
+    template <meta::character CharT>
+    [[nodiscard]] constexpr auto operator()(CharT delimiter) const noexcept {
+        return [delimiter, this](const auto& str) {
+            return (*this)(str, delimiter);
+        };
+    }
+};
+
+inline constexpr rsplit_fn rsplit;
+
+/**
+ * @brief rsplit without copies: the last MaxParts parts as views
+ */
+struct rsplit_view_fn {
+    template <meta::char_range R, std::size_t MaxParts = 16>
+    [[nodiscard]] constexpr auto operator()(
+        const R& str,
+        meta::range_char_t<R> delimiter
+    ) const noexcept {
+        using CharT = meta::range_char_t<R>;
+        split_view_result<CharT, MaxParts> result;
         
-        // Reverse the entire result array
-        for (std::size_t i = 0; i < result.count / 2; ++i) {
-            auto temp = result.parts[i];
-            result.parts[i] = result.parts[result.count - 1 - i];
-            result.parts[result.count - 1 - i] = temp;
-        }
+        detail::rsplit_parts(meta::as_view(str), delimiter, [&](std::basic_string_view<CharT> part) {
+            result.parts[result.count++] = part;
+            return result.count < MaxParts;
+        });
+        std::reverse(result.parts, result.parts + result.count);
         
         return result;
     }
@@ -443,6 +672,6 @@ struct rsplit_fn {
     }
 };
 
-inline constexpr rsplit_fn rsplit;
+inline constexpr rsplit_view_fn rsplit_view;
 
-} // namespace zuu::str
\ No newline at end of file
+} // namespace zuu::str
@@ -28,18 +28,14 @@ constexpr bool is_space(CharT ch) noexcept {
 
 template <meta::character CharT>
 constexpr std::size_t find_first_non_space(std::basic_string_view<CharT> sv) noexcept {
-    for (std::size_t i = 0; i < sv.size(); ++i) {
-        if (!is_space(sv[i])) return i;
-    }
-    return sv.size();
+    const auto at = simd::find_first_not_space(sv.data(), sv.size());
+    return at == simd::npos ? sv.size() : at;
 }
 
 template <meta::character CharT>
 constexpr std::size_t find_last_non_space(std::basic_string_view<CharT> sv) noexcept {
-    for (std::size_t i = sv.size(); i > 0; --i) {
-        if (!is_space(sv[i - 1])) return i;
-    }
-    return 0;
+    const auto at = simd::find_last_not_space(sv.data(), sv.size());
+    return at == simd::npos ? 0 : at + 1;
 }
 
 // ==================== Trim Left ====================
@@ -178,6 +174,14 @@ struct trim_if_fn {
         return result;
     }
 
+    // Other contiguous ranges (views, std::string, fstring_ref)
+    template <meta::char_range R>
+    constexpr auto operator()(const R& str) const noexcept {
+        constexpr std::size_t result_cap = 256;
+        const auto sv = meta::as_view(str);
+        return (*this)(basic_fstring<meta::range_char_t<R>, result_cap>(sv.data(), sv.size()));
+    }
+
     template <meta::string_like Str>
     friend constexpr auto operator|(Str&& str, const trim_if_fn& t) {
         return t(std::forward<Str>(str));
@@ -0,0 +1,394 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Throughput benchmarks for fstring kernels and parallel algorithms
+ * @date 2026-10-18
+ *
+ * Usage:
+ *   fstring_bench                 # run every benchmark with default sizes
+ *   fstring_bench wordcount 4096  # word count over a 4 GiB synthetic corpus
+ *   fstring_bench chartypes 64    # kernels per code unit width over 64 MiB
+ *   fstring_bench lex 256         # generated lexer over a 256 MiB corpus
+ *   fstring_bench sort 1024       # external sort of 1 GiB of fstring<64> keys
+ *   fstring_bench search 64       # search strategies, fixed and adaptive
+ *   fstring_bench digest 256      # CRC32C and SHA-256, whole buffers and batches
+ *
+ * Inputs are generated deterministically, so runs are comparable across
+ * machines and commits. Sizes are in MiB. The sort benchmark writes its
+ * runs to $TMPDIR (or the current directory), so it measures that disk.
+ */
+
+#include <zuu/fstring.hpp>
+#include <zuu/aggregate/count.hpp>
+#include <zuu/core/digest.hpp>
+#include <zuu/core/hash.hpp>
+#include <zuu/io/external_sort.hpp>
+#include <zuu/lex/lexer.hpp>
+#include <zuu/str/adaptive.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace zuu;
+
+namespace {
+
+// ==================== Harness ====================
+
+using clock_type = std::chrono::steady_clock;
+
+template <typename Fn>
+double time_seconds(Fn&& fn) {
+    const auto start = clock_type::now();
+    fn();
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+void report(std::string_view name, std::size_t bytes, double seconds, double speedup = 0) {
+    std::cout << "  " << std::left << std::setw(28) << name
+              << std::right << std::setw(8) << std::fixed << std::setprecision(3) << seconds << " s"
+              << std::setw(10) << std::setprecision(2) << (bytes / seconds / 1e9) << " GB/s";
+    if (speedup > 0) std::cout << "   x" << std::setprecision(2) << speedup;
+    std::cout << '\n';
+}
+
+// 1, 2, 4, ... up to (and including) the hardware thread count
+std::vector<std::size_t> thread_steps() {
+    std::vector<std::size_t> steps;
+    const std::size_t max_threads = par::thread_count();
+    for (std::size_t t = 1; t < max_threads; t *= 2) steps.push_back(t);
+    steps.push_back(max_threads);
+    return steps;
+}
+
+// Deterministic xorshift generator
+struct rng {
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+
+    std::uint64_t next() noexcept {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    }
+};
+
+// Text of ~`mib` MiB: words drawn from a skewed vocabulary, ~10 per line
+std::string make_corpus(std::size_t mib) {
+    std::vector<std::string> vocab;
+    rng r;
+    for (std::size_t i = 0; i < 50000; ++i) {
+        std::string w;
+        const std::size_t len = 2 + r.next() % 9;
+        for (std::size_t k = 0; k < len; ++k) w.push_back(static_cast<char>('a' + r.next() % 26));
+        vocab.push_back(std::move(w));
+    }
+
+    std::string text;
+    const std::size_t target = mib << 20;
+    text.reserve(target + 128);
+    while (text.size() < target) {
+        const std::size_t words = 1 + r.next() % 19;
+        for (std::size_t k = 0; k < words; ++k) {
+            // Squaring a uniform pick skews toward low ranks (Zipf-like)
+            const std::uint64_t u = r.next() % 50000;
+            text += vocab[(u * u) / 50000];
+            text.push_back(k + 1 == words ? '\n' : ' ');
+        }
+    }
+    return text;
+}
+
+std::vector<std::string_view> split_views(std::string_view text, char delim) {
+    std::vector<std::string_view> out;
+    std::size_t pos = 0;
+    while (pos < text.size()) {
+        std::size_t end = simd::find_char(text.data() + pos, text.size() - pos, delim);
+        end = end == simd::npos ? text.size() : pos + end;
+        out.push_back(text.substr(pos, end - pos));
+        pos = end + 1;
+    }
+    return out;
+}
+
+// ==================== Word Count ====================
+
+void bench_wordcount(std::size_t mib) {
+    std::cout << "wordcount (" << mib << " MiB corpus)\n";
+    const std::string corpus = make_corpus(mib);
+    const auto lines = split_views(corpus, '\n');
+
+    auto tokens = [](std::string_view line, auto& emit) {
+        std::size_t pos = 0;
+        while (pos < line.size()) {
+            std::size_t end = simd::find_char(line.data() + pos, line.size() - pos, ' ');
+            end = end == simd::npos ? line.size() : pos + end;
+            if (end > pos) emit(line.substr(pos, end - pos));
+            pos = end + 1;
+        }
+    };
+
+    double base = 0;
+    for (const std::size_t t : thread_steps()) {
+        std::size_t distinct = 0;
+        const double s = time_seconds([&] {
+            auto counts = aggregate::count_by<32>(lines, tokens, {.threads = t, .expected_keys = 65536});
+            distinct = counts.size() + counts.top(10, t).size();
+        });
+        if (t == 1) base = s;
+        report("threads=" + std::to_string(t), corpus.size(), s, base / s);
+        if (distinct == 0) std::cout << "  (empty result)\n";
+    }
+}
+
+// ==================== Character Types ====================
+
+// Best of three runs; kernels write to `sink` so they are not elided
+template <typename Fn>
+double best_of(Fn&& fn) {
+    double best = 1e30;
+    for (int r = 0; r < 3; ++r) best = std::min(best, time_seconds(fn));
+    return best;
+}
+
+// Each row: kernel throughput, then speedup over the standard library
+template <typename CharT>
+void bench_chartype(std::string_view type, const std::string& corpus) {
+    std::cout << type << " (" << sizeof(CharT) << "-byte code units)\n";
+    const std::basic_string<CharT> text(corpus.begin(), corpus.end());
+    const std::basic_string<CharT> copy = text;
+    const std::basic_string<CharT> spaces(text.size(), CharT(' '));
+    std::basic_string<CharT> out(text.size(), CharT{});
+    const std::basic_string<CharT> needle{CharT('q'), CharT('x'), CharT('z'), CharT('j')};
+    const std::size_t n = text.size();
+    const CharT* p = text.data();
+    volatile std::size_t sink = 0;
+
+    const auto row = [&](std::string_view op, auto&& kernel, auto&& baseline) {
+        const double s = best_of(kernel);
+        const double b = best_of(baseline);
+        report(std::string(type) + " " + std::string(op), n * sizeof(CharT), s, b / s);
+    };
+
+    row("find_char", [&] { sink = simd::find_char(p, n, CharT('#')); },
+        [&] { sink = static_cast<std::size_t>(std::find(p, p + n, CharT('#')) - p); });
+    row("count_char", [&] { sink = simd::count_char(p, n, CharT(' ')); },
+        [&] { sink = static_cast<std::size_t>(std::count(p, p + n, CharT(' '))); });
+    row("find", [&] { sink = simd::find(p, n, needle.data(), needle.size()); },
+        [&] { sink = std::basic_string_view<CharT>(p, n).find(needle); });
+    row("compare", [&] { sink = static_cast<std::size_t>(simd::compare(p, n, copy.data(), n) + 1); },
+        [&] { sink = std::lexicographical_compare(p, p + n, copy.data(), copy.data() + n); });
+    row("to_upper", [&] { simd::to_upper(p, out.data(), n); sink = out[n / 2]; },
+        [&] {
+            std::transform(p, p + n, out.data(), [](CharT ch) {
+                return (ch >= CharT('a') && ch <= CharT('z')) ? static_cast<CharT>(ch - 0x20) : ch;
+            });
+            sink = out[n / 2];
+        });
+    row("trim", [&] { sink = simd::find_first_not_space(spaces.data(), n); },
+        [&] {
+            sink = static_cast<std::size_t>(std::find_if(spaces.begin(), spaces.end(), [](CharT ch) {
+                return !(ch == CharT(' ') || (ch >= CharT('\t') && ch <= CharT('\r')));
+            }) - spaces.begin());
+        });
+    row("hash", [&] { sink = hash_chars(p, n); },
+        [&] { sink = std::hash<std::basic_string_view<CharT>>{}({p, n}); });
+}
+
+void bench_chartypes(std::size_t mib) {
+    // Same byte volume per type, so the GB/s columns compare directly
+    const std::string corpus = make_corpus(mib);
+    bench_chartype<char>("char", corpus);
+    bench_chartype<char16_t>("char16_t", corpus.substr(0, corpus.size() / 2));
+    bench_chartype<char32_t>("char32_t", corpus.substr(0, corpus.size() / 4));
+    bench_chartype<wchar_t>("wchar_t", corpus.substr(0, corpus.size() / sizeof(wchar_t)));
+}
+
+// ==================== Lexer ====================
+
+enum class tok { keyword, ident, number, string, punct };
+
+constexpr auto bench_lexer = lex::make_lexer(
+    lex::literal(tok::keyword, "where"),
+    lex::run(tok::ident, lex::alpha | "_", lex::alnum | "_"),
+    lex::number(tok::number),
+    lex::quoted(tok::string),
+    lex::run(tok::punct, "=<>,;()"));
+
+void bench_lex(std::size_t mib) {
+    std::cout << "lex (" << mib << " MiB corpus)\n";
+    std::string corpus = make_corpus(mib);
+    // Sprinkle numbers, strings and punctuation among the words
+    // (same-length overwrites, so the corpus never shifts)
+    const auto sprinkle = [&](std::size_t first, std::size_t step, std::string_view text) {
+        for (std::size_t i = first; i + text.size() < corpus.size(); i += step) corpus.replace(i, text.size(), text);
+    };
+    sprinkle(64, 997, " 1024.5,");
+    sprinkle(500, 4093, " \"quoted string body\" ");
+
+    std::size_t tokens = 0;
+    const double s = time_seconds([&] {
+        for (auto t : bench_lexer.tokenize(std::string_view{corpus})) tokens += t.kind != lex::error;
+    });
+    report("tokenize", corpus.size(), s);
+    std::cout << "  " << tokens << " tokens, " << bench_lexer.state_count() << " DFA states\n";
+}
+
+// ==================== External Sort ====================
+
+// Keys of 8..63 characters; the budget holds an eighth of them
+void bench_sort(std::size_t mib) {
+    using key = fstring<64>;
+    const std::size_t n = (mib << 20) / sizeof(key);
+    const std::size_t bytes = n * sizeof(key);
+    std::cout << "external sort (" << n << " x fstring<64>, " << mib << " MiB)\n";
+
+    rng r;
+    std::vector<key> keys(n);
+    for (key& k : keys) {
+        const std::size_t len = 8 + r.next() % 56;
+        for (std::size_t i = 0; i < len; ++i) k.push_back(static_cast<char>('a' + r.next() % 26));
+    }
+
+    const char* tmp = std::getenv("TMPDIR");
+    for (const bool unique : {false, true}) {
+        io::external_sorter<key> sorter({.memory_budget = std::max<std::size_t>(bytes / 8, 1u << 20),
+                                         .temp_dir = tmp ? tmp : ".", .unique = unique});
+        std::size_t out = 0;
+        std::size_t runs = 0;
+        bool ok = true;
+        const double s = time_seconds([&] {
+            ok = sorter.push_all(keys);
+            runs = sorter.runs();
+            ok = ok && sorter.finish([&](const key& k) { out += k.size(); });
+        });
+        report(unique ? "budget=1/8 unique" : "budget=1/8", bytes, s);
+        std::cout << "  " << runs << " runs spilled while pushing" << (ok ? "" : ", I/O error") << '\n';
+    }
+
+    std::vector<key> copy = keys;
+    const double s = time_seconds([&] { std::sort(copy.begin(), copy.end()); });
+    report("in-memory std::sort", bytes, s);
+}
+
+// ==================== Adaptive Search ====================
+
+// Counts `needle` in 4 KiB calls with each fixed strategy, then adaptively
+void bench_search_case(std::string_view name, std::string_view hay, std::string_view needle) {
+    std::cout << "  " << name << " (m=" << needle.size() << ")\n";
+    std::size_t found = 0;
+    const auto scan = [&](str::adaptive_searcher<char>& s) {
+        for (std::size_t pos = 0; pos < hay.size(); pos += 4096) found += s.count(hay.substr(pos, 4096));
+    };
+    for (const auto st : {str::search_strategy::filter, str::search_strategy::rare_char, str::search_strategy::two_way}) {
+        str::adaptive_searcher<char> s{needle, {.adapt = false}};
+        s.use(st);
+        report(str::strategy_name(st), hay.size(), time_seconds([&] { scan(s); }));
+    }
+    str::adaptive_searcher<char> s{needle};
+    report("adaptive", hay.size(), time_seconds([&] { scan(s); }));
+    std::cout << "  settled on " << str::strategy_name(s.strategy()) << " after "
+              << s.stats().switches << " switch(es), " << found / 4 << " matches\n";
+}
+
+void bench_multi_case(std::string_view name, std::string_view hay, std::initializer_list<std::string_view> patterns) {
+    std::cout << "  " << name << " (" << patterns.size() << " patterns)\n";
+    std::size_t found = 0;
+    const auto scan = [&](str::adaptive_multi_searcher<char>& s) {
+        for (std::size_t pos = 0; pos < hay.size(); pos += 4096) {
+            const std::string_view chunk = hay.substr(pos, 4096);
+            for (auto m = s.find(chunk); m; m = s.find(chunk, m.pos + m.length)) ++found;
+        }
+    };
+    for (const auto st : {str::search_strategy::first_char_scan, str::search_strategy::aho_corasick}) {
+        str::adaptive_multi_searcher<char> s({.adapt = false});
+        for (const auto p : patterns) s.add(p);
+        s.use(st);
+        report(str::strategy_name(st), hay.size(), time_seconds([&] { scan(s); }));
+    }
+    str::adaptive_multi_searcher<char> s;
+    for (const auto p : patterns) s.add(p);
+    report("adaptive", hay.size(), time_seconds([&] { scan(s); }));
+    std::cout << "  settled on " << str::strategy_name(s.strategy()) << ", " << found / 3 << " matches\n";
+}
+
+void bench_search(std::size_t mib) {
+    std::cout << "adaptive search (" << mib << " MiB inputs, 4 KiB calls)\n";
+    const std::string text = make_corpus(mib);
+
+    rng r;
+    std::string dna(mib << 20, 'A');
+    for (char& c : dna) c = "ACGT"[r.next() % 4];
+    std::string runs;
+    while (runs.size() < (mib << 20)) runs += std::string(63, 'a') + 'b';
+    const std::string flat(mib << 20, 'a');
+
+    bench_search_case("text, absent word", text, "zqxjzq");
+    bench_search_case("text, spaces around a rare char", text, " eQee ");
+    bench_search_case("dna", dna, "ACGTTGCAACGTTGCA");
+    bench_search_case("flat, rare middle char", flat, std::string(16, 'a') + 'b' + std::string(16, 'a'));
+    bench_search_case("runs, long partial matches", runs, std::string(64, 'a'));
+
+    bench_multi_case("text, rare first chars", text, {"WARN", "ERROR"});
+    bench_multi_case("text, dense first chars", text, {"tqz", "aqz", "oqz", "iqz", "eqz"});
+}
+
+// ==================== Digests ====================
+
+// One large buffer, then many short keys one at a time and as a batch
+void bench_digest(std::size_t mib) {
+    std::cout << "digests (" << mib << " MiB buffer)\n";
+    rng r;
+    std::string buf(mib << 20, '\0');
+    for (char& c : buf) c = static_cast<char>(r.next());
+
+    std::uint64_t sink = 0;
+    report("crc32c, slicing-by-8", buf.size(), time_seconds([&] {
+        sink += detail::crc32c_update_sw(~0u, reinterpret_cast<const unsigned char*>(buf.data()), buf.size());
+    }));
+    report("crc32c", buf.size(), time_seconds([&] { sink += crc32c(buf); }));
+    report("sha256", buf.size(), time_seconds([&] { sink += sha256(buf)[0]; }));
+
+    std::vector<fstring<64>> keys((mib << 20) / 64);
+    std::size_t bytes = 0;
+    for (auto& k : keys) {
+        const std::size_t len = 16 + r.next() % 48;
+        for (std::size_t i = 0; i < len; ++i) k.push_back(static_cast<char>('a' + r.next() % 26));
+        bytes += len;
+    }
+    std::vector<std::uint32_t> crcs(keys.size());
+    std::vector<sha256_digest> digests(keys.size());
+    std::cout << "  " << keys.size() << " keys of 16..63 characters\n";
+    report("crc32c, one at a time", bytes, time_seconds([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i) crcs[i] = crc32c(keys[i]);
+    }));
+    report("crc32c_batch", bytes, time_seconds([&] { crc32c_batch(keys, std::span{crcs}); }));
+    report("sha256, one at a time", bytes, time_seconds([&] {
+        for (std::size_t i = 0; i < keys.size(); ++i) digests[i] = sha256(keys[i]);
+    }));
+    report("sha256_batch", bytes, time_seconds([&] { sha256_batch(keys, std::span{digests}); }));
+    std::cout << "  checksum " << hex_digest(static_cast<std::uint32_t>(sink ^ crcs.back() ^ digests.back()[0])) << '\n';
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const std::string_view which = argc > 1 ? argv[1] : "all";
+    const auto size_arg = [&](std::size_t fallback) {
+        return argc > 2 ? static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10)) : fallback;
+    };
+
+    if (which == "all" || which == "wordcount") bench_wordcount(size_arg(256));
+    if (which == "all" || which == "chartypes") bench_chartypes(size_arg(64));
+    if (which == "all" || which == "lex") bench_lex(size_arg(256));
+    if (which == "all" || which == "sort") bench_sort(size_arg(1024));
+    if (which == "all" || which == "search") bench_search(size_arg(64));
+    if (which == "all" || which == "digest") bench_digest(size_arg(256));
+    return 0;
+}
@@ -6,6 +6,33 @@
  */
 
 #include <zuu/fstring.hpp>
+#include <zuu/aggregate/count.hpp>
+#include <zuu/aggregate/sketch.hpp>
+#include <zuu/aggregate/hyperloglog.hpp>
+#include <zuu/aggregate/features.hpp>
+#include <zuu/aggregate/similarity.hpp>
+#include <zuu/aggregate/partition.hpp>
+#include <zuu/core/digest.hpp>
+#include <zuu/core/lit_pool.hpp>
+#include <zuu/lex/lexer.hpp>
+#include <zuu/lex/subword.hpp>
+#include <zuu/io/http.hpp>
+#include <zuu/io/line_index.hpp>
+#include <zuu/io/external_sort.hpp>
+#include <zuu/io/metrics.hpp>
+#include <zuu/str/adaptive.hpp>
+#include <zuu/str/parallel_search.hpp>
+#if defined(__unix__) || defined(__APPLE__)
+#include <zuu/io/frame.hpp>
+#include <sys/socket.h>
+#endif
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
 #include <iostream>
 #include <cassert>
 
@@ -18,6 +45,18 @@ using namespace zuu::literals;
 int tests_passed = 0;
 int tests_failed = 0;
 
+// Heap allocations so far, for checking allocation-free steady states
+std::atomic<std::size_t> allocations{0};
+
+void* operator new(std::size_t n) {
+    ++allocations;
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc{};
+}
+// Out of line: inlined into a delete expression, GCC takes free() for a mismatch
+[[gnu::noinline]] void operator delete(void* p) noexcept { std::free(p); }
+[[gnu::noinline]] void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
 #define TEST(name) \
     void test_##name(); \
     void run_test_##name() { \
@@ -65,6 +104,45 @@ TEST(element_access) {
     assert(s.at(1) == 'e');
 }
 
+TEST(fstring_ref_external_buffers) {
+    // A raw slot with its length beside it: truncates, writes no terminator
+    char slot[8] = {'x', 'x', 'x', 'x', 'x', 'x', 'x', 'x'};
+    std::size_t len = 0;
+    fstring_ref name(slot, len);
+    name.append("user-", 5);
+    name += to_fstring(42);
+    assert(len == 7 && name == "user-42" && slot[7] == 'x');
+    name += "xyz";
+    assert(len == 8 && name.full() && name == "user-42x");
+
+    // A ref to an fstring edits it in place and keeps it terminated
+    fstring<32> owned("  Hello  ");
+    fstring_ref<char> ref = owned;
+    ref.pop_back();
+    assert(owned.size() == 8 && owned.c_str()[8] == '\0' && ref.capacity() == 32);
+
+    // Algorithms and pipes accept refs
+    assert((ref | trim) == "Hello" && (ref | trim | to_upper) == "HELLO");
+    assert(ref.find('H') == 2 && glob_match(ref, "*ell*") && equals_ignore_case(ref, "  hello "));
+    auto words = split_view(ref, 'l');
+    assert(words.count == 2 && words.parts[1] == "o ");
+    auto head = ref | take_while([](char c) { return c == ' '; });
+    static_assert(std::is_same_v<decltype(head), std::optional<std::string_view>>);
+    assert(head->size() == 2 && head->data() == owned.data());
+
+    char path_buf[16] = "a/./b/../c";
+    std::size_t path_len = 10;
+    fstring_ref path_ref(path_buf, path_len);
+    path::normalize_in_place(path_ref);
+    assert(path_ref == "a/c" && path_len == 3);
+    path::append(path_ref, "d");
+    assert(path_ref == "a/c/d");
+
+    char num[4] = {'-', '1', '2', '3'};
+    std::size_t num_len = 4;
+    assert(parse_int<int>(fstring_ref(num, num_len)) == -123);
+}
+
 // ==================== Trim Tests ====================
 
 TEST(trim_operations) {
@@ -161,10 +239,35 @@ TEST(rsplit) {
     assert(parts[3] == "d");
 }
 
+TEST(split_views) {
+    std::string line = "GET;/index.html;;HTTP/1.1";
+    auto fields = split_view(line, ';');
+    assert(fields.size() == 3);
+    assert(fields[1] == "/index.html");
+    assert(fields[1].data() == line.data() + 4);   // a view, not a copy
+
+    auto [key, value, found] = partition_view(std::string_view{"Host: example.com"}, ": ");
+    assert(found && key == "Host" && value == "example.com");
+    assert(!partition_view(line, '#').found);
+    assert(partition(line, ";;").second == "HTTP/1.1");
+
+    auto last = rsplit_view(std::string_view{"a.b.c.d"}, '.');
+    assert(last.size() == 4 && last[0] == "a" && last[3] == "d");
+
+    assert(subview(line, 4, 11) == "/index.html");
+    assert(subview(line, 99).empty());
+    assert((line | subview(17)) == "HTTP/1.1");
+
+    std::array<char, 7> raw{'a', ':', ':', 'b', ':', ':', 'c'};
+    auto parts = split_by(raw, "::");
+    assert(parts.size() == 3 && parts[2] == "c");
+    assert(join_as<32>(split_view(raw, "::"), '-') == "a-b-c");
+}
+
 // ==================== Join Tests ====================
 
 TEST(join_char) {
-    fstring<16> arr[] = {"a"_sfs, "b"_sfs, "c"_sfs};
+    fstring<32> arr[] = {"a"_sfs, "b"_sfs, "c"_sfs};
     auto result = join(arr, ',');
     assert(result == "a,b,c");
 }
@@ -182,6 +285,26 @@ TEST(join_split_roundtrip) {
     assert(original == rejoined);
 }
 
+TEST(join_ranges) {
+    std::vector<std::string_view> names{"ann", "bob", "cy"};
+    assert(join_length(names, ", ") == 12);
+    
+    auto joined = join_as<16>(names, ", ");
+    static_assert(decltype(joined)::capacity == 16);
+    assert(joined == "ann, bob, cy");
+    assert(join_as<6>(names, '/') == "ann/bo");   // truncated at capacity
+    
+    std::vector<fstring<8>> tags{fstring<8>{"a"}, fstring<8>{"bb"}};
+    std::string out = "stale";
+    join(tags, "::", into(out));
+    assert(out == "a::bb");
+    
+    fstring<32> buf;
+    join(split("x y z"_sfs, ' '), '+', into(buf));
+    assert(buf == "x+y+z");
+    assert(join_as<8>(std::vector<std::string_view>{}, ',').empty());
+}
+
 // ==================== Find Tests ====================
 
 TEST(contains_operations) {
@@ -248,6 +371,692 @@ TEST(contains_any) {
     assert(!contains_any(s, "xyz"));
 }
 
+TEST(any_contiguous_range) {
+    std::string s = "hello world";
+    std::string_view sv = s;
+    std::vector<char> v(s.begin(), s.end());
+
+    assert(contains(s, 'w') && contains(sv, "wor") && contains(v, std::string_view{"lo w"}));
+    assert(starts_with(v, "hello") && ends_with(sv, 'd') && !ends_with(s, "hello"));
+    assert(find(s, "o", 5) == 7 && rfind(sv, 'o') == 7);
+    assert(count(v, 'l') == 3 && count(s, std::string{"o"}) == 2);
+    assert(find_first_not_of(sv, "hel") == 4);
+    assert(sv | contains("world"));
+    assert(contains(std::u16string_view{u"a,b"}, u','));
+
+    // Copies from non-fstring ranges get a 256 capacity
+    auto words = split(sv, ' ');
+    static_assert(std::remove_cvref_t<decltype(words[0])>::capacity == 256);
+    assert(words.size() == 2 && words[1] == "world");
+    assert((v | split_whitespace).size() == 2);
+}
+
+TEST(parallel_search) {
+    // Small chunks so matches straddle task boundaries
+    std::string text;
+    for (int i = 0; i < 2000; ++i) text += (i % 7 == 0) ? "abab" : "xab";
+    const parallel_search_options opt{.threads = 4, .min_chunk = 64};
+
+    assert(parallel_find(text, "bx", opt) == text.find("bx"));
+    assert(parallel_find(text, "abx", opt) == text.find("abx"));
+    assert(parallel_find(text, "zz", opt) == text.npos);
+    assert(parallel_count(text, 'a', opt) == count(text, 'a'));
+    assert(parallel_count(text, "abab", opt) == count(text, "abab"));
+
+    auto hits = parallel_find_all(text, "bab", opt);
+    assert(hits.size() == count(text, "bab"));
+    for (std::size_t i = 0; i < hits.size(); ++i) {
+        assert(text.compare(hits[i], 3, "bab") == 0);
+        assert(i == 0 || hits[i] >= hits[i - 1] + 3);
+    }
+}
+
+// ==================== Searcher Tests ====================
+
+TEST(searcher) {
+    searcher s{"needle"};
+    std::string_view hay = "hay hay needle hay needle";
+    assert(s.find(hay) == 8);
+    assert(s.find(hay, 9) == 19);
+    assert(s.find(hay, 20) == searcher::npos);
+    assert(s.count(hay) == 2);
+    
+    // Long haystack exercises the vectorized path
+    fstring<128> big(100, 'x');
+    big += "needle";
+    assert(s.find(big) == 100);
+    assert(zuu::simd::count_char(big.data(), big.size(), 'x') == 100);
+}
+
+TEST(multi_searcher) {
+    multi_searcher<char> any;
+    any.add("WARN");
+    any.add("ERROR");
+    any.add("ERR");
+    
+    auto m = any.find("ok ok ERROR: WARN");
+    assert(m);
+    assert(m.pos == 6 && m.pattern == 1 && m.length == 5);
+    assert(!any.contains("all fine"));
+
+    // An empty pattern matches at the start position, but ties go to the lowest index
+    multi_searcher<char> with_empty;
+    with_empty.add("ab");
+    with_empty.add("");
+    with_empty.add("a");
+    auto e = with_empty.find("abc");
+    assert(e.pos == 0 && e.pattern == 0 && e.length == 2);
+    e = with_empty.find("xab");
+    assert(e.pos == 0 && e.pattern == 1 && e.length == 0);
+    e = with_empty.find("xab", 1);
+    assert(e.pos == 1 && e.pattern == 0 && e.length == 2);
+    assert(with_empty.find("a", 1).pattern == 1);
+}
+
+TEST(adaptive_search) {
+    // Every strategy finds the same leftmost and non-overlapping matches
+    std::string hay;
+    std::uint32_t x = 12345;
+    for (int i = 0; i < 400; ++i) hay.push_back((x = x * 1103515245 + 12345) >> 16 & 1 ? 'a' : 'b');
+    for (const std::string_view nd : {"ab", "aab", "abaab", "bbbaaab", "aaaaaaaa"}) {
+        const std::size_t expect = hay.find(nd);
+        for (auto st : {search_strategy::filter, search_strategy::rare_char, search_strategy::two_way}) {
+            adaptive_searcher<char> s{nd, {.adapt = false}};
+            s.use(st);
+            assert(s.find(hay) == (expect == std::string::npos ? s.npos : expect));
+            assert(s.count(hay) == str::count(std::string_view{hay}, nd));
+        }
+    }
+
+    // Runs of 'a' broken by a 'b': the filter stops everywhere and verifies
+    // far, and no needle character is rare, so Two-Way takes over
+    std::string runs;
+    while (runs.size() < (1u << 18)) runs += std::string(63, 'a') + 'b';
+    std::vector<search_decision> seen;
+    const auto record = [](const search_decision& d, void* ctx) {
+        static_cast<std::vector<search_decision>*>(ctx)->push_back(d);
+    };
+    const std::string long_run(64, 'a');
+    adaptive_searcher<char> s{long_run, {.window = 8, .on_decision = record, .context = &seen}};
+    for (std::size_t pos = 0; pos < runs.size(); pos += 4096) {
+        assert(s.count(std::string_view{runs}.substr(pos, 4096)) == 0);
+    }
+    assert(s.strategy() == search_strategy::two_way && s.stats().switches == 1);
+    assert(!seen.empty() && seen[0].switched() && seen[0].from == search_strategy::filter);
+    assert(seen[0].filter_hits > 0.9 && seen[0].verify_length > 16);
+    assert(s.stats().decisions == seen.size() && s.stats().probed < s.stats().scanned);
+
+    // Frequent first and last characters around a rare one: scan for the rare one
+    const std::string flat(1u << 16, 'a');
+    adaptive_searcher<char> rare{"aaaabaaaa", {.window = 1}};
+    assert(rare.find(flat) == rare.npos && rare.strategy() == search_strategy::rare_char);
+    adaptive_searcher<char> fixed{"aaaabaaaa", {.window = 1, .adapt = false}};
+    assert(fixed.find(flat) == fixed.npos && fixed.strategy() == search_strategy::filter);
+
+    // Dense first characters move the multi-pattern search to Aho-Corasick
+    std::string text;
+    for (int i = 0; i < 4096; ++i) text += "error warn info ";
+    text += "fatal: disk";
+    multi_searcher<char> plain;
+    adaptive_multi_searcher<char> any({.window = 1});
+    for (const char* p : {"fatal", "err:", "warning", "info:"}) {
+        plain.add(p);
+        any.add(p);
+    }
+    const auto m = any.find(text);
+    assert(m.pos == plain.find(text).pos && m.pattern == 0 && any.strategy() == search_strategy::aho_corasick);
+    const auto again = any.find(text);
+    assert(again.pos == m.pos && again.pattern == 0 && again.length == 5);
+    assert(!any.contains(std::string_view{text}.substr(0, 1000)));
+}
+
+TEST(glob_match) {
+    assert(glob_match("access.log"_sfs, "*.log"));
+    assert(glob_match("access.log"_sfs, "acc?ss.*"));
+    assert(glob_match("file7.txt"_sfs, "file[0-9].txt"));
+    assert(!glob_match("fileX.txt"_sfs, "file[!A-Z].txt"));
+    assert(!glob_match("access.log"_sfs, "*.txt"));
+    static_assert(glob_match(std::string_view{"a*b"}, "a\\*b"));
+
+    // Required literals skip whole bracket classes, negated or not, and escapes
+    static_assert(glob_required_literal("*[abcd]x*") == "x");
+    static_assert(glob_required_literal("[!xyzq]x") == "x");
+    static_assert(glob_required_literal("[^ab]cd[]xy]z") == "cd");
+    static_assert(glob_required_literal("ab\\*cde") == "cde");
+    static_assert(glob_required_literal("x[a\\]b]yz*.log") == ".log");
+    static_assert(glob_required_literal("[!]abc]").empty() && glob_required_literal("*?").empty());
+
+    // Sound as a prefilter: every matching line contains it
+    const std::string_view globs[] = {"*[abcd]x*", "[!xyzq]x", "*[]q]ab*", "[^a-c]*d", "*\\[x*"};
+    const std::string_view lines[] = {"ax", "bx", "x", "zx", "qx", "]ab", "qab", "dd", "ad", "[x", "a[xb"};
+    for (const auto g : globs) {
+        for (const auto l : lines) {
+            if (glob_match(l, g)) assert(l.find(glob_required_literal(g)) != std::string_view::npos);
+        }
+    }
+    assert(glob_match(std::string_view{"ax"}, "*[abcd]x*") && glob_match(std::string_view{"ax"}, "[!xyzq]x"));
+}
+
+// ==================== Wide Character Tests ====================
+
+TEST(wide_kernels) {
+    // 40+ code units so every type crosses at least one full SIMD block
+    u16fstring<64> u16 = u"  \t Wide UTF-16 text, long enough for a block \n";
+    assert(u16.find(u'U') == 9);
+    assert(u16.find(u"block") == 40);
+    assert(u16.rfind(u'o') == 42);
+    assert(count(u16, u'e') == 3);
+    assert((u16 | trim) == u"Wide UTF-16 text, long enough for a block");
+    assert((u16 | to_upper | trim) == u"WIDE UTF-16 TEXT, LONG ENOUGH FOR A BLOCK");
+    
+    u32fstring<64> u32 = U"Thirty-two bit lanes: \u00C0 stays put while ASCII folds";
+    assert((u32 | to_lower) == U"thirty-two bit lanes: \u00C0 stays put while ascii folds");
+    assert(equals_ignore_case(u32, u32 | to_upper));
+    assert(u32.find(U"folds") == 46);
+    
+    wfstring<64> w1 = L"wchar_t compare across the first vector block: a";
+    wfstring<64> w2 = L"wchar_t compare across the first vector block: b";
+    assert(w1 < w2 && w1 != w2);
+    assert(hash(w1) != hash(w2));
+}
+
+TEST(compare_ignores_stale_bytes) {
+    fstring<8> a = "abc";
+    a.pop_back();
+    a.pop_back();
+    fstring<8> b = "a";
+    assert(a == b);
+    assert((a <=> b) == std::strong_ordering::equal);
+    assert("ab"_fs < "abc"_fs && "abd"_fs > "abc"_fs);
+    static_assert(u"same"_fs == u16fstring<4>{u"same"});
+}
+
+// ==================== Lexer Tests ====================
+
+enum class tok { select, from, ident, number, string, comma, eq, le, lt };
+
+constexpr auto query_lexer = lex::make_lexer(
+    lex::literal(tok::select, "SELECT"),
+    lex::literal(tok::from, "FROM"),
+    lex::literal(tok::le, "<="),
+    lex::literal(tok::lt, "<"),
+    lex::literal(tok::eq, "="),
+    lex::literal(tok::comma, ","),
+    lex::run(tok::ident, lex::alpha | "_", lex::alnum | "_"),
+    lex::number(tok::number),
+    lex::quoted(tok::string, '\''));
+
+constexpr std::size_t count_tokens(std::string_view in) {
+    std::size_t n = 0;
+    for (auto t : query_lexer.tokenize(in)) n += t.kind != lex::error;
+    return n;
+}
+
+TEST(lexer_tokens) {
+    const auto q = "SELECT name, SELECTED FROM t WHERE score<=1.5e3 AND tag='it\\'s a long quoted body'"_lfs;
+    std::vector<lex::token<char>> toks;
+    for (auto t : query_lexer.tokenize(q)) toks.push_back(t);
+    
+    assert(toks.size() == 14);
+    assert(toks[0].is(tok::select));
+    assert(toks[1].is(tok::ident) && toks[1].text == "name");
+    assert(toks[2].is(tok::comma));
+    assert(toks[3].is(tok::ident) && toks[3].text == "SELECTED");   // longest match
+    assert(toks[4].is(tok::from));
+    assert(toks[8].is(tok::le));
+    assert(toks[9].is(tok::number) && toks[9].text == "1.5e3");
+    assert(toks[13].is(tok::string) && toks[13].text == "'it\\'s a long quoted body'");
+    
+    static_assert(count_tokens("SELECT a_very_long_identifier_name FROM x") == 4);
+}
+
+TEST(lexer_errors_and_wide) {
+    std::size_t pos = 0;
+    auto t = query_lexer.next(std::string_view{"  #x"}, pos);
+    assert(t.kind == lex::error && t.text == "#" && pos == 3);
+    
+    u16fstring<64> w = u"SELECT a_rather_long_column FROM t";
+    std::size_t kinds = 0;
+    for (auto tk : query_lexer.tokenize(w)) kinds += tk.is(tok::ident);
+    assert(kinds == 2);
+}
+
+// ==================== Subword Tokenizer Tests ====================
+
+TEST(subword_tokenizers) {
+    // Punctuation classified 64 characters at a time; bits past n stay clear
+    const char text[] = "a,b;c[d]e{f} g-h";
+    const std::uint64_t punct = simd::range_mask(text, 16, lex::detail::punct_lo, lex::detail::punct_hi, 4);
+    assert(punct == 0b0100'1010'1010'1010u && simd::range_mask(text, 3, lex::detail::punct_lo, lex::detail::punct_hi, 4) == 0b010);
+
+    lex::wordpiece_tokenizer bert({.lowercase = true});
+    assert(bert.load("[UNK]\r\n[CLS]\r\nun\r\n##aff\r\n##able\r\nthe\r\ncat\r\n##s\r\n,\r\n!\r\na\r\n##b\r\n"));
+    assert(bert.size() == 12 && bert.unk_id() == 0 && bert.id_of("##able") == 4);
+
+    fstring<256> query = "Unaffable CATS,the dog!";
+    auto ids = bert.encode<16>(query);
+    const std::uint32_t expect[] = {2, 3, 4, 6, 7, 8, 5, 0, 9};   // dog is unknown
+    assert(ids.size() == 9 && !ids.truncated && std::equal(ids.begin(), ids.end(), expect));
+    assert(bert.token(ids[1]) == "##aff");
+
+    // A word whose tail cannot be matched is one unknown token, not a prefix
+    assert(bert.encode<4>(std::string_view{"abx ab"}).span().size() == 3);
+    auto tail = bert.encode<4>(std::string_view{"abx ab"});
+    assert(tail[0] == 0 && tail[1] == 10 && tail[2] == 11);
+
+    // Truncation keeps whole leading tokens
+    auto cut = bert.encode<3>(query);
+    assert(cut.size() == 3 && cut.truncated && cut[2] == 4);
+
+    // Long words are unknown; a word may span several 64-character blocks
+    const std::string long_word(300, 'a');
+    assert(bert.encode<4>(long_word).size() == 1 && bert.encode<4>(long_word)[0] == 0);
+    std::string spaced(70, ' ');
+    spaced += "cats";
+    auto late = bert.encode<4>(spaced);
+    assert(late.size() == 2 && late[0] == 6 && late[1] == 7);
+
+    // BPE: ranked merges, lowest rank first
+    lex::bpe_tokenizer bpe;
+    assert(bpe.load("<unk>\nl\no\nw\ne\nr\nlo\nlow\ner\nlower\ns\nt\n!\n",
+                    "#version: 0.2\nl o\nlo w\ne r\nlow er\nx y\n"));
+    assert(bpe.merges() == 4);
+    auto words = bpe.encode<16>(std::string_view{"lower lowest! zoo"});
+    const std::uint32_t bpe_expect[] = {9, 7, 4, 10, 11, 12, 0, 2, 2};
+    assert(words.size() == 9 && std::equal(words.begin(), words.end(), bpe_expect));
+    assert(bpe.encode<4>(std::string_view{"ol"}).size() == 2);   // merges are ordered pairs
+
+    // Multi-byte characters are one symbol each
+    auto accented = bpe.encode<4>(std::string_view{"l\xC3\xA9"});
+    assert(accented.size() == 2 && accented[0] == 1 && accented[1] == 0);
+
+    // Batches, on several threads, match one-at-a-time encoding
+    std::vector<fstring<64>> titles;
+    for (int i = 0; i < 500; ++i) titles.emplace_back(i % 3 == 0 ? "the cats!" : i % 3 == 1 ? "Unaffable, a cat" : "abab");
+    std::vector<lex::token_ids<8>> out(titles.size());
+    lex::encode_batch(bert, titles, std::span{out}, {.threads = 4, .min_chunk = 16});
+    for (std::size_t i = 0; i < titles.size(); ++i) {
+        const auto one = bert.encode<8>(titles[i]);
+        assert(out[i].size() == one.size() && std::equal(one.begin(), one.end(), out[i].begin()));
+    }
+    assert(out[2].size() == 1 && out[2][0] == 0);   // "##a" is not a piece
+}
+
+// ==================== Line Index Tests ====================
+
+TEST(line_index_random_access) {
+    std::string log;
+    for (int i = 0; i < 500; ++i) {
+        log += "line ";
+        log += std::string_view(to_fstring(i));
+        log += (i % 7 == 0) ? "\r\n" : (i % 11 == 0) ? "\n\n" : "\n";
+    }
+    log += "tail";   // no final newline
+
+    // Small chunks and several threads exercise the prefix-sum stitch
+    const auto full = io::line_index::build(log, {.threads = 4, .min_chunk = 64});
+    const auto sparse = io::line_index32::build(log, {.stride = 16, .threads = 3, .min_chunk = 128});
+    assert(full.size() == 500 + 39 + 1 && sparse.size() == full.size());
+    assert(sparse.samples().size() == (full.size() + 15) / 16);
+    for (std::size_t i = 0; i < full.size(); ++i) assert(full.line(i) == sparse.line(i));
+    assert(full.line(0) == "line 0" && full[1] == "line 1");   // '\r' dropped
+    assert(full.line(12).empty() && full.line(full.size() - 1) == "tail");
+
+    fstring<16> copy(full.line(3));
+    assert(copy == "line 3");
+
+    // Persisted next to the data, rejected for other data
+    const char* path = "comprehensive_test.lidx";
+    assert(sparse.save(path));
+    auto loaded = io::line_index32::load(path, log);
+    assert(loaded && loaded->size() == sparse.size() && loaded->line(123) == sparse.line(123));
+    assert(!io::line_index::load(path, log));   // other offset width
+    std::string edited = log;
+    edited[0] = 'L';
+    assert(!io::line_index32::load(path, edited));
+    std::remove(path);
+
+    assert(io::line_index::build("").empty());
+    assert(io::line_index::build("\n").size() == 1 && io::line_index::build("\n").line(0).empty());
+}
+
+TEST(external_sort_runs) {
+    std::vector<fstring<16>> keys;
+    for (std::size_t i = 0; i < 5000; ++i) keys.emplace_back(std::string_view{std::to_string((i * 7919) % 1237)});
+    std::vector<fstring<16>> expect = keys;
+    std::sort(expect.begin(), expect.end());
+
+    // 64 records per run: 79 runs, merged in several passes of at most 7
+    const auto dir = std::filesystem::temp_directory_path() / ("zuu-sort-test-" + std::to_string(io::detail::run_file_id()));
+    std::filesystem::create_directory(dir);
+    io::external_sorter<fstring<16>> sorter({.memory_budget = 64 * sizeof(fstring<16>), .temp_dir = dir.string(),
+                                             .max_open_files = 8});
+    assert(sorter.push_all(keys) && sorter.size() == 5000 && sorter.runs() == 78);
+    std::vector<fstring<16>> got;
+    assert(sorter.finish([&](const fstring<16>& k) { got.push_back(k); }));
+    assert(got == expect && sorter.size() == 0 && sorter.runs() == 0);
+    assert(std::filesystem::is_empty(dir));
+    std::filesystem::remove(dir);
+
+    // Reused, deduplicated, in the system temp directory
+    io::external_sorter<fstring<16>, std::greater<>> unique({.memory_budget = 4096, .unique = true});
+    assert(unique.push_all(keys) && unique.runs() > 1);
+    got.clear();
+    assert(unique.finish([&](const fstring<16>& k) { got.push_back(k); }));
+    expect.erase(std::unique(expect.begin(), expect.end()), expect.end());
+    std::reverse(expect.begin(), expect.end());
+    assert(got == expect);
+
+    // Fits the budget: sorted in memory
+    io::external_sorter<fstring<16>> small;
+    assert(small.push_all(std::array{fstring<16>{"b"}, fstring<16>{"a"}}) && small.runs() == 0);
+    got.clear();
+    assert(small.finish([&](const fstring<16>& k) { got.push_back(k); }));
+    assert(got.size() == 2 && got[0] == "a");
+}
+
+// ==================== HTTP Tests ====================
+
+TEST(http_request_incremental) {
+    static_assert(http::lookup_field("Content-Length") == http::field::content_length);
+    static_assert(http::lookup_field("X-Unknown") == http::field::unknown);
+
+    const std::string_view raw =
+        "POST /api/v1/items?id=7 HTTP/1.1\r\n"
+        "HOST: example.com\r\n"
+        "Content-Length:  4 \r\n"
+        "X-Trace: abc\r\n"
+        "\r\n"
+        "body";
+
+    // Fed in three reads; only the last one completes the head
+    http::request_parser parser;
+    http::request<8> req;
+    assert(parser.parse(raw.substr(0, 20), req) == http::parse_status::partial);
+    assert(parser.parse(raw.substr(0, 75), req) == http::parse_status::partial);
+    assert(parser.parse(raw, req) == http::parse_status::complete);
+
+    assert(req.method == "POST" && req.target == "/api/v1/items?id=7" && req.minor_version == 1);
+    assert(req.headers().size() == 3);
+    assert(req.headers()[0].id == http::field::host && req.headers()[0].name == "HOST");
+    assert(req.get(http::field::content_length) == "4");
+    assert(req.get("x-trace") == "abc" && !req.get(http::field::cookie));
+    assert(raw.substr(req.head_size) == "body");
+
+    assert(parser.parse("GET / HTTP/1.1\r\n folded: x\r\n\r\n", req) == http::parse_status::invalid);
+    assert(parser.parse("GET / HTTP/1.1\nA: 1\nB: 2\n\n", req) == http::parse_status::complete);
+    http::request<1> small;
+    assert(parser.parse("GET / HTTP/1.1\nA: 1\nB: 2\n\n", small) == http::parse_status::too_many_headers);
+}
+
+TEST(metrics_line_protocol) {
+    namespace m = zuu::metrics;
+    fstring<256> batch;
+    assert(m::encode_influx(batch, "cpu load", {{"region", "eu"}, {"host", "a,b"}, {"empty", ""}},
+                            {{"usage", 0.5}, {"cores", 8}, {"up", true}, {"note", "say \"hi\""}}, 1700000000000000000));
+    assert(m::encode_statsd(batch, "api:req", 3, m::statsd_type::counter, {{"route", "/users"}, {"env", "prod"}}, 0.25));
+    const std::string_view text = batch;
+    assert(text ==
+           "cpu\\ load,host=a\\,b,region=eu usage=0.5,cores=8i,up=true,note=\"say \\\"hi\\\"\" 1700000000000000000\n"
+           "api_req:3|c|@0.25|#env:prod,route:/users\n");
+
+    // A line that does not fit, or cannot be written, leaves the batch as it was
+    const std::size_t before = batch.size();
+    assert(!m::encode_influx(batch, "x", {}, {{"long", std::string_view(std::string(200, 'z'))}}));
+    assert(!m::encode_influx(batch, "x", {}, {{"bad", 1.0 / 0.0}}));
+    assert(!m::encode_influx(batch, "x", {{"k", "a\nb"}}, {{"v", 1}}));
+    assert(batch.size() == before);
+
+    std::size_t points = 0;
+    const std::size_t rejected = m::decode_influx_batch(
+        std::string(text.substr(0, text.find("api"))) + std::string("# comment\n\nbroken line\r\nmem free=7u\r\n"),
+        [&](const auto& p) {
+            if (points++ == 0) {
+                assert(p.measurement == "cpu\\ load" && p.timestamp == 1700000000000000000);
+                assert(p.get_tag("host") == "a\\,b" && p.tags().size() == 2);
+                assert(p.get_field("usage")->f64 == 0.5 && p.get_field("cores")->i64 == 8);
+                assert(p.get_field("up")->boolean);
+                fstring<32> note;
+                m::unescape(p.get_field("note")->string, note);
+                assert(note == "say \"hi\"");
+            } else {
+                assert(p.measurement == "mem" && !p.timestamp);
+                assert(p.fields()[0].kind == m::value_kind::u64 && p.fields()[0].u64 == 7);
+            }
+        });
+    assert(points == 2 && rejected == 1);
+
+    m::statsd_metric<4> metric;
+    assert(m::decode_statsd("api_req:3|c|@0.25|#env:prod,route:/users", metric) == m::decode_status::ok);
+    assert(metric.name == "api_req" && metric.number == 3 && metric.rate == 0.25);
+    assert(metric.type == m::statsd_type::counter && metric.tags()[1].value == "/users");
+    assert(m::decode_statsd("users:alice|s", metric) == m::decode_status::ok && metric.value == "alice");
+    assert(m::decode_statsd("lat:x|ms", metric) == m::decode_status::invalid);
+    m::statsd_metric<1> one;
+    assert(m::decode_statsd("a:1|g|#x,y", one) == m::decode_status::too_many);
+}
+
+// ==================== Aggregation Tests ====================
+
+TEST(count_by_words) {
+    std::vector<fstring<64>> lines;
+    for (int i = 0; i < 5000; ++i) {
+        lines.push_back(i % 2 ? fstring<64>{"apple banana apple"} : fstring<64>{"cherry apple"});
+    }
+    
+    auto counts = zuu::aggregate::count_by(lines, split_whitespace, {.threads = 4, .min_chunk = 64});
+    assert(counts.size() == 3);
+    assert(counts.count("apple") == 7500);
+    assert(counts.count("banana") == 2500);
+    assert(counts.count("cherry") == 2500);
+    assert(counts.count("durian") == 0);
+    assert(counts.total() == 12500);
+    
+    auto top = counts.top(2);
+    assert(top.size() == 2);
+    assert(top[0].key == "apple" && top[0].count == 7500);
+    assert(top[1].key == "banana");  // ties broken by key
+}
+
+TEST(count_by_emitter) {
+    std::vector<std::string_view> records = {"a=1", "b=2", "a=3", "c=4", "a=5"};
+    auto counts = zuu::aggregate::count_by<8>(records, [](std::string_view r, auto& emit) {
+        emit(r.substr(0, r.find('=')));
+    }, {.threads = 2, .min_chunk = 1});
+    
+    assert(counts.size() == 3);
+    assert(counts.count("a") == 3);
+    assert(zuu::hash("key"_sfs) == zuu::hash(std::string_view{"key"}));
+}
+
+TEST(heavy_hitter_sketches) {
+    // 3000 x hot, 1000 x warm, 6000 distinct cold keys
+    std::vector<fstring<16>> stream;
+    for (int i = 0; i < 10000; ++i) {
+        if (i % 10 < 3) stream.push_back("hot");
+        else if (i % 10 == 3) stream.push_back("warm");
+        else {
+            fstring<16> cold = "cold-";
+            stream.push_back(cold += to_fstring(i));
+        }
+    }
+
+    auto cms = std::make_unique<zuu::aggregate::count_min<1024, 4>>();
+    cms->add_all(stream);
+    assert(cms->total() == 10000);
+    assert(cms->estimate("hot"_sfs) >= 3000 && cms->estimate("hot"_sfs) < 3100);
+    assert(cms->estimate(std::string_view{"warm"}) >= 1000);
+
+    // Two halves summarized separately, then merged
+    zuu::aggregate::space_saving<64, 16> a, b;
+    a.add_all(std::span{stream}.first(5000));
+    b.add_all(std::span{stream}.subspan(5000));
+    a.merge(b);
+    assert(a.total() == 10000 && a.size() == 64);
+
+    auto top = a.top(2);
+    assert(top[0].key == "hot" && top[0].count >= 3000 && top[0].count - top[0].error <= 3000);
+    assert(top[1].key == "warm" && top[1].count >= 1000 && top[1].count - top[1].error <= 1000);
+    assert(a.count("cold-5") <= a.min_count());
+    static_assert(std::is_trivially_copyable_v<zuu::aggregate::space_saving<64, 16>>);
+}
+
+TEST(hyperloglog_distinct) {
+    std::vector<fstring<16>> keys;
+    for (int i = 0; i < 3000; ++i) {
+        fstring<16> k = "ip-";
+        keys.push_back(k += to_fstring(i));
+    }
+
+    // Sparse: small sets are counted almost exactly
+    zuu::aggregate::hyperloglog<10> few;
+    few.add_all(std::span{keys}.first(50));
+    few.add("ip-7"_sfs);
+    assert(!few.dense());
+    assert(std::abs(few.estimate() - 50) < 0.5);
+
+    // Self-merge is a no-op in either encoding
+    const double sparse_before = few.estimate();
+    few.merge(few);
+    assert(!few.dense() && few.estimate() == sparse_before);
+
+    // Dense after m/4 entries; halves merge to the whole
+    zuu::aggregate::hyperloglog<10> a, b;
+    a.add_all(std::span{keys}.first(2000));
+    b.add_all(std::span{keys}.subspan(1000));
+    assert(a.dense() && b.dense());
+    a.merge(b).merge(few);
+    assert(std::abs(a.estimate() / 3000 - 1) < 0.1);
+    const double dense_before = a.estimate();
+    assert(a.merge(a).estimate() == dense_before);
+
+    // Byte round trips, both encodings
+    fstring<zuu::aggregate::hyperloglog<10>::max_serialized_size> wire;
+    few.save(wire);
+    assert(wire.size() == few.serialized_size() && wire.size() < 50 * 4 + 7);
+    auto back = zuu::aggregate::hyperloglog<10>::load(wire);
+    assert(back && !back->dense() && back->estimate() == few.estimate());
+
+    a.save(wire);
+    back = zuu::aggregate::hyperloglog<10>::load(wire);
+    assert(back && back->dense() && back->estimate() == a.estimate());
+    assert(!zuu::aggregate::hyperloglog<12>::load(wire));
+    assert(!zuu::aggregate::hyperloglog<10>::load(std::string_view{wire}.substr(1)));
+}
+
+TEST(token_feature_hashing) {
+    using zuu::aggregate::hash_tokens;
+    const std::string_view doc = "  The quick\tBROWN fox\n";
+
+    // Unigrams equal zuu::hash of the lowercased token
+    std::array<std::uint64_t, 8> ids{};
+    assert(hash_tokens(doc, std::span{ids}) == 4);
+    assert(ids[0] == zuu::hash(std::string_view{"the"}));
+    assert(ids[2] == zuu::hash(std::string_view{"brown"}));
+    assert(ids[3] == zuu::hash(std::string_view{"fox"}));
+
+    std::array<std::uint64_t, 8> exact{};
+    hash_tokens(doc, std::span{exact}, {.fold_case = false, .seed = 7});
+    assert(exact[2] == zuu::hash(std::string_view{"BROWN"}, 7));
+
+    // Bigrams: token, then the window ending at it; order matters
+    std::array<std::uint32_t, 16> grams{};
+    assert(hash_tokens(fstring<32>("a b a b"), std::span{grams}, {.ngrams = 2}) == 7);
+    assert(grams[2] == grams[6] && grams[4] != grams[2]);   // "a b" twice, "b a" differs
+    assert(grams[0] == grams[3] && grams[1] == grams[5]);
+
+    // Long input across 64-character blocks, and a full output span
+    fstring<200> text;
+    for (int i = 0; i < 40; ++i) text += "Word ";
+    std::array<std::uint32_t, 64> many{};
+    assert(hash_tokens(text, std::span{many}) == 40);
+    assert(std::all_of(many.begin(), many.begin() + 40, [&](auto h) { return h == many[0]; }));
+    assert(hash_tokens(text, std::span{many}.first(3)) == 3);
+    assert(hash_tokens(std::string_view{" \n\t "}, std::span{many}) == 0);
+}
+
+TEST(near_duplicate_signatures) {
+    using namespace zuu::aggregate;
+    std::vector<zuu::types::msg_str> logs = {
+        "user alice logged in from 10.0.0.1 at 12:00:01 via ssh",
+        "user alice logged in from 10.0.0.1 at 12:00:02 via ssh",
+        "disk /dev/sda1 is 91% full on host db-7, rotating logs",
+        "User Alice logged in from 10.0.0.1 at 12:00:01 via SSH",
+    };
+
+    minhash<128> mh;
+    auto sigs = mh.batch(logs, 2);
+    assert(sigs.size() == 4);
+    assert(sigs[0] == sigs[3]);                         // case folded
+    assert(mh.similarity(sigs[0], sigs[1]) > 0.6);
+    assert(mh.similarity(sigs[0], sigs[2]) < 0.2);
+    assert(sigs[0] == mh(std::string_view{logs[0]}));
+
+    auto pairs = lsh_candidates(sigs, {.bands = 32});
+    const auto has = [&](std::uint32_t a, std::uint32_t b) {
+        return std::find(pairs.begin(), pairs.end(), std::pair{a, b}) != pairs.end();
+    };
+    assert(has(0, 1) && has(0, 3) && has(1, 3));
+    assert(!has(0, 2) && !has(1, 2));
+
+    simhash sh({.unit = shingle_unit::tokens, .size = 2});
+    auto fps = sh.batch(logs);
+    assert(sh.distance(fps[0], fps[1]) < sh.distance(fps[0], fps[2]));
+    assert(fps[0] == fps[3]);
+
+    // A 2-token shingle hash is hash_tokens' bigram id
+    std::array<std::uint64_t, 8> sh2{}, ids{};
+    assert(shingles(std::string_view{"a b"}, std::span{sh2}, {.unit = shingle_unit::tokens, .size = 2}) == 1);
+    hash_tokens(std::string_view{"a b"}, std::span{ids}, {.ngrams = 2});
+    assert(sh2[0] == ids[2]);
+}
+
+TEST(hash_partition_shuffle) {
+    std::vector<fstring<32>> lines;
+    for (int i = 0; i < 3000; ++i) {
+        const std::string line = std::to_string(i % 37) + " rec" + std::to_string(i) + (i % 5 ? "" : " with a long tail");
+        lines.emplace_back(std::string_view{line});
+    }
+    const auto host = [](std::string_view l) { return l.substr(0, l.find(' ')); };
+
+    zuu::aggregate::hash_partitioner<> shuffle(7, {.threads = 4, .min_chunk = 64});
+    for (int round = 0; round < 2; ++round) {
+        const std::size_t n = round == 0 ? lines.size() : 1000;
+        const std::span<const fstring<32>> batch(lines.data(), n);
+        shuffle.scatter(batch, host);
+        shuffle.scatter_views(batch, host);
+
+        std::size_t total = 0;
+        for (std::size_t p = 0; p < shuffle.partitions(); ++p) {
+            const auto& table = shuffle.table(p);
+            const auto views = shuffle.views(p);
+            assert(table.size() == views.size());
+            std::size_t last = 0;
+            for (std::size_t i = 0; i < table.size(); ++i) {
+                assert(table[i] == views[i] && shuffle.partition_of(host(table[i])) == p);
+                const std::size_t at = static_cast<std::size_t>(views[i].data() - batch[0].data()) / sizeof(fstring<32>);
+                assert(i == 0 || at > last);   // input order kept
+                last = at;
+            }
+            total += table.size();
+        }
+        assert(total == n);
+    }
+
+    // Once a batch size has been seen, equal batches allocate nothing and start no threads
+    const std::span<const fstring<32>> same(lines.data(), 1000);
+    const std::size_t before = allocations;
+    shuffle.scatter(same, host);
+    shuffle.scatter_views(same, host);
+    assert(allocations == before);
+
+    // Whole records as keys, one thread
+    zuu::aggregate::hash_partitioner<> single(3, {.threads = 1});
+    const std::array<std::string_view, 4> words{"a", "b", "a", "c"};
+    single.scatter(words);
+    assert(single.table(single.partition_of("a")).chars().find("aa") != std::string_view::npos);
+}
+
 // ==================== Formatting Tests ====================
 
 TEST(integer_formatting) {
@@ -347,6 +1156,60 @@ TEST(complex_pipeline_3) {
     assert(fields[2] == "Developer");
 }
 
+// ==================== Short-Circuit Pipeline Tests ====================
+
+TEST(filter_stage) {
+    auto kept = "ERROR disk full"_fs 
+        | filter(starts_with("ERROR")) 
+        | to_lower;
+    assert(kept.has_value());
+    assert(*kept == "error disk full");
+    
+    int calls = 0;
+    auto dropped = "INFO all good"_fs 
+        | filter(starts_with("ERROR")) 
+        | [&](auto s) { ++calls; return s | to_lower; };
+    assert(!dropped.has_value());
+    assert(calls == 0);
+}
+
+TEST(take_while_stage) {
+    auto is_digit = [](char c) { return c >= '0' && c <= '9'; };
+    
+    auto num = "123abc"_sfs | take_while(is_digit);
+    assert(num.has_value());
+    assert(*num == "123");
+    
+    auto none = "abc"_sfs | take_while(is_digit) | to_upper;
+    assert(!none.has_value());
+}
+
+TEST(when_stage) {
+    auto is_long = [](const auto& s) { return s.size() > 3; };
+    
+    auto yes = "  hello  "_sfs | when(is_long, trim | to_upper);
+    assert(yes.has_value());
+    assert(*yes == "HELLO");
+    
+    auto no = "ab"_sfs | when(is_long, to_upper);
+    assert(!no.has_value());
+}
+
+TEST(hoisted_filter) {
+    int transforms = 0;
+    auto count_upper = [&](auto s) { ++transforms; return s | to_upper; };
+    auto pipeline = trim | count_upper | filter(hoist, starts_with("GET"));
+    
+    auto hit = "GET /index  "_fs | pipeline;
+    assert(hit.has_value());
+    assert(*hit == "GET /INDEX");
+    assert(transforms == 1);
+    
+    auto miss = "POST /upload"_fs | pipeline;
+    assert(!miss.has_value());
+    assert(transforms == 1);
+}
+
 // ==================== Constexpr Tests ====================
 
 constexpr auto compile_time_test() {
@@ -362,6 +1225,258 @@ TEST(constexpr_operations) {
     static_assert(!ct.empty());
 }
 
+// ==================== Ring Buffer Tests ====================
+
+TEST(ring_buffer_stream) {
+    constexpr auto ct = [] {
+        ring_fstring<8> r;
+        r.append("abcdef");
+        r.consume(4);
+        r.append("ghijkl");   // wraps, truncated to capacity
+        return r.size() == 8 && r == "efghijkl" && r.find("hij") == 3;
+    }();
+    static_assert(ct);
+
+    ring_fstring<16> rx;
+    std::vector<std::string> lines;
+    const std::string_view chunks[] = {"GET /a\r\nHo", "st: x\r\n\r", "\nGET /b\r\n", "\r\n"};
+    for (auto chunk : chunks) {
+        // Fill through prepare/commit, as from read()
+        while (!chunk.empty()) {
+            auto room = rx.prepare();
+            const std::size_t n = std::min(room.size(), chunk.size());
+            std::copy_n(chunk.data(), n, room.data());
+            rx.commit(n);
+            chunk.remove_prefix(n);
+            if (n == 0) break;
+        }
+        for (std::size_t end; (end = rx.find("\r\n")) != rx.npos; rx.consume(end + 2)) {
+            std::string line;
+            for (std::size_t i = 0; i < end; ++i) line += rx[i];
+            lines.push_back(line);
+        }
+    }
+    assert((lines == std::vector<std::string>{"GET /a", "Host: x", "", "GET /b", ""}));
+    assert(rx.empty());
+
+    // Two views across the wrap point, one after linearize()
+    ring_fstring<8> r;
+    r.append("123456");
+    r.consume(5);
+    r.append("789ab");
+    assert(!r.contiguous());
+    const auto [a, b] = r.views();
+    assert(a == "678" && b == "9ab");
+    assert(r.find("89") == 2 && r.find('b') == 5 && r.find("6789ab") == 0);
+    assert(r.find("89", 3) == r.npos && !r.contains("ba"));
+    assert(r.linearize() == "6789ab" && r.contiguous());
+    r.append("cdef");
+    assert(r.full() && r == "6789abcd");
+}
+
+// ==================== Path Tests ====================
+
+TEST(path_operations) {
+    // Queries are views into the argument
+    types::path_str p = "/srv/www/../static/./img//logo.tar.gz";
+    static_assert(path::filename(std::string_view{"a/b.txt"}) == "b.txt");
+    assert(path::normalize_in_place(p) == "/srv/static/img/logo.tar.gz");
+    assert(path::filename(p) == "logo.tar.gz");
+    assert(path::stem(p) == "logo.tar" && path::extension(p) == ".gz");
+    assert((p | path::parent) == "/srv/static/img");
+    assert(path::parent(std::string_view{"/a"}) == "/" && path::parent(std::string_view{"a"}).empty());
+    assert(path::extension(std::string_view{"dir/.bashrc"}).empty());
+    assert(path::extension(std::string_view{".."}).empty() && path::filename(std::string_view{"a/"}).empty());
+
+    // Normalization
+    constexpr auto norm = [](std::string_view s) { return path::normalize(s); };
+    static_assert(norm("a/./b/../c") == "a/c");
+    assert(norm("../../a/..//b/") == "../../b");
+    assert(norm("/../a/../../b") == "/b");
+    assert(norm("a/..") == "." && norm("") == "." && norm("///") == "/");
+    fstring<16> small = "x/../y";
+    static_assert(std::is_same_v<decltype(small | path::normalize), fstring<16>>);
+    assert((small | path::normalize) == "y");
+
+    // Join and relative paths
+    assert(path::join(p | path::parent, "icon.svg") == "/srv/static/img/icon.svg");
+    assert((fstring<32>("usr/") | path::join("lib")) == "usr/lib");
+    assert(path::join(std::string_view{"a"}, "/etc") == "/etc");
+    fstring<8> tiny = "abc";
+    assert(path::append(tiny, "defghij") == "abc/defg");   // truncated
+
+    assert(path::relative_to(p, "/srv") == "static/img/logo.tar.gz");
+    assert(path::relative_to(std::string_view{"/a/x"}, "/a/b/c") == "../../x");
+    assert(path::relative_to(std::string_view{"a/b"}, "./a/b/") == ".");
+    assert(path::relative_to(std::string_view{"b"}, "../a").empty());
+    assert(path::relative_to(std::string_view{"/a"}, "a").empty());
+    assert((fstring<32>("x/y") | path::relative_to("x/z")) == "../y");
+}
+
+// ==================== Digest Tests ====================
+
+TEST(crc32c_and_sha256) {
+    // Known answers, at compile time and at run time
+    static_assert(crc32c(std::string_view{"123456789"}) == 0xe3069283u);
+    static_assert(crc32c_hex("123456789") == "e3069283");
+    static_assert(sha256_hex("abc") == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    assert(crc32c(std::string_view{}) == 0 && crc32c_hex(fstring<16>("123456789")) == "e3069283");
+    assert(sha256_hex("") == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    assert(sha256_hex("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq") ==
+           "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    // Long inputs take the three-stream CRC and full-block SHA paths
+    std::string text;
+    for (int i = 0; text.size() < 10000; ++i) text += std::string_view(to_fstring(i * 7919));
+    std::uint32_t bitwise = ~0u;
+    for (const unsigned char c : text) {
+        bitwise ^= c;
+        for (int k = 0; k < 8; ++k) bitwise = (bitwise >> 1) ^ (0x82f63b78u & (0u - (bitwise & 1)));
+    }
+    assert(crc32c(text) == ~bitwise);
+
+    // Continuing a CRC or a SHA-256 state equals digesting the whole
+    for (const std::size_t cut : {0, 1, 63, 64, 1000, 3071, 9999}) {
+        const std::string_view head = std::string_view{text}.substr(0, cut);
+        const std::string_view rest = std::string_view{text}.substr(cut);
+        assert(crc32c(rest, crc32c(head)) == crc32c(text));
+        sha256_state st;
+        st.update(head).update(rest);
+        assert(st.finish() == sha256(text));
+    }
+
+    // Wide strings digest their little-endian byte image
+    const u16fstring<8> wide = u"ab";
+    assert(crc32c(wide) == crc32c(std::string_view{"a\0b\0", 4}));
+    assert(sha256(wide) == sha256(std::string_view{"a\0b\0", 4}));
+
+    // Batches match one-at-a-time digests
+    std::vector<fstring<96>> keys;
+    for (std::size_t i = 0; i < 203; ++i) keys.emplace_back(std::string_view{text}.substr(i * 13, i % 97));
+    std::vector<std::uint32_t> crcs(keys.size());
+    std::vector<sha256_digest> digests(keys.size());
+    crc32c_batch(keys, std::span{crcs});
+    sha256_batch(keys, std::span{digests});
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+        assert(crcs[i] == crc32c(keys[i]) && digests[i] == sha256(keys[i]));
+    }
+    assert(hex_digest(digests[0]) == sha256_hex(""));
+    const std::array<std::u16string_view, 4> wides{u"ab", u"", u"wide keys", u"x"};
+    std::array<std::uint32_t, 4> wide_crcs{};
+    crc32c_batch(wides, std::span{wide_crcs});
+    for (std::size_t i = 0; i < wides.size(); ++i) assert(wide_crcs[i] == crc32c(wides[i]));
+}
+
+// ==================== Literal Pool Tests ====================
+
+using http_verbs = lit::pool<"GET", "PUT", "POST", "GET", "DELETE">;
+
+TEST(literal_pool) {
+    // Interned ids: equal literals share one entry. Checked at run time:
+    // address identity is not a constant expression under ASan
+    assert("GET"_id == ZUU_LIT("GET"));
+    assert("GET"_id != "PUT"_id);
+    assert(lit::id{} == ""_id);
+
+    lit::id verb = "POST"_id;
+    std::string_view v = verb;
+    assert(v == "POST" && verb.size() == 4 && verb.c_str()[4] == '\0');
+    assert(std::hash<lit::id>{}(verb) == std::hash<lit::id>{}("POST"_id));
+    assert(u"wide"_id.view() == u"wide");
+
+    // Packed pool: duplicates collapse, keys are one byte
+    static_assert(http_verbs::count == 4);
+    static_assert(sizeof(http_verbs::key) == 1);
+    static_assert(http_verbs::blob.size() == 4 + 4 + 5 + 7);
+    static_assert(http_verbs::view(http_verbs::key_of<"DELETE">()) == "DELETE");
+
+    assert(http_verbs::find("PUT") == http_verbs::key_of<"PUT">());
+    assert(!http_verbs::find("PATCH"));
+    assert(!http_verbs::find("GE"));
+
+    // Embedded NULs stay part of the literal and do not shift later keys
+    using nul_pool = lit::pool<"a\0b", "cd", "">;
+    static_assert(nul_pool::view(nul_pool::key_of<"a\0b">()) == std::string_view("a\0b", 3));
+    static_assert(nul_pool::view(nul_pool::key_of<"cd">()) == "cd");
+    static_assert(nul_pool::view(nul_pool::key_of<"">()).empty());
+    assert(nul_pool::find(std::string_view("a\0b", 3)) == nul_pool::key_of<"a\0b">());
+    assert(!nul_pool::find("a"));
+}
+
+// ==================== Framing Tests ====================
+
+#if defined(__unix__) || defined(__APPLE__)
+
+TEST(frame_roundtrip) {
+    int fds[2];
+    assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    {
+        io::frame_writer<64, 16> out(fds[0]);
+        for (int i = 0; i < 1000; ++i) {
+            fstring<64> msg = "msg-";
+            msg += to_fstring(i);
+            assert(out.push(fstring<64>(static_cast<std::size_t>(i % 40), 'x') + msg) == io::frame_status::ok);
+        }
+        assert(out.push("") == io::frame_status::ok);
+        assert(out.pending() == 1000 % 16 + 1);
+    } // flushed on destruction
+    ::close(fds[0]);
+
+    io::frame_reader<64, 8> in(fds[1]);
+    int n = 0;
+    for (auto f = in.next(); f; f = in.next(), ++n) {
+        if (n == 1000) { assert(f.data.empty()); continue; }
+        assert(f.data.size() == static_cast<std::size_t>(n % 40) + 4 + to_fstring(n).size());
+        assert(f.data.ends_with(std::string_view(to_fstring(n))));
+    }
+    assert(n == 1001);
+    assert(in.next().status == io::frame_status::closed);
+    ::close(fds[1]);
+}
+
+TEST(frame_oversized_and_poll) {
+    int fds[2];
+    assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    {
+        // A 20-byte frame is too long for an 8-byte reader and is skipped
+        io::frame_writer<32> out(fds[0]);
+        out.push("one");
+        out.push("a frame of 20 bytes!");
+        out.push("two");
+        // The writer truncates to its own capacity
+        io::frame_writer<4> small(fds[0]);
+        out.flush();
+        small.push("three");
+    }
+
+    io::frame_reader<8> in(fds[1]);
+    fstring<32> seen;
+    io::frame_status status{};
+    const std::size_t n = in.poll([&](std::string_view m) { seen.append(m.data(), m.size()); seen += ','; }, &status);
+    assert(status == io::frame_status::oversized);
+    assert(n == 3 && seen == "one,two,thre,");
+    assert(in.buffered() == 0);
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+
+TEST(frame_peer_closed) {
+    // A vanished reader is an EPIPE error, not a SIGPIPE that kills the writer
+    int fds[2];
+    assert(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+    ::close(fds[1]);
+    {
+        io::frame_writer<16> out(fds[0]);
+        assert(out.push("lost") == io::frame_status::ok);
+        errno = 0;
+        assert(out.flush() == io::frame_status::error && errno == EPIPE);
+        assert(out.pending() == 1);
+    }
+    ::close(fds[0]);
+}
+
+#endif
+
 // ==================== Type Aliases Tests ====================
 
 TEST(type_aliases) {
@@ -423,6 +1538,7 @@ int main() {
     run_test_basic_construction();
     run_test_concatenation();
     run_test_element_access();
+    run_test_fstring_ref_external_buffers();
     
     run_test_trim_operations();
     run_test_trim_piping();
@@ -438,10 +1554,12 @@ int main() {
     run_test_split_piping();
     run_test_partition();
     run_test_rsplit();
+    run_test_split_views();
     
     run_test_join_char();
     run_test_join_string();
     run_test_join_split_roundtrip();
+    run_test_join_ranges();
     
     run_test_contains_operations();
     run_test_starts_ends_with();
@@ -449,6 +1567,36 @@ int main() {
     run_test_count_operations();
     run_test_find_first_of();
     run_test_contains_any();
+    run_test_any_contiguous_range();
+    run_test_parallel_search();
+    
+    run_test_searcher();
+    run_test_multi_searcher();
+    run_test_adaptive_search();
+    run_test_glob_match();
+    
+    run_test_ring_buffer_stream();
+    run_test_path_operations();
+    
+    run_test_wide_kernels();
+    run_test_compare_ignores_stale_bytes();
+    
+    run_test_lexer_tokens();
+    run_test_lexer_errors_and_wide();
+    run_test_subword_tokenizers();
+    
+    run_test_line_index_random_access();
+    run_test_external_sort_runs();
+    run_test_http_request_incremental();
+    run_test_metrics_line_protocol();
+    
+    run_test_count_by_words();
+    run_test_count_by_emitter();
+    run_test_heavy_hitter_sketches();
+    run_test_hyperloglog_distinct();
+    run_test_token_feature_hashing();
+    run_test_near_duplicate_signatures();
+    run_test_hash_partition_shuffle();
     
     run_test_integer_formatting();
     run_test_hex_formatting();
@@ -464,8 +1612,22 @@ int main() {
     run_test_complex_pipeline_2();
     run_test_complex_pipeline_3();
     
+    run_test_filter_stage();
+    run_test_take_while_stage();
+    run_test_when_stage();
+    run_test_hoisted_filter();
+    
     run_test_constexpr_operations();
     
+    run_test_crc32c_and_sha256();
+    run_test_literal_pool();
+    
+#if defined(__unix__) || defined(__APPLE__)
+    run_test_frame_roundtrip();
+    run_test_frame_oversized_and_poll();
+    run_test_frame_peer_closed();
+#endif
+    
     run_test_type_aliases();
     
     run_test_empty_string_operations();
@@ -0,0 +1,547 @@
+/**
+ * @file grep.cpp
+ * @brief fstring_grep - parallel line search built on the zuu search kernels
+ * @date 2026-10-18
+ *
+ * Usage:
+ *   fstring_grep [options] PATTERN [FILE...]
+ *   fstring_grep [options] -e PATTERN [-e PATTERN...] [FILE...]
+ *
+ * Options:
+ *   -F        literal patterns (default); several -e give a multi-literal search
+ *   -G        POSIX basic regular expression, as in grep (std::regex, literal
+ *             prefiltered); GNU extensions such as `\|` are rejected
+ *   -E        ECMAScript regular expression (std::regex, literal prefiltered)
+ *   -g, --glob
+ *             glob matched against the whole line (`*`, `?`, `[...]`)
+ *   -v        select non-matching lines
+ *   -c        print only a count of selected lines per file
+ *   -n        prefix each line with its line number
+ *   -H / -h   always / never prefix lines with the file name
+ *   -j N      worker threads (default: hardware concurrency)
+ *
+ * Files are memory-mapped where available (read whole otherwise), cut
+ * into newline-aligned chunks and searched in parallel. Non-inverted
+ * searches scan the whole chunk for the pattern and only materialize
+ * the lines that contain a hit. Results are written in input order
+ * through a batched sink.
+ *
+ * Exit status follows grep: 0 selected lines found, 1 none, 2 error.
+ */
+
+#include <zuu/fstring.hpp>
+#include <zuu/str/search.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+    #define ZUU_GREP_MMAP 1
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+
+using namespace zuu;
+
+constexpr std::size_t chunk_size = std::size_t{8} << 20;
+constexpr std::size_t sink_size = std::size_t{256} << 10;
+
+enum class mode { literal, basic, glob, regex };
+
+struct options {
+    mode match_mode = mode::literal;
+    std::vector<std::string> patterns;
+    std::vector<std::string> files;
+    bool invert = false;
+    bool count_only = false;
+    bool line_numbers = false;
+    std::optional<bool> with_filename;
+    unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+};
+
+// ==================== Input ====================
+
+class input_file {
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::vector<char> owned_;
+#if defined(ZUU_GREP_MMAP)
+    void* map_ = nullptr;
+#endif
+
+public:
+    input_file() = default;
+    input_file(const input_file&) = delete;
+    input_file& operator=(const input_file&) = delete;
+
+    ~input_file() {
+#if defined(ZUU_GREP_MMAP)
+        if (map_) ::munmap(map_, size_);
+#endif
+    }
+
+    bool open(const std::string& path) {
+        if (path == "-") return read_stream(std::cin);
+#if defined(ZUU_GREP_MMAP)
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            size_ = static_cast<std::size_t>(st.st_size);
+            if (size_ == 0) {
+                ::close(fd);
+                return true;
+            }
+            void* map = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);
+            if (map == MAP_FAILED) return false;
+            ::madvise(map, size_, MADV_SEQUENTIAL);
+            map_ = map;
+            data_ = static_cast<const char*>(map);
+            return true;
+        }
+        ::close(fd);
+#endif
+        std::ifstream in(path, std::ios::binary);
+        return in && read_stream(in);
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept { return {data_, size_}; }
+
+private:
+    bool read_stream(std::istream& in) {
+        owned_.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+        data_ = owned_.data();
+        size_ = owned_.size();
+        return !in.bad();
+    }
+};
+
+// ==================== Matching ====================
+
+// Longest literal run every match of a simple (alternation-free) regex contains
+std::string_view regex_required_literal(std::string_view re) {
+    if (re.find_first_of("|()") != std::string_view::npos) return {};
+
+    std::string_view best;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i <= re.size(); ++i) {
+        const bool meta = i == re.size() ||
+            std::string_view{".[]{}*+?^$\\"}.find(re[i]) != std::string_view::npos;
+        if (meta) {
+            std::size_t end = i;
+            // A quantifier makes the preceding character optional
+            if (i < re.size() && (re[i] == '*' || re[i] == '?' || re[i] == '{') && end > start) --end;
+            if (end > start && end - start > best.size()) best = re.substr(start, end - start);
+            if (i < re.size() && re[i] == '\\') {
+                ++i; // escaped char: not part of a plain run
+            } else if (i < re.size() && (re[i] == '[' || re[i] == '{')) {
+                const char close = re[i] == '[' ? ']' : '}';
+                while (i < re.size() && re[i] != close) ++i;
+            }
+            start = i + 1;
+        }
+    }
+    return best;
+}
+
+// The same for a POSIX basic regex, where `\(`, `\{` and `\|` are the operators
+std::string_view bre_required_literal(std::string_view re) {
+    if (re.find("\\(") != std::string_view::npos || re.find("\\|") != std::string_view::npos) return {};
+
+    std::string_view best;
+    std::size_t start = 0;
+    for (std::size_t i = 0; i <= re.size(); ++i) {
+        const bool meta = i == re.size() || std::string_view{".[*^$\\"}.find(re[i]) != std::string_view::npos;
+        if (!meta) continue;
+
+        const bool interval = i + 1 < re.size() && re[i] == '\\' && re[i + 1] == '{';
+        std::size_t end = i;
+        // A quantifier makes the preceding character optional
+        if (i < re.size() && (re[i] == '*' || interval) && end > start) --end;
+        if (end > start && end - start > best.size()) best = re.substr(start, end - start);
+
+        if (interval) {
+            i = std::min(re.find("\\}", i), re.size() - 1) + 1;
+        } else if (i < re.size() && re[i] == '\\') {
+            ++i; // escaped char: not part of a plain run
+        } else if (i < re.size() && re[i] == '[') {
+            // `]` right after `[` or `[^` is a member, not the end
+            if (i + 1 < re.size() && re[i + 1] == '^') ++i;
+            if (i + 1 < re.size() && re[i + 1] == ']') ++i;
+            while (i + 1 < re.size() && re[i + 1] != ']') ++i;
+            ++i;
+        }
+        start = i + 1;
+    }
+    return best;
+}
+
+class matcher {
+    str::searcher single_;
+    str::multi_searcher<char, 64> multi_;
+    bool use_multi_ = false;
+    bool has_candidate_ = false;
+    mode mode_ = mode::literal;
+    std::string_view glob_;
+    std::optional<std::regex> regex_;
+
+public:
+    bool init(const options& opt) {
+        mode_ = opt.match_mode;
+        switch (mode_) {
+        case mode::literal:
+            if (opt.patterns.size() == 1) {
+                single_ = str::searcher{std::string_view{opt.patterns[0]}};
+            } else {
+                use_multi_ = true;
+                for (const auto& p : opt.patterns) {
+                    if (!multi_.add(std::string_view{p})) {
+                        std::cerr << "fstring_grep: at most " << multi_.max_patterns << " patterns\n";
+                        return false;
+                    }
+                }
+            }
+            has_candidate_ = true;
+            break;
+        case mode::glob:
+            glob_ = opt.patterns[0];
+            single_ = str::searcher{str::glob_required_literal(glob_)};
+            has_candidate_ = single_.size() > 0;
+            break;
+        case mode::basic:
+        case mode::regex:
+            try {
+                const auto syntax = mode_ == mode::basic ? std::regex::basic : std::regex::ECMAScript;
+                regex_.emplace(opt.patterns[0], syntax | std::regex::optimize);
+            } catch (const std::regex_error& e) {
+                std::cerr << "fstring_grep: invalid regex: " << e.what() << '\n';
+                return false;
+            }
+            single_ = str::searcher{mode_ == mode::basic ? bre_required_literal(opt.patterns[0])
+                                                         : regex_required_literal(opt.patterns[0])};
+            has_candidate_ = single_.size() > 0;
+            break;
+        }
+        return true;
+    }
+
+    [[nodiscard]] bool has_candidate() const noexcept { return has_candidate_; }
+
+    // First position in `hay` that may start a match (npos if none)
+    [[nodiscard]] std::size_t candidate(std::string_view hay) const noexcept {
+        if (use_multi_) return multi_.find(hay).pos;
+        return single_.find(hay);
+    }
+
+    [[nodiscard]] bool verify(std::string_view line) const {
+        switch (mode_) {
+        case mode::literal: return true;
+        case mode::glob: return str::glob_match(line, glob_);
+        case mode::basic:
+        case mode::regex: return std::regex_search(line.begin(), line.end(), *regex_);
+        }
+        return false;
+    }
+
+    [[nodiscard]] bool matches(std::string_view line) const {
+        if (has_candidate_ && candidate(line) == simd::npos) return false;
+        return verify(line);
+    }
+};
+
+// ==================== Chunk Search ====================
+
+struct line_hit {
+    std::size_t line;   // zero-based, relative to chunk start
+    std::size_t begin;  // absolute offsets into the file
+    std::size_t end;
+};
+
+struct chunk_result {
+    std::vector<line_hit> hits;
+    std::size_t selected = 0;
+    std::size_t newlines = 0;
+};
+
+std::size_t line_end_at(std::string_view data, std::size_t pos, std::size_t end) noexcept {
+    const auto nl = simd::find_char(data.data() + pos, end - pos, '\n');
+    return nl == simd::npos ? end : pos + nl;
+}
+
+chunk_result search_chunk(std::string_view data, std::size_t begin, std::size_t end,
+                          const matcher& m, const options& opt) {
+    chunk_result out;
+    std::size_t line = 0;
+    std::size_t counted = begin;  // newlines before `counted` are in `line`
+
+    auto record = [&](std::size_t b, std::size_t e) {
+        ++out.selected;
+        if (opt.count_only) return;
+        if (opt.line_numbers) {
+            line += simd::count_char(data.data() + counted, b - counted, '\n');
+            counted = b;
+        }
+        out.hits.push_back({line, b, e});
+    };
+
+    if (!opt.invert && m.has_candidate()) {
+        std::size_t pos = begin;
+        while (pos < end) {
+            const auto at = m.candidate(data.substr(pos, end - pos));
+            if (at == simd::npos) break;
+
+            const std::size_t hit = pos + at;
+            const auto back = simd::rfind_char(data.data() + pos, hit - pos, '\n');
+            const std::size_t b = back == simd::npos ? pos : pos + back + 1;
+            const std::size_t e = line_end_at(data, hit, end);
+
+            if (m.verify(data.substr(b, e - b))) record(b, e);
+            pos = e + 1;
+        }
+    } else {
+        for (std::size_t pos = begin; pos < end;) {
+            const std::size_t e = line_end_at(data, pos, end);
+            if (m.matches(data.substr(pos, e - pos)) != opt.invert) record(pos, e);
+            pos = e + 1;
+        }
+    }
+
+    if (opt.line_numbers) {
+        out.newlines = simd::count_char(data.data() + begin, end - begin, '\n');
+    }
+    return out;
+}
+
+// Newline-aligned [begin, end) ranges of roughly chunk_size bytes
+std::vector<std::pair<std::size_t, std::size_t>> split_chunks(std::string_view data) {
+    std::vector<std::pair<std::size_t, std::size_t>> chunks;
+    std::size_t begin = 0;
+    while (begin < data.size()) {
+        std::size_t end = std::min(data.size(), begin + chunk_size);
+        if (end < data.size()) end = line_end_at(data, end, data.size()) + 1;
+        chunks.emplace_back(begin, std::min(end, data.size()));
+        begin = end;
+    }
+    return chunks;
+}
+
+// ==================== Output ====================
+
+class batched_sink {
+    std::vector<char> buf_;
+    std::FILE* out_;
+
+public:
+    explicit batched_sink(std::FILE* out) : out_{out} { buf_.reserve(sink_size); }
+    ~batched_sink() { flush(); }
+
+    void write(std::string_view s) {
+        if (buf_.size() + s.size() > sink_size) flush();
+        if (s.size() >= sink_size) {
+            std::fwrite(s.data(), 1, s.size(), out_);
+            return;
+        }
+        buf_.insert(buf_.end(), s.begin(), s.end());
+    }
+
+    void put(char c) {
+        if (buf_.size() == sink_size) flush();
+        buf_.push_back(c);
+    }
+
+    void flush() {
+        if (!buf_.empty()) std::fwrite(buf_.data(), 1, buf_.size(), out_);
+        buf_.clear();
+    }
+};
+
+void write_hits(batched_sink& sink, std::string_view data, const chunk_result& r,
+                std::size_t base_line, std::string_view name, const options& opt) {
+    for (const auto& h : r.hits) {
+        if (!name.empty()) {
+            sink.write(name);
+            sink.put(':');
+        }
+        if (opt.line_numbers) {
+            const auto num = fmt::to_fstring(base_line + h.line + 1);
+            sink.write(num);
+            sink.put(':');
+        }
+        sink.write(data.substr(h.begin, h.end - h.begin));
+        sink.put('\n');
+    }
+}
+
+// ==================== Driver ====================
+
+// Searches one file in parallel; returns the number of selected lines
+std::size_t grep_file(std::string_view data, std::string_view name, const matcher& m,
+                      const options& opt, batched_sink& sink) {
+    const auto chunks = split_chunks(data);
+    const std::size_t workers = std::min<std::size_t>(opt.threads, chunks.size());
+
+    std::vector<std::optional<chunk_result>> results(chunks.size());
+    std::mutex mtx;
+    std::condition_variable ready;
+    std::atomic<std::size_t> next{0};
+
+    auto work = [&] {
+        for (std::size_t i = next++; i < chunks.size(); i = next++) {
+            auto r = search_chunk(data, chunks[i].first, chunks[i].second, m, opt);
+            {
+                std::lock_guard lock{mtx};
+                results[i].emplace(std::move(r));
+            }
+            ready.notify_one();
+        }
+    };
+
+    std::vector<std::jthread> pool;
+    if (workers > 1) {
+        pool.reserve(workers);
+        for (std::size_t t = 0; t < workers; ++t) pool.emplace_back(work);
+    } else {
+        work();
+    }
+
+    // Ordered writer: emit chunk i as soon as chunks [0, i] are done
+    std::size_t selected = 0;
+    std::size_t base_line = 0;
+    for (std::size_t i = 0; i < chunks.size(); ++i) {
+        chunk_result r;
+        {
+            std::unique_lock lock{mtx};
+            ready.wait(lock, [&] { return results[i].has_value(); });
+            r = std::move(*results[i]);
+            results[i].reset();
+        }
+        selected += r.selected;
+        write_hits(sink, data, r, base_line, name, opt);
+        base_line += r.newlines;
+    }
+    return selected;
+}
+
+void usage() {
+    std::cerr << "usage: fstring_grep [-F|-G|-E|-g] [-vcnHh] [-j N] [-e PATTERN]... [PATTERN] [FILE...]\n";
+}
+
+std::optional<options> parse_args(int argc, char** argv) {
+    options opt;
+    int i = 1;
+    for (; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--") { ++i; break; }
+        if (arg == "--glob") { opt.match_mode = mode::glob; continue; }
+        if (arg.size() < 2 || arg[0] != '-') break;
+
+        for (std::size_t k = 1; k < arg.size(); ++k) {
+            switch (arg[k]) {
+            case 'F': opt.match_mode = mode::literal; break;
+            case 'G': opt.match_mode = mode::basic; break;
+            case 'E': opt.match_mode = mode::regex; break;
+            case 'g': opt.match_mode = mode::glob; break;
+            case 'v': opt.invert = true; break;
+            case 'c': opt.count_only = true; break;
+            case 'n': opt.line_numbers = true; break;
+            case 'H': opt.with_filename = true; break;
+            case 'h': opt.with_filename = false; break;
+            case 'e':
+            case 'j': {
+                std::string value;
+                if (k + 1 < arg.size()) value = std::string{arg.substr(k + 1)};
+                else if (i + 1 < argc) value = argv[++i];
+                else return std::nullopt;
+
+                if (arg[k] == 'e') {
+                    opt.patterns.push_back(std::move(value));
+                } else {
+                    opt.threads = std::max(1u, static_cast<unsigned>(
+                        fmt::parse_int<unsigned>(fstring<16>{std::string_view{value}})));
+                }
+                k = arg.size();
+                break;
+            }
+            default:
+                return std::nullopt;
+            }
+        }
+    }
+
+    if (opt.patterns.empty()) {
+        if (i >= argc) return std::nullopt;
+        opt.patterns.emplace_back(argv[i++]);
+    }
+    if (opt.match_mode != mode::literal && opt.patterns.size() > 1) {
+        std::cerr << "fstring_grep: -G, -E and -g take a single pattern\n";
+        return std::nullopt;
+    }
+    for (; i < argc; ++i) opt.files.emplace_back(argv[i]);
+    if (opt.files.empty()) opt.files.emplace_back("-");
+    return opt;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const auto opt = parse_args(argc, argv);
+    if (!opt) {
+        usage();
+        return 2;
+    }
+
+    matcher m;
+    if (!m.init(*opt)) return 2;
+
+    const bool show_names = opt->with_filename.value_or(opt->files.size() > 1);
+    bool any_error = false;
+    std::size_t total = 0;
+
+    batched_sink sink{stdout};
+    for (const auto& path : opt->files) {
+        input_file file;
+        if (!file.open(path)) {
+            sink.flush();
+            std::cerr << "fstring_grep: " << path << ": cannot read\n";
+            any_error = true;
+            continue;
+        }
+
+        std::string_view name;
+        if (show_names) name = path == "-" ? std::string_view{"(standard input)"} : std::string_view{path};
+        const auto selected = grep_file(file.view(), name, m, *opt, sink);
+        total += selected;
+
+        if (opt->count_only) {
+            if (!name.empty()) {
+                sink.write(name);
+                sink.put(':');
+            }
+            sink.write(fmt::to_fstring(selected));
+            sink.put('\n');
+        }
+    }
+    sink.flush();
+
+    if (any_error) return 2;
+    return total > 0 ? 0 : 1;
+}